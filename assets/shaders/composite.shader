@@ -0,0 +1,30 @@
+#lk_shader vertex
+#version 450 core
+
+out vec2 v_texcoord;
+
+/* Center (xy) and half size (zw) of the layer in clip space. */
+uniform vec4 u_rect;
+
+void main()
+{
+    /* Triangle strip without vertex data. */
+    const vec2 corner = vec2(gl_VertexID & 1, (gl_VertexID >> 1) & 1);
+    gl_Position = vec4(u_rect.xy + (corner * 2.0 - 1.0) * u_rect.zw, 0.0, 1.0);
+
+    v_texcoord = corner;
+}
+
+#lk_shader fragment
+#version 450 core
+layout(location = 0) out vec4 color;
+
+in vec2 v_texcoord;
+
+/* Premultiplied alpha. */
+uniform sampler2D u_texture;
+
+void main()
+{
+    color = texture(u_texture, v_texcoord);
+}
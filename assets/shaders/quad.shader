@@ -35,35 +35,20 @@ in vec2 v_texcoord;
 flat in int v_texindex;
 in float v_tilefactor;
 
-#define MAX_TEXTURES 16
+#define MAX_ARRAY_TEXTURES 256
 
-uniform sampler2D u_texture0;
-uniform sampler2D u_texture1;
-uniform sampler2D u_texture2;
-uniform sampler2D u_texture3;
-uniform sampler2D u_texture4;
-uniform sampler2D u_texture5;
-uniform sampler2D u_texture6;
-uniform sampler2D u_texture7;
-uniform sampler2D u_texture8;
+uniform sampler2DArray u_textures;
+uniform vec4 u_texregion[MAX_ARRAY_TEXTURES]; /* Offset (xy) and size (zw) in texels of each texture. */
+uniform int u_texlayer[MAX_ARRAY_TEXTURES];
 
 void main()
 {
-    vec4 tex = vec4(0.0);
-    switch (v_texindex)
-    {
-        case 0: tex = texture(u_texture0, v_texcoord); break;
-        case 1: tex = texture(u_texture1, v_texcoord); break;
-        case 2: tex = texture(u_texture2, v_texcoord); break;
-        case 3: tex = texture(u_texture3, v_texcoord); break;
-        case 4: tex = texture(u_texture4, v_texcoord); break;
-        case 5: tex = texture(u_texture5, v_texcoord); break;
-        case 6: tex = texture(u_texture6, v_texcoord); break;
-        case 7: tex = texture(u_texture7, v_texcoord); break;
-        case 8: tex = texture(u_texture8, v_texcoord); break;
-    }
+    /* Clamp to the edge of the region of the texture, as GL_CLAMP_TO_EDGE would. */
+    const vec4 region = u_texregion[v_texindex];
+    const vec2 texel = region.xy + clamp(v_texcoord * region.zw, vec2(0.5), region.zw - vec2(0.5));
+    const vec2 uv = texel / vec2(textureSize(u_textures, 0).xy);
 
-    color = tex * v_color;
+    color = texture(u_textures, vec3(uv, float(u_texlayer[v_texindex]))) * v_color;
 
     /* Debug */
     //color = vec4(vec3(float(v_texindex)/16.0), 1.0);
@@ -0,0 +1,63 @@
+#lk_shader vertex 
+#version 450 core
+layout(location = 0) in vec4 transform; /* Position (xyz) and rotation in radians (w). */
+layout(location = 1) in vec2 size;
+layout(location = 2) in vec4 texcoords; /* (U0, V0, U1, V1) */
+layout(location = 3) in vec4 color;
+layout(location = 4) in uint texindex;
+
+out vec4 v_color;
+out vec2 v_texcoord;
+flat out int v_texindex;
+out float v_tilefactor;
+
+layout(std140, binding = 0) uniform ub_camera
+{
+    mat4 u_viewproj;
+};
+
+void main()
+{
+    /* Drawn as a triangle strip: BL, BR, TL, TR. */
+    const vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    const vec2 local = (corner - 0.5) * size;
+
+    const float s = sin(transform.w);
+    const float c = cos(transform.w);
+    const vec2 world = transform.xy + vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+
+    gl_Position = u_viewproj * vec4(world, transform.z, 1.0);
+
+    v_color = color;
+    v_texcoord = mix(texcoords.xy, texcoords.zw, corner);
+    v_texindex = int(texindex);
+    v_tilefactor = 1.0;
+}
+
+#lk_shader fragment
+#version 450 core
+layout(location = 0) out vec4 color;
+
+in vec4 v_color;
+in vec2 v_texcoord;
+flat in int v_texindex;
+in float v_tilefactor;
+
+#define MAX_ARRAY_TEXTURES 256
+
+uniform sampler2DArray u_textures;
+uniform vec4 u_texregion[MAX_ARRAY_TEXTURES]; /* Offset (xy) and size (zw) in texels of each texture. */
+uniform int u_texlayer[MAX_ARRAY_TEXTURES];
+
+void main()
+{
+    /* Clamp to the edge of the region of the texture, as GL_CLAMP_TO_EDGE would. */
+    const vec4 region = u_texregion[v_texindex];
+    const vec2 texel = region.xy + clamp(v_texcoord * region.zw, vec2(0.5), region.zw - vec2(0.5));
+    const vec2 uv = texel / vec2(textureSize(u_textures, 0).xy);
+
+    color = texture(u_textures, vec3(uv, float(u_texlayer[v_texindex]))) * v_color;
+
+    /* Debug */
+    //color = vec4(vec3(float(v_texindex)/16.0), 1.0);
+}
\ No newline at end of file
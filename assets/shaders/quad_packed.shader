@@ -0,0 +1,54 @@
+#lk_shader vertex 
+#version 450 core
+layout(location = 0) in vec3 pos;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 texcoord;
+layout(location = 3) in uint texindextile; /* [TileFactor:16 (half)][Reserved:8][TexIndex:8] */
+
+out vec4 v_color;
+out vec2 v_texcoord;
+flat out int v_texindex;
+out float v_tilefactor;
+
+layout(std140, binding = 0) uniform ub_camera
+{
+    mat4 u_viewproj;
+};
+
+void main()
+{
+    gl_Position = u_viewproj * vec4(pos.xyz, 1.0);
+
+    v_color = color;
+    v_texcoord = texcoord;
+    v_texindex = int(texindextile & 0xFFu);
+    v_tilefactor = unpackHalf2x16(texindextile >> 16).x;
+}
+
+#lk_shader fragment
+#version 450 core
+layout(location = 0) out vec4 color;
+
+in vec4 v_color;
+in vec2 v_texcoord;
+flat in int v_texindex;
+in float v_tilefactor;
+
+#define MAX_ARRAY_TEXTURES 256
+
+uniform sampler2DArray u_textures;
+uniform vec4 u_texregion[MAX_ARRAY_TEXTURES]; /* Offset (xy) and size (zw) in texels of each texture. */
+uniform int u_texlayer[MAX_ARRAY_TEXTURES];
+
+void main()
+{
+    /* Clamp to the edge of the region of the texture, as GL_CLAMP_TO_EDGE would. */
+    const vec4 region = u_texregion[v_texindex];
+    const vec2 texel = region.xy + clamp(v_texcoord * region.zw, vec2(0.5), region.zw - vec2(0.5));
+    const vec2 uv = texel / vec2(textureSize(u_textures, 0).xy);
+
+    color = texture(u_textures, vec3(uv, float(u_texlayer[v_texindex]))) * v_color;
+
+    /* Debug */
+    //color = vec4(vec3(float(v_texindex)/16.0), 1.0);
+}
\ No newline at end of file
@@ -18,6 +18,7 @@ set -- \
   GL_ARB_debug_output \
   GL_ARB_timer_query \
   GL_ARB_direct_state_access \
+  GL_EXT_texture_compression_s3tc \
   GL_KHR_debug
 
 extensions=$(printf '%s,' "$@")
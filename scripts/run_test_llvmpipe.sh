@@ -0,0 +1,16 @@
+# Build and run the renderer tests on Mesa llvmpipe, no GPU required.
+# Requires xvfb-run and the Mesa software drivers.
+cd "$(dirname "${BASH_SOURCE[0]}")"/.. || exit 1
+echo "script args: $@"
+
+cmake -S . -B build -DLK_TEST_RENDERER_DRAWQUADS=1
+cmake --build build -j 8 --target renderer_drawquads || exit 1
+
+echo ""
+echo "Running test (llvmpipe)"
+
+# The second run loads the programs stored by the first one.
+for Run in 1 2; do
+	LIBGL_ALWAYS_SOFTWARE=1 GALLIUM_DRIVER=llvmpipe MESA_GL_VERSION_OVERRIDE=4.5 \
+		xvfb-run -a ./build/renderer_drawquads/renderer_drawquads "$@" || exit 1
+done
@@ -1,5 +1,8 @@
 #include "application.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "game/player.h"
 #include "core/input/keyboard.h"
 #include "core/input/mouse.h"
@@ -12,9 +15,39 @@
 
 namespace platformer2d {
 
+	namespace
+	{
+		/* Quiet frames before idling, lets UI transitions and effects settle first. */
+		constexpr uint16_t IDLE_FRAME_THRESHOLD = 30;
+		constexpr float IDLE_WAIT_TIMEOUT = 0.50f; /* Seconds. */
+	}
+
 	CApplication::CApplication(int Argc, char* Argv[])
 	{
 		CLog::Initialize();
+
+		for (int Idx = 1; Idx < Argc; Idx++)
+		{
+			if (std::string_view(Argv[Idx]) == "--headless")
+			{
+				RenderBackend = ERenderBackend::Null;
+			}
+			else if (std::string_view(Argv[Idx]) == "--render-thread")
+			{
+				bRenderThread = true;
+			}
+			else if ((std::string_view(Argv[Idx]) == "--tick-rate") && ((Idx + 1) < Argc))
+			{
+				const int TickRate = std::atoi(Argv[++Idx]);
+				LK_VERIFY((TickRate > 0) && (TickRate <= UINT16_MAX), "Invalid tick rate: {}", Argv[Idx]);
+				FixedTimestep.SetTickRate(static_cast<uint16_t>(TickRate));
+			}
+			else if ((std::string_view(Argv[Idx]) == "--frame-limit") && ((Idx + 1) < Argc))
+			{
+				FrameLimit = std::atoi(Argv[++Idx]);
+				LK_VERIFY((FrameLimit >= 0) && (FrameLimit <= UINT16_MAX), "Invalid frame limit: {}", Argv[Idx]);
+			}
+		}
 	}
 
 	CApplication::~CApplication()
@@ -27,12 +60,18 @@ namespace platformer2d {
 		LK_DEBUG_TAG("Application", "Initializing");
 		const char* WindowName = "platformer2d";
 		Window = std::make_unique<CWindow>(SCREEN_WIDTH, SCREEN_HEIGHT, WindowName);
-		Window->Initialize();
+		Window->Initialize(RenderBackend == ERenderBackend::Null);
 
 		CPhysicsWorld::Initialize();
-		CRenderer::Initialize();
+		CRenderer::Initialize({ .Backend = RenderBackend, .bRenderThread = bRenderThread });
 		CKeyboard::Initialize();
 		CMouse::Initialize();
+
+		/* Headless runs have no display to pace against and are unlimited unless asked otherwise. */
+		const uint16_t FrameRate = (FrameLimit >= 0) ? static_cast<uint16_t>(FrameLimit)
+			: (Window->IsHeadless() ? 0 : Window->GetRefreshRate());
+		FrameLimiter.SetFrameRate(FrameRate);
+		LK_DEBUG_TAG("Application", "Frame limit without VSync: {}", FrameRate);
 	}
 
 	void CApplication::Shutdown()
@@ -52,29 +91,57 @@ namespace platformer2d {
 
 	void CApplication::Run()
 	{
-		LK_VERIFY(Window && Window->GetGlfwWindow());
+		LK_VERIFY(Window && (Window->GetGlfwWindow() || Window->IsHeadless()));
 		LK_VERIFY(LayerStack.Count() > 0);
 
-		const FWindowData& WindowData = Window->GetData();
-		GLFWwindow* GlfwWindow = Window->GetGlfwWindow();
-
 		CEffectManager& EffectManager = CEffectManager::Get();
 
+		LK_DEBUG_TAG("Application", "Tick rate: {} Hz", FixedTimestep.GetTickRate());
 		bRunning = true;
 		Timer.Reset();
-		while (!glfwWindowShouldClose(GlfwWindow))
+		FixedTimestep.Reset();
+		FrameLimiter.Reset();
+
+		uint32_t EventCount = Window->GetEventCount();
+		uint16_t QuietFrames = 0;
+		while (!Window->ShouldClose())
 		{
 			if (Core::Global.bShouldShutdown)
 			{
 				break;
 			}
 
+			if ((QuietFrames >= IDLE_FRAME_THRESHOLD) && !Window->WaitEvents(IDLE_WAIT_TIMEOUT))
+			{
+				/* Nothing changed, the frame is not rendered again and the time spent waiting is not simulated. */
+				Timer.GetDeltaTime();
+				FrameLimiter.Reset();
+				continue;
+			}
+
 			const float DeltaTime = Timer.GetDeltaTime();
-			CPhysicsWorld::Update(DeltaTime);
+			const uint16_t Steps = FixedTimestep.Advance(DeltaTime);
 
 			Window->BeginFrame();
 			CKeyboard::Update();
+
+			const bool bInputReceived = (Window->GetEventCount() != EventCount);
+			EventCount = Window->GetEventCount();
+
+			/* Gameplay and physics run at the fixed tick rate, rendering interpolates between the last two steps. */
+			const float StepTime = FixedTimestep.GetStepTime();
+			for (uint16_t Step = 0; Step < Steps; Step++)
+			{
+				for (auto& Layer : LayerStack)
+				{
+					Layer->FixedTick(StepTime);
+				}
+				CPhysicsWorld::Update(StepTime);
+			}
+			CPhysicsWorld::SetInterpolationAlpha(FixedTimestep.GetAlpha());
+
 			CRenderer::BeginFrame();
+			CPhysicsWorld::DrawDebug();
 
 			for (auto& Layer : LayerStack)
 			{
@@ -92,9 +159,23 @@ namespace platformer2d {
 			CRenderer::EndFrame();
 			CKeyboard::TransitionPressedKeys();
 			Window->EndFrame();
+
+			QuietFrames = ShouldIdle(bInputReceived) ? std::min<uint16_t>(QuietFrames + 1, IDLE_FRAME_THRESHOLD) : 0;
+			if (!Window->GetVSync())
+			{
+				FrameLimiter.Wait();
+			}
 		}
 	}
 
+	bool CApplication::ShouldIdle(const bool bInputReceived) const
+	{
+		return !Window->IsHeadless()
+			&& !bInputReceived
+			&& UI::IsGameMenuOpen()
+			&& CPhysicsWorld::IsPaused();
+	}
+
 	bool CApplication::PushLayer(std::shared_ptr<CLayer> Layer)
 	{
 		LK_VERIFY(Layer);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "core/window.h"
+#include "core/fixedtimestep.h"
+#include "core/framelimiter.h"
 #include "core/layerstack.h"
 #include "core/timer.h"
 #include "renderer/renderer.h"
@@ -21,11 +23,23 @@ namespace platformer2d {
 
 		bool PushLayer(std::shared_ptr<CLayer> Layer);
 
+	protected:
+		/**
+		 * @brief Idle while the game menu is open, physics is paused and no input is received.
+		 * An idle loop waits for events instead of rendering unchanged frames.
+		 */
+		bool ShouldIdle(bool bInputReceived) const;
+
 	protected:
 		bool bRunning = false;
+		ERenderBackend RenderBackend = ERenderBackend::OpenGL; /* Null with --headless. */
+		bool bRenderThread = false; /* Set with --render-thread. */
 		std::unique_ptr<CWindow> Window;
 		CLayerStack LayerStack;
 		CTimer Timer;
+		CFixedTimestep FixedTimestep; /* Tick rate set with --tick-rate. */
+		CFrameLimiter FrameLimiter;   /* Used when VSync is disabled. */
+		int FrameLimit = -1;          /* Set with --frame-limit, 0 for unlimited, the monitor refresh rate (unlimited headless) if negative. */
 	};
 
 }
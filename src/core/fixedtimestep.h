@@ -0,0 +1,91 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace platformer2d {
+
+	/**
+	 * @brief Accumulator that splits variable frame times into steps of a fixed length.
+	 *
+	 * The time left over after the last step is kept for the next frame and
+	 * is exposed as the interpolation alpha between the last two steps.
+	 * At most MaxStepsPerFrame steps are taken in one frame, time beyond that is
+	 * dropped so a slow frame does not cause even more steps on the next one.
+	 */
+	class CFixedTimestep
+	{
+	public:
+		static constexpr uint16_t DEFAULT_TICK_RATE = 60;
+		static constexpr uint16_t DEFAULT_MAX_STEPS_PER_FRAME = 8;
+
+		CFixedTimestep(const uint16_t InTickRate = DEFAULT_TICK_RATE,
+					   const uint16_t InMaxStepsPerFrame = DEFAULT_MAX_STEPS_PER_FRAME)
+			: MaxStepsPerFrame(std::max<uint16_t>(InMaxStepsPerFrame, 1))
+		{
+			SetTickRate(InTickRate);
+		}
+
+		/**
+		 * @brief Add the time of a frame.
+		 * @return Number of steps to take this frame.
+		 */
+		uint16_t Advance(const float FrameTime)
+		{
+			Accumulator += std::max(static_cast<double>(FrameTime), 0.0);
+
+			uint64_t Steps = static_cast<uint64_t>(std::floor(Accumulator / StepTime));
+			if (Steps > MaxStepsPerFrame)
+			{
+				DroppedTime += static_cast<double>(Steps - MaxStepsPerFrame) * StepTime;
+				Steps = MaxStepsPerFrame;
+				Accumulator = std::fmod(Accumulator, StepTime);
+			}
+			else
+			{
+				/* Rounding may leave a tiny negative remainder. */
+				Accumulator = std::max(Accumulator - (static_cast<double>(Steps) * StepTime), 0.0);
+			}
+
+			return static_cast<uint16_t>(Steps);
+		}
+
+		void Reset()
+		{
+			Accumulator = 0.0;
+			DroppedTime = 0.0;
+		}
+
+		/**
+		 * @brief Set the number of steps per second, the accumulated time is kept.
+		 */
+		void SetTickRate(const uint16_t InTickRate)
+		{
+			TickRate = std::max<uint16_t>(InTickRate, 1);
+			StepTime = 1.0 / static_cast<double>(TickRate);
+		}
+
+		inline uint16_t GetTickRate() const { return TickRate; }
+		inline float GetStepTime() const { return static_cast<float>(StepTime); }
+		inline uint16_t GetMaxStepsPerFrame() const { return MaxStepsPerFrame; }
+
+		/**
+		 * @brief Fraction of a step accumulated since the last step, in [0, 1).
+		 */
+		inline float GetAlpha() const { return static_cast<float>(Accumulator / StepTime); }
+
+		/**
+		 * @brief Total time dropped by the step limit, in seconds.
+		 */
+		inline float GetDroppedTime() const { return static_cast<float>(DroppedTime); }
+
+	private:
+		uint16_t TickRate = DEFAULT_TICK_RATE;
+		uint16_t MaxStepsPerFrame = DEFAULT_MAX_STEPS_PER_FRAME;
+		double StepTime = 1.0 / DEFAULT_TICK_RATE;
+		double Accumulator = 0.0;
+		double DroppedTime = 0.0;
+	};
+
+}
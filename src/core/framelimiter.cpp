@@ -0,0 +1,66 @@
+#include "framelimiter.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace platformer2d {
+
+	namespace
+	{
+		constexpr std::chrono::microseconds SLEEP_INTERVAL(1000);
+	}
+
+	CFrameLimiter::CFrameLimiter(const uint16_t InFrameRate)
+	{
+		SetFrameRate(InFrameRate);
+	}
+
+	void CFrameLimiter::Wait()
+	{
+		using namespace std::chrono;
+		if (FrameRate == 0)
+		{
+			return;
+		}
+
+		/* Sleep while more time is left than a sleep may overshoot. */
+		while ((Deadline - FClock::now()) > (SLEEP_INTERVAL + SleepOvershoot))
+		{
+			const FClock::time_point SleepStart = FClock::now();
+			std::this_thread::sleep_for(SLEEP_INTERVAL);
+			const nanoseconds Overshoot = duration_cast<nanoseconds>(FClock::now() - SleepStart) - SLEEP_INTERVAL;
+
+			/* Rises with the worst sleep right away and decays slowly. */
+			SleepOvershoot = std::max(Overshoot, (SleepOvershoot * 15 + Overshoot) / 16);
+		}
+
+		while (FClock::now() < Deadline)
+		{
+			std::this_thread::yield();
+		}
+
+		/* A frame that ran more than a frame late starts the cadence over instead of being caught up on. */
+		const FClock::time_point Now = FClock::now();
+		Deadline += FrameTime;
+		if (Deadline < Now)
+		{
+			Deadline = Now + FrameTime;
+		}
+	}
+
+	void CFrameLimiter::Reset()
+	{
+		Deadline = FClock::now() + FrameTime;
+	}
+
+	void CFrameLimiter::SetFrameRate(const uint16_t InFrameRate)
+	{
+		using namespace std::chrono;
+		FrameRate = InFrameRate;
+		FrameTime = (FrameRate > 0)
+			? duration_cast<FClock::duration>(duration<double>(1.0 / FrameRate))
+			: FClock::duration::zero();
+		Reset();
+	}
+
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace platformer2d {
+
+	/**
+	 * @brief Paces a loop to a target frame rate.
+	 *
+	 * Most of the wait is slept away, the last part of it is spun so the frame
+	 * ends close to its deadline without depending on the scheduler granularity.
+	 * How long a sleep overshoots is measured while waiting and the spin covers that.
+	 */
+	class CFrameLimiter
+	{
+	public:
+		/**
+		 * @param InFrameRate Target frames per second, 0 for unlimited.
+		 */
+		CFrameLimiter(uint16_t InFrameRate = 0);
+
+		/**
+		 * @brief Block until the end of the current frame.
+		 */
+		void Wait();
+
+		/**
+		 * @brief Start the next frame now, after a stall that should not be caught up on.
+		 */
+		void Reset();
+
+		void SetFrameRate(uint16_t InFrameRate);
+		inline uint16_t GetFrameRate() const { return FrameRate; }
+
+	private:
+		using FClock = std::chrono::steady_clock;
+
+		uint16_t FrameRate = 0;
+		FClock::duration FrameTime{};
+		FClock::time_point Deadline{};
+
+		/* Estimated overshoot of a short sleep, the part of the wait that is spun. */
+		std::chrono::nanoseconds SleepOvershoot = std::chrono::microseconds(500);
+	};
+
+}
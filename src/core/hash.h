@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace platformer2d::Hash {
+
+	static constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+	static constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+	/**
+	 * @brief 64-bit FNV-1a, pass a previous result as seed to hash several ranges as one.
+	 */
+	inline constexpr uint64_t FNV1a(std::span<const std::byte> Data, uint64_t Seed = FNV_OFFSET_BASIS)
+	{
+		for (const std::byte Byte : Data)
+		{
+			Seed ^= static_cast<uint64_t>(Byte);
+			Seed *= FNV_PRIME;
+		}
+
+		return Seed;
+	}
+
+	inline constexpr uint64_t FNV1a(std::string_view Data, uint64_t Seed = FNV_OFFSET_BASIS)
+	{
+		for (const char Char : Data)
+		{
+			Seed ^= static_cast<uint64_t>(static_cast<uint8_t>(Char));
+			Seed *= FNV_PRIME;
+		}
+
+		return Seed;
+	}
+
+}
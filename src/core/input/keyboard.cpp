@@ -13,7 +13,7 @@ namespace platformer2d {
 	void CKeyboard::Initialize()
 	{
 		ActiveWindow = CWindow::Get()->GetGlfwWindow();
-		LK_VERIFY(ActiveWindow);
+		LK_VERIFY(ActiveWindow || CWindow::Get()->IsHeadless());
 	}
 
 	void CKeyboard::Update()
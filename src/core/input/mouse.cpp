@@ -12,7 +12,7 @@ namespace platformer2d {
 	void CMouse::Initialize()
 	{
 		ActiveWindow = CWindow::Get()->GetGlfwWindow();
-		LK_VERIFY(ActiveWindow);
+		LK_VERIFY(ActiveWindow || CWindow::Get()->IsHeadless());
 	}
 
 	void CMouse::Enable()
@@ -42,22 +42,31 @@ namespace platformer2d {
 
 	float CMouse::GetX()
 	{
-		double X, Y;
-		glfwGetCursorPos(ActiveWindow, &X, &Y);
+		double X = 0.0, Y = 0.0;
+		if (ActiveWindow)
+		{
+			glfwGetCursorPos(ActiveWindow, &X, &Y);
+		}
 		return static_cast<float>(X);
 	}
 
 	float CMouse::GetY()
 	{
-		double X, Y;
-		glfwGetCursorPos(ActiveWindow, &X, &Y);
+		double X = 0.0, Y = 0.0;
+		if (ActiveWindow)
+		{
+			glfwGetCursorPos(ActiveWindow, &X, &Y);
+		}
 		return static_cast<float>(Y);
 	}
 
 	std::pair<float, float> CMouse::GetPos()
 	{
-		double X, Y;
-		glfwGetCursorPos(ActiveWindow, &X, &Y);
+		double X = 0.0, Y = 0.0;
+		if (ActiveWindow)
+		{
+			glfwGetCursorPos(ActiveWindow, &X, &Y);
+		}
 		return std::make_pair<float, float>(X, Y);
 	}
 
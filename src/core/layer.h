@@ -14,6 +14,11 @@ namespace platformer2d {
 		virtual void OnAttach() {}
 		virtual void OnDetach() {}
 
+		/**
+		 * @brief Called for every simulation step, before the physics world is stepped.
+		 * @param FixedDeltaTime Length of a step, see CFixedTimestep.
+		 */
+		virtual void FixedTick(float FixedDeltaTime) {}
 		virtual void Tick(float DeltaTime) = 0;
 		virtual void RenderUI() {}
 
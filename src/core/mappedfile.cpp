@@ -0,0 +1,135 @@
+#include "mappedfile.h"
+
+#include <utility>
+
+#if defined(_WIN32)
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif
+#	ifndef NOMINMAX
+#		define NOMINMAX
+#	endif
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace platformer2d {
+
+	CMappedFile::~CMappedFile()
+	{
+		Close();
+	}
+
+	CMappedFile::CMappedFile(CMappedFile&& Other) noexcept
+	{
+		*this = std::move(Other);
+	}
+
+	CMappedFile& CMappedFile::operator=(CMappedFile&& Other) noexcept
+	{
+		if (this != &Other)
+		{
+			Close();
+			Data = std::exchange(Other.Data, nullptr);
+			Size = std::exchange(Other.Size, 0);
+#if defined(_WIN32)
+			FileHandle = std::exchange(Other.FileHandle, nullptr);
+			MappingHandle = std::exchange(Other.MappingHandle, nullptr);
+#endif
+		}
+
+		return *this;
+	}
+
+	bool CMappedFile::Open(const std::filesystem::path& Path)
+	{
+		Close();
+
+#if defined(_WIN32)
+		HANDLE File = CreateFileW(Path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+								  OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (File == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER FileSize;
+		if (!GetFileSizeEx(File, &FileSize) || (FileSize.QuadPart == 0))
+		{
+			CloseHandle(File);
+			return false;
+		}
+
+		HANDLE Mapping = CreateFileMappingW(File, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (Mapping == nullptr)
+		{
+			CloseHandle(File);
+			return false;
+		}
+
+		void* View = MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+		if (View == nullptr)
+		{
+			CloseHandle(Mapping);
+			CloseHandle(File);
+			return false;
+		}
+
+		FileHandle = File;
+		MappingHandle = Mapping;
+		Data = static_cast<const std::byte*>(View);
+		Size = static_cast<std::size_t>(FileSize.QuadPart);
+#else
+		const int File = open(Path.c_str(), O_RDONLY);
+		if (File < 0)
+		{
+			return false;
+		}
+
+		struct stat FileStat;
+		if ((fstat(File, &FileStat) != 0) || (FileStat.st_size == 0))
+		{
+			close(File);
+			return false;
+		}
+
+		void* View = mmap(nullptr, static_cast<std::size_t>(FileStat.st_size), PROT_READ, MAP_PRIVATE, File, 0);
+		/* The mapping keeps its own reference to the file. */
+		close(File);
+		if (View == MAP_FAILED)
+		{
+			return false;
+		}
+
+		Data = static_cast<const std::byte*>(View);
+		Size = static_cast<std::size_t>(FileStat.st_size);
+#endif
+
+		return true;
+	}
+
+	void CMappedFile::Close()
+	{
+		if (Data == nullptr)
+		{
+			return;
+		}
+
+#if defined(_WIN32)
+		UnmapViewOfFile(Data);
+		CloseHandle(MappingHandle);
+		CloseHandle(FileHandle);
+		MappingHandle = nullptr;
+		FileHandle = nullptr;
+#else
+		munmap(const_cast<std::byte*>(Data), Size);
+#endif
+		Data = nullptr;
+		Size = 0;
+	}
+
+}
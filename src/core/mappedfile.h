@@ -0,0 +1,48 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "core/core.h"
+
+namespace platformer2d {
+
+	/**
+	 * @brief Read-only memory mapping of a file.
+	 *
+	 * The pages are loaded by the OS on first access, so the content can be
+	 * passed on to the GPU without being copied into a buffer first.
+	 */
+	class CMappedFile
+	{
+	public:
+		CMappedFile() = default;
+		~CMappedFile();
+		CMappedFile(CMappedFile&& Other) noexcept;
+		CMappedFile& operator=(CMappedFile&& Other) noexcept;
+
+		/**
+		 * @brief Map a file, replacing any previous mapping.
+		 * @return true if the file was mapped.
+		 */
+		bool Open(const std::filesystem::path& Path);
+		void Close();
+
+		FORCEINLINE bool IsOpen() const { return (Data != nullptr); }
+		FORCEINLINE const std::byte* GetData() const { return Data; }
+		FORCEINLINE std::size_t GetSize() const { return Size; }
+		FORCEINLINE std::span<const std::byte> GetSpan() const { return { Data, Size }; }
+
+	private:
+		const std::byte* Data = nullptr;
+		std::size_t Size = 0;
+#if defined(_WIN32)
+		void* FileHandle = nullptr;
+		void* MappingHandle = nullptr;
+#endif
+
+		CMappedFile(const CMappedFile&) = delete;
+		CMappedFile& operator=(const CMappedFile&) = delete;
+	};
+
+}
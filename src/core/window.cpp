@@ -24,8 +24,17 @@ namespace platformer2d {
 		return Instance;
 	}
 
-	void CWindow::Initialize()
+	void CWindow::Initialize(const bool bInHeadless)
 	{
+		bHeadless = bInHeadless;
+		Data.WindowRef = this;
+		if (bHeadless)
+		{
+			ContextThread = std::this_thread::get_id();
+			LK_DEBUG_TAG("Window", "Headless: ({}, {})", Data.Width, Data.Height);
+			return;
+		}
+
 		const int GlfwInit = glfwInit();
 		glfwSetErrorCallback([](const int Error, const char* Description)
 		{
@@ -41,16 +50,16 @@ namespace platformer2d {
 #endif
 
 		LK_DEBUG_TAG("Window", "Create: ({}, {})", Data.Width, Data.Height);
-		Data.WindowRef = this;
 		GlfwWindow = glfwCreateWindow(Data.Width, Data.Height, Data.Title.c_str(), nullptr, nullptr);
 		LK_VERIFY(GlfwWindow);
-		glfwMakeContextCurrent(GlfwWindow);
+		MakeContextCurrent();
 		glfwSetWindowUserPointer(GlfwWindow, &Data);
 
 		glfwSetWindowSizeCallback(GlfwWindow, [](GLFWwindow* InGlfwWindow, int NewWidth, int NewHeight) 
 		{
 			FWindowData& Data = *((FWindowData*)glfwGetWindowUserPointer(InGlfwWindow));
 			LK_ASSERT(Data.WindowRef, "Invalid window reference");
+			Data.WindowRef->EventCount++;
 			Data.WindowRef->SetSize(NewWidth, NewHeight);
 		});
 
@@ -66,6 +75,7 @@ namespace platformer2d {
 		{
 			LK_TRACE_TAG("Window", "Key={} Action={} Modifiers={}", Key, Action, Modifiers);
 			FWindowData& WindowDataRef = *((FWindowData*)glfwGetWindowUserPointer(Window));
+			WindowDataRef.WindowRef->EventCount++;
 			switch (Action)
 			{
 				case GLFW_PRESS:
@@ -88,6 +98,7 @@ namespace platformer2d {
 
 		glfwSetMouseButtonCallback(GlfwWindow, [](GLFWwindow* Window, int Button, int Action, int Modifiers)
 		{
+			static_cast<FWindowData*>(glfwGetWindowUserPointer(Window))->WindowRef->EventCount++;
 			switch (Action)
 			{
 				case GLFW_PRESS:
@@ -105,6 +116,7 @@ namespace platformer2d {
 
 		glfwSetScrollCallback(GlfwWindow, [](GLFWwindow* Window, double OffsetX, double OffsetY)
 		{
+			static_cast<FWindowData*>(glfwGetWindowUserPointer(Window))->WindowRef->EventCount++;
 			if (OffsetY > 0)
 			{
 				CMouse::UpdateScrollState(EMouseScrollDirection::Up);
@@ -115,6 +127,17 @@ namespace platformer2d {
 			}
 		});
 
+		/* Hovering UI and exposed window contents need a new frame as well. */
+		glfwSetCursorPosCallback(GlfwWindow, [](GLFWwindow* Window, double PosX, double PosY)
+		{
+			static_cast<FWindowData*>(glfwGetWindowUserPointer(Window))->WindowRef->EventCount++;
+		});
+
+		glfwSetWindowRefreshCallback(GlfwWindow, [](GLFWwindow* Window)
+		{
+			static_cast<FWindowData*>(glfwGetWindowUserPointer(Window))->WindowRef->EventCount++;
+		});
+
 		glfwSetWindowMaximizeCallback(GlfwWindow, [](GLFWwindow* Window, int Maximized)
 		{
 			LK_TRACE_TAG("Window", "Maximize callback");
@@ -131,19 +154,108 @@ namespace platformer2d {
 
 	void CWindow::Destroy()
 	{
-		glfwTerminate();
+		if (!bHeadless)
+		{
+			glfwTerminate();
+		}
 		GlfwWindow = nullptr;
 	}
 
+	bool CWindow::ShouldClose() const
+	{
+		return !bHeadless && (glfwWindowShouldClose(GlfwWindow) == GLFW_TRUE);
+	}
+
 	void CWindow::BeginFrame()
 	{
+		if (bHeadless)
+		{
+			return;
+		}
+
 		glfwPollEvents();
 	}
 
 	void CWindow::EndFrame()
 	{
+		if (bHeadless)
+		{
+			return;
+		}
+
+		/* Events are polled once per frame, by BeginFrame. */
+		if (IsContextCurrent())
+		{
+			SwapBuffers();
+		}
+	}
+
+	bool CWindow::WaitEvents(const float TimeoutSeconds)
+	{
+		if (bHeadless)
+		{
+			return false;
+		}
+
+		const uint32_t EventCountBefore = EventCount;
+		glfwWaitEventsTimeout(TimeoutSeconds);
+		return (EventCount != EventCountBefore);
+	}
+
+	void CWindow::MakeContextCurrent()
+	{
+		if (!bHeadless)
+		{
+			glfwMakeContextCurrent(GlfwWindow);
+		}
+		ContextThread = std::this_thread::get_id();
+		ApplyPendingState();
+	}
+
+	void CWindow::ReleaseContext()
+	{
+		LK_ASSERT(IsContextCurrent(), "Context released by a thread it is not current on");
+		if (!bHeadless)
+		{
+			glfwMakeContextCurrent(nullptr);
+		}
+		ContextThread = std::thread::id();
+	}
+
+	bool CWindow::IsContextCurrent() const
+	{
+		return (ContextThread.load() == std::this_thread::get_id());
+	}
+
+	void CWindow::SwapBuffers()
+	{
+		LK_ASSERT(IsContextCurrent(), "Buffers swapped by a thread the context is not current on");
+		if (bHeadless)
+		{
+			return;
+		}
+
 		glfwSwapBuffers(GlfwWindow);
-		glfwPollEvents();
+		ApplyPendingState();
+	}
+
+	void CWindow::ApplyPendingState()
+	{
+		if (bHeadless)
+		{
+			PendingViewport = 0;
+			PendingSwapInterval = -1;
+			return;
+		}
+
+		if (const uint32_t Viewport = PendingViewport.exchange(0); Viewport != 0)
+		{
+			LK_OpenGL_Verify(glViewport(0, 0, Viewport >> 16, Viewport & 0xFFFF));
+		}
+		if (const int SwapInterval = PendingSwapInterval.exchange(-1); SwapInterval >= 0)
+		{
+			glfwSwapInterval(SwapInterval);
+		}
 	}
 
 	void CWindow::SetSize(const uint16_t InWidth, const uint16_t InHeight)
@@ -152,27 +264,45 @@ namespace platformer2d {
 		{
 			Data.Width = InWidth;
 			Data.Height = InHeight;
-			LK_OpenGL_Verify(glViewport(0, 0, Data.Width, Data.Height));
+
+			/* The context may be current on the render thread, which picks the viewport up after its next swap. */
+			PendingViewport = (static_cast<uint32_t>(Data.Width) << 16) | Data.Height;
+			if (IsContextCurrent())
+			{
+				ApplyPendingState();
+			}
 			OnResized.Broadcast(InWidth, InHeight);
 		}
 	}
 
 	void CWindow::SetTitle(std::string_view NewTitle)
 	{
-		LK_ASSERT(GlfwWindow);
 		LK_DEBUG_TAG("Window", "Set title: {}", NewTitle);
-		glfwSetWindowTitle(GlfwWindow, NewTitle.data());
+		Data.Title = NewTitle;
+		if (GlfwWindow)
+		{
+			glfwSetWindowTitle(GlfwWindow, Data.Title.c_str());
+		}
 	}
 
 	void CWindow::SetVSync(const bool Enabled)
 	{
 		LK_DEBUG_TAG("Window", "VSync: {}", Enabled ? "Enabled" : "Disabled");
-		glfwSwapInterval(Enabled);
+		PendingSwapInterval = Enabled ? 1 : 0;
+		if (IsContextCurrent())
+		{
+			ApplyPendingState();
+		}
 		Data.bVSync = Enabled;
 	}
 
 	uint16_t CWindow::GetRefreshRate() const
 	{
+		if (bHeadless)
+		{
+			return 60;
+		}
+
 		GLFWmonitor* Monitor = glfwGetPrimaryMonitor();
 		const GLFWvidmode* Mode = glfwGetVideoMode(Monitor);
 		LK_ASSERT(Monitor && Mode);
@@ -189,7 +319,7 @@ namespace platformer2d {
 
 	bool CWindow::IsMaximized() const
 	{
-		return (glfwGetWindowAttrib(GlfwWindow, GLFW_MAXIMIZED) == GLFW_TRUE);
+		return GlfwWindow && (glfwGetWindowAttrib(GlfwWindow, GLFW_MAXIMIZED) == GLFW_TRUE);
 	}
 
 	void CWindow::SetIcon(const std::filesystem::path ImagePath)
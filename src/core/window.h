@@ -1,7 +1,9 @@
 #pragma once
 
 #include <stdint.h>
+#include <atomic>
 #include <string>
+#include <thread>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -39,12 +41,49 @@ namespace platformer2d {
 
 		static CWindow* Get();
 
-		void Initialize();
+		/**
+		 * @brief Create the window and its OpenGL context.
+		 * @param bInHeadless Skip GLFW entirely, for use with the null render backend.
+		 */
+		void Initialize(bool bInHeadless = false);
 		void Destroy();
+		bool ShouldClose() const;
 
+		/**
+		 * @brief Poll events, once per frame.
+		 */
 		void BeginFrame();
+
+		/**
+		 * @brief Swap the buffers if the context is current on the calling thread.
+		 * With the context on another thread that thread swaps, see SwapBuffers.
+		 */
 		void EndFrame();
 
+		/**
+		 * @brief Sleep until an event is received or the timeout expires.
+		 * @return True if an event was received.
+		 */
+		bool WaitEvents(float TimeoutSeconds);
+
+		/**
+		 * @brief Number of input and window events received, compared between frames to detect input.
+		 */
+		inline uint32_t GetEventCount() const { return EventCount; }
+
+		/**
+		 * @brief Make the OpenGL context current on the calling thread.
+		 * Resizes and swap interval changes made on other threads are applied by this thread.
+		 */
+		void MakeContextCurrent();
+		void ReleaseContext();
+		bool IsContextCurrent() const;
+
+		/**
+		 * @brief Present the frame, on the thread the context is current on.
+		 */
+		void SwapBuffers();
+
 		inline uint16_t GetWidth() const { return Data.Width; }
 		inline uint16_t GetHeight() const { return Data.Height; }
 		inline glm::vec2 GetSize() const { return { Data.Width, Data.Height }; }
@@ -58,16 +97,24 @@ namespace platformer2d {
 
 		const FWindowData& GetData() const { return Data; }
 		inline GLFWwindow* GetGlfwWindow() const { return GlfwWindow; }
+		inline bool IsHeadless() const { return bHeadless; }
 
 	private:
 		void SetIcon(std::filesystem::path ImagePath);
 		void Centralize();
+		void ApplyPendingState();
 
 	public:
 		static inline FOnResized OnResized;
 	private:
 		GLFWwindow* GlfwWindow = nullptr;
 		FWindowData Data{};
+		bool bHeadless = false;
+		uint32_t EventCount = 0;
+
+		std::atomic<std::thread::id> ContextThread{};
+		std::atomic<uint32_t> PendingViewport = 0;   /* Width << 16 | Height, zero if unchanged. */
+		std::atomic<int> PendingSwapInterval = -1;   /* Negative if unchanged. */
 
 		static inline CWindow* Instance = nullptr;
 	};
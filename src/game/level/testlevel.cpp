@@ -109,6 +109,7 @@ namespace platformer2d::Level {
 			if (std::shared_ptr<CActor> Actor = ActorRef.lock(); Actor != nullptr)
 			{
 				LK_TRACE_TAG("TestLevel", "OnActorCreated: {} ({})", Actor->GetName(), Handle);
+				bStaticBatchDirty = true;
 				LK_ASSERT(Scene);
 				const auto& Actors = Scene->GetActors(); /* @fixme */
 				std::snprintf(ActorNameBuf, sizeof(ActorNameBuf), "Actor-%lld", Actors.size() + 2);
@@ -129,6 +130,15 @@ namespace platformer2d::Level {
 		CActor::OnActorMarkedForDeletion.Add([&](const LUUID Handle)
 		{
 			std::snprintf(ActorNameBuf, sizeof(ActorNameBuf), "Actor-%lld", Scene->GetActors().size() + 2);
+			bStaticBatchDirty = true;
+		});
+
+		CActor::OnActorModified.Add([&](const LUUID Handle)
+		{
+			if (StaticBatchActors.contains(Handle))
+			{
+				bStaticBatchDirty = true;
+			}
 		});
 
 		const FGameSpecification& Spec = GetSpecification();
@@ -148,6 +158,16 @@ namespace platformer2d::Level {
 		LK_VERIFY(Camera);
 		Camera->SetZoom(Spec.Zoom);
 
+		/* Sort the draws of the level by layer, translucency and depth before batching. */
+		CRenderer::SetSubmissionMode(ESubmissionMode::Sorted);
+
+		/* The clouds only move with the camera, they are redrawn once it has moved too far for the cached image. */
+		CRenderer::SetRenderLayerSpecification(ERenderLayer::Background, {
+			.bOffscreen = true,
+			.bCached = true,
+			.CacheThreshold = 32.0f
+		});
+
 		UI::OnGameMenuOpened.Add([](const bool Opened)
 		{
 			if (Opened)
@@ -173,6 +193,9 @@ namespace platformer2d::Level {
 		Serialize(GameSpec.LevelFilepath);
 
 		LK_DEBUG_TAG("TestLevel", "Release level resources");
+		StaticBatch.Clear();
+		StaticBatchActors.clear();
+		DynamicActors.clear();
 		Player.reset();
 		Scene.reset();
 	}
@@ -189,15 +212,28 @@ namespace platformer2d::Level {
 		Destroy();
 	}
 
+	void CTestLevel::FixedTick(const float FixedDeltaTime)
+	{
+		Player->FixedTick(FixedDeltaTime);
+		Scene->FixedTick(FixedDeltaTime);
+		Tick_Objects(FixedDeltaTime);
+	}
+
 	void CTestLevel::Tick(const float DeltaTime)
 	{
 		CCamera& Camera = Player->GetCamera();
 		Camera.SetViewportSize(ViewportWidth, ViewportHeight);
 		CRenderer::BeginScene(Camera);
 
+		/* Drawn first, the cached background is composited below everything else. */
+		if (CRenderer::BeginLayer(ERenderLayer::Background))
+		{
+			DrawClouds();
+		}
+		CRenderer::EndLayer();
+
 		Player->Tick(DeltaTime);
 		Scene->Tick(DeltaTime);
-		Tick_Objects(DeltaTime);
 
 #if 1
 		const uint16_t Picked = PickSceneAtMouse(Scene, SelectionData);
@@ -221,8 +257,6 @@ namespace platformer2d::Level {
 		}
 #endif
 
-		DrawClouds();
-
 		/* Render player. */
 		const FPolygon* Polygon = Player->GetBody().TryGetShape<EShape::Polygon>();
 		if (Polygon)
@@ -238,23 +272,39 @@ namespace platformer2d::Level {
 		}
 
 		/* Render level. */
-		for (const std::shared_ptr<CActor>& Actor : Scene->GetActors())
+		if (bStaticBatchDirty)
+		{
+			RebuildStaticBatch();
+		}
+		CRenderer::DrawStaticBatch(StaticBatch);
+
+		QuadInstances.clear();
+		for (const std::weak_ptr<CActor>& ActorRef : DynamicActors)
 		{
+			const std::shared_ptr<CActor> Actor = ActorRef.lock();
+			if (!Actor)
+			{
+				continue;
+			}
+
 			const FTransformComponent& TC = Actor->GetTransformComponent();
-			CRenderer::DrawQuad(
-				glm::vec3(Actor->GetPosition(), 0.50f),
+			QuadInstances.emplace_back(
+				glm::vec3(Actor->GetPosition(), 0.010f),
 				TC.Scale,
-				Actor->GetTexture(),
+				TC.GetRotation2D(),
 				Actor->GetColor(),
-				glm::degrees(TC.GetRotation2D())
+				static_cast<uint32_t>(Actor->GetTexture())
 			);
 		}
+		CRenderer::DrawQuads(QuadInstances);
 
 		/* Draw dark overlay whenever the pause menu is open. */
 		if (UI::IsGameMenuOpen())
 		{
 			static constexpr glm::vec4 OverlayColor = { 0.10f, 0.10f, 0.10f, 0.85f };
+			CRenderer::SetRenderLayer(ERenderLayer::Overlay);
 			CRenderer::DrawQuad(glm::vec3(0.0f, 0.0f, 2.0f), { ViewportWidth, ViewportHeight }, OverlayColor);
+			CRenderer::SetRenderLayer(ERenderLayer::World);
 		}
 	}
 
@@ -589,12 +639,46 @@ namespace platformer2d::Level {
 		);
 	}
 
-	void CTestLevel::Tick_Objects(const float DeltaTime)
+	void CTestLevel::Tick_Objects(const float FixedDeltaTime)
 	{
 		if (std::shared_ptr<CActor> Actor = RotatingPlatform.lock(); Actor != nullptr)
 		{
-			Actor->SetRotation(Actor->GetRotation() + glm::radians(0.75f));
+			/* 0.75 degrees per step at 60 Hz, independent of the tick rate. */
+			static constexpr float DegreesPerSecond = 45.0f;
+			const CBody& Body = Actor->GetBody();
+			Body.RotateTo(Body.GetRotation() + glm::radians(DegreesPerSecond * FixedDeltaTime));
+		}
+	}
+
+	void CTestLevel::RebuildStaticBatch()
+	{
+		StaticBatch.Clear();
+		StaticBatchActors.clear();
+		DynamicActors.clear();
+
+		const std::shared_ptr<CActor> Rotating = RotatingPlatform.lock();
+		for (const std::shared_ptr<CActor>& Actor : Scene->GetActors())
+		{
+			/* The rotating platform has a static body but is rotated every tick. */
+			if ((Actor->GetBody().GetType() != EBodyType::Static) || (Actor == Rotating))
+			{
+				DynamicActors.push_back(Actor);
+				continue;
+			}
+
+			const FTransformComponent& TC = Actor->GetTransformComponent();
+			StaticBatch.AddQuad(FQuadInstance(
+				glm::vec3(Actor->GetPosition(), 0.010f),
+				TC.Scale,
+				TC.GetRotation2D(),
+				Actor->GetColor(),
+				static_cast<uint32_t>(Actor->GetTexture())
+			));
+			StaticBatchActors.insert(Actor->GetHandle());
 		}
+
+		LK_DEBUG_TAG("TestLevel", "Rebuilt static batch: {} static, {} dynamic", StaticBatch.GetQuadCount(), DynamicActors.size());
+		bStaticBatchDirty = false;
 	}
 
 	void CTestLevel::UI_Level()
@@ -903,14 +987,19 @@ namespace platformer2d::Level {
 		const ETexture Texture = static_cast<ETexture>(SelectedTextureIdx);
 		if (const std::shared_ptr<CTexture> TextureRef = CRenderer::GetTexture(Texture); TextureRef != nullptr)
 		{
-			/* Texture preview. */
+			/* Texture preview, the region of the texture in a layer of the texture array. */
+			const CTextureArray& TextureArray = CRenderer::GetTextureArray();
+			const FTextureRegion& Region = TextureArray.GetRegion(static_cast<uint32_t>(TextureRef->GetSlot()));
+			const glm::vec2 ArraySize(TextureArray.GetWidth(), TextureArray.GetHeight());
+			const glm::vec2 Min = glm::vec2(Region.Offset) / ArraySize;
+			const glm::vec2 Max = glm::vec2(Region.Offset + Region.Size) / ArraySize;
 			ImGui::SameLine(0.0f, 12.0f);
 			UI::ShiftCursorY(-4.0f);
 			ImGui::Image(
-				static_cast<ImU64>(TextureRef->GetID()),
+				static_cast<ImU64>(TextureArray.GetLayerView(Region.Layer)),
 				ImVec2(32.0f, 32.0f),
-				ImVec2(0.0f, 1.0f), /* Uv0. */
-				ImVec2(1.0f, 0.0f)  /* Uv1. */
+				ImVec2(Min.x, Max.y), /* Uv0. */
+				ImVec2(Max.x, Min.y)  /* Uv1. */
 			);
 
 			static constexpr std::string_view Marker = "assets/textures/";
@@ -946,39 +1035,22 @@ namespace platformer2d::Level {
 			UI::FScopedColor ButtonActiveCol(ImGuiCol_ButtonActive, RGBA32::LightGray);
 			UI::FScopedColor ButtonHoveredCol(ImGuiCol_ButtonHovered, RGBA32::SelectionMuted);
 
+			/* The textures share the sampler of the texture array, the filter applies to all of them. */
 			UI::ShiftCursorX(35.0f);
-			ImGui::Text("Wrap");
-
-			ImGui::SameLine((Avail.x * 0.50f) - (ItemWidth * 0.50f) + ButtonPaddingY);
-			UI::ShiftCursorY(-ButtonPaddingY);
-			if (ImGui::Button("Clamp", ButtonSize))
-			{
-				CRenderer::GetTexture(Texture)->SetWrap(ETextureWrap::Clamp);
-			}
-			ImGui::SameLine(0.0f, ButtonPaddingY);
-			UI::ShiftCursorY(-ButtonPaddingY);
-			if (ImGui::Button("Repeat", ButtonSize))
-			{
-				CRenderer::GetTexture(Texture)->SetWrap(ETextureWrap::Repeat);
-			}
-
-			ImGui::Dummy(ImVec2(0, 6));
-
-			UI::ShiftCursorX(35.0f);
-			ImGui::Text("Filter");
+			ImGui::Text("Filter (all)");
 
 			ImGui::SameLine((Avail.x * 0.50f) - (ItemWidth * 0.50f) + ButtonPaddingY);
 			UI::ShiftCursorY(-ButtonPaddingY);
 			if (ImGui::Button("Linear", ButtonSize))
 			{
-				CRenderer::GetTexture(Texture)->SetFilter(ETextureFilter::Linear);
+				CRenderer::SetTextureFilter(ETextureFilter::Linear);
 			}
 
 			ImGui::SameLine(0.0f, ButtonPaddingY);
 			UI::ShiftCursorY(-ButtonPaddingY);
 			if (ImGui::Button("Nearest", ButtonSize))
 			{
-				CRenderer::GetTexture(Texture)->SetFilter(ETextureFilter::Nearest);
+				CRenderer::SetTextureFilter(ETextureFilter::Nearest);
 			}
 		}
 	}
@@ -991,13 +1063,15 @@ namespace platformer2d::Level {
 		CRenderer::DrawQuad({ 0.0f, 0.0f, 0.0f }, BgSize, BgTexture, FColor::White);
 	}
 
-	void CTestLevel::DrawClouds() const
+	void CTestLevel::DrawClouds()
 	{
-		const CTexture& Texture = *CRenderer::GetTexture(ETexture::Cloud);
+		const uint32_t TexIndex = static_cast<uint32_t>(CRenderer::GetTexture(ETexture::Cloud)->GetSlot());
+		QuadInstances.clear();
 		for (const FCloud& Cloud : Clouds)
 		{
-			CRenderer::DrawQuad(Cloud.Position, Cloud.Size, Texture, FColor::White);
+			QuadInstances.emplace_back(Cloud.Position, Cloud.Size, 0.0f, FColor::White, TexIndex);
 		}
+		CRenderer::DrawQuads(QuadInstances);
 	}
 
 	void CTestLevel::OnWindowResized(const uint16_t InWidth, const uint16_t InHeight)
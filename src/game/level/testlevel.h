@@ -1,8 +1,12 @@
 #pragma once
 
+#include <unordered_set>
+
 #include "core/layer.h"
 #include "game/gameinstance.h"
+#include "renderer/staticbatch.h"
 #include "renderer/texture.h"
+#include "renderer/vertex.h"
 #include "scene/scene.h"
 
 namespace platformer2d::Level {
@@ -19,6 +23,7 @@ namespace platformer2d::Level {
 		virtual void OnAttach() override;
 		virtual void OnDetach() override;
 
+		virtual void FixedTick(float FixedDeltaTime) override;
 		virtual void Tick(float DeltaTime) override;
 		virtual CCamera* GetActiveCamera() const override;
 		virtual CPlayer* GetPlayer(std::size_t Idx = 0) const override;
@@ -37,7 +42,8 @@ namespace platformer2d::Level {
 		void CreatePlatform();
 		void CreateTerrain();
 
-		void Tick_Objects(float DeltaTime);
+		void Tick_Objects(float FixedDeltaTime);
+		void RebuildStaticBatch();
 
 		void UI_Level();
 		void UI_Player();
@@ -45,7 +51,7 @@ namespace platformer2d::Level {
 		void UI_TextureDropDown(std::size_t& SelectedIdx);
 
 		void DrawBackground() const;
-		void DrawClouds() const;
+		void DrawClouds();
 
 		void OnWindowResized(uint16_t InWidth, uint16_t InHeight);
 
@@ -56,6 +62,15 @@ namespace platformer2d::Level {
 		std::shared_ptr<CScene> Scene = nullptr;
 
 		std::vector<FSceneSelectionEntry> SelectionData;
+
+		/* Reused every tick for the bulk quad submissions. */
+		std::vector<FQuadInstance> QuadInstances;
+
+		/* Actors with static bodies, rebuilt only when an actor is added, deleted or modified. */
+		CStaticBatch StaticBatch;
+		std::unordered_set<LUUID> StaticBatchActors;
+		std::vector<std::weak_ptr<CActor>> DynamicActors;
+		bool bStaticBatchDirty = true;
 	};
 
 }
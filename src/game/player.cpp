@@ -114,23 +114,28 @@ namespace platformer2d {
 		LK_VERIFY(Body && Sprite);
 	}
 
+	void CPlayer::FixedTick(const float FixedDeltaTime)
+	{
+		/* Forces are applied once per physics step regardless of the frame rate. */
+		CheckCollisions();
+		UpdateMovementState();
+		HandleInput();
+	}
+
 	void CPlayer::Tick(const float DeltaTime)
 	{
 		CActor::Tick(DeltaTime);
 
-		CheckCollisions();
-		UpdateMovementState();
 		if (bShouldUpdateSprite)
 		{
 			UpdateSprite();
 		}
 
-		HandleInput();
 		SyncTransformComponent();
 
 		if (bCameraLock)
 		{
-			Camera->Target(Body->GetPosition(), DeltaTime);
+			Camera->Target(Body->GetInterpolatedPosition(), DeltaTime);
 		}
 		Camera->Update();
 	}
@@ -42,6 +42,7 @@ namespace platformer2d {
 		CPlayer(const CPlayer&) = default;
 		~CPlayer() = default;
 
+		virtual void FixedTick(float FixedDeltaTime) override;
 		virtual void Tick(float DeltaTime) override;
 		void Jump();
 
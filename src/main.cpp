@@ -8,11 +8,13 @@
 #include "core/assert.h"
 #include "core/window.h"
 #include "core/timer.h"
+#include "core/fixedtimestep.h"
 #include "core/input/keyboard.h"
 #include "core/input/mouse.h"
 #include "game/player.h"
 #include "renderer/renderer.h"
 #include "renderer/texture.h"
+#include "renderer/ui/ui.h"
 #include "physics/physicsworld.h"
 
 using namespace platformer2d;
@@ -74,17 +76,27 @@ int main(int Argc, char* Argv[])
 	constexpr float NEAR_PLANE = -1.0f;
 	std::shared_ptr<CCamera> Camera = std::make_shared<CCamera>(SCREEN_WIDTH, SCREEN_HEIGHT, NEAR_PLANE, FAR_PLANE);
 
+	CFixedTimestep FixedTimestep;
+
 	Timer.Reset();
 	bool bRunning = true;
 	while (bRunning)
 	{
 		const float DeltaTime = Timer.GetDeltaTime();
+		const uint16_t Steps = FixedTimestep.Advance(DeltaTime);
 
 		Window.BeginFrame();
 		CKeyboard::Update();
 		CRenderer::BeginFrame();
 
-		CPhysicsWorld::Update(DeltaTime);
+		for (uint16_t Step = 0; Step < Steps; Step++)
+		{
+			Player->FixedTick(FixedTimestep.GetStepTime());
+			Platform->FixedTick(FixedTimestep.GetStepTime());
+			CPhysicsWorld::Update(FixedTimestep.GetStepTime());
+		}
+		CPhysicsWorld::SetInterpolationAlpha(FixedTimestep.GetAlpha());
+		CPhysicsWorld::DrawDebug();
 
 		Camera->SetViewportSize(WindowData.Width, WindowData.Height);
 		CRenderer::BeginScene(*Camera);
@@ -107,6 +119,15 @@ int main(int Argc, char* Argv[])
 		ImGui::Text("Player TC: (%.2f, %.2f)", PlayerBodyPos.x, PlayerBodyPos.y);
 		ImGui::End();
 
+		if (bShowDrawStats)
+		{
+			if (ImGui::Begin("Draw Statistics", &bShowDrawStats))
+			{
+				UI::DrawStatistics();
+			}
+			ImGui::End();
+		}
+
 		CRenderer::Flush();
 		CRenderer::EndFrame();
 		CKeyboard::TransitionPressedKeys();
@@ -62,10 +62,15 @@ namespace platformer2d {
 		}
 
 		SetMass(1.0f); /* @todo: Use body spec */
+
+		StepTransform = b2Body_GetTransform(ID);
+		PreviousTransform = StepTransform;
+		CPhysicsWorld::AddBody(*this);
 	}
 
 	CBody::~CBody()
 	{
+		CPhysicsWorld::RemoveBody(*this);
 		if (b2Body_IsValid(ID))
 		{
 			LK_TRACE_TAG("Body", "Destroy: {}", ID.index1);
@@ -92,18 +97,21 @@ namespace platformer2d {
 	void CBody::SetPosition(const glm::vec2& Pos) const
 	{
 		b2Body_SetTransform(ID, Math::Convert(Pos), b2Body_GetRotation(ID));
+		SnapStepTransform();
 	}
 
 	void CBody::SetPositionX(const float X) const
 	{
 		const b2Vec2 Pos = b2Body_GetPosition(ID);
 		b2Body_SetTransform(ID, b2Vec2(X, Pos.y), b2Body_GetRotation(ID));
+		SnapStepTransform();
 	}
 
 	void CBody::SetPositionY(const float Y) const
 	{
 		const b2Vec2 Pos = b2Body_GetPosition(ID);
 		b2Body_SetTransform(ID, b2Vec2(Pos.x, Y), b2Body_GetRotation(ID));
+		SnapStepTransform();
 	}
 
 	float CBody::GetRotation() const
@@ -115,6 +123,39 @@ namespace platformer2d {
 	{
 		const b2Transform Transform = b2Body_GetTransform(ID);
 		b2Body_SetTransform(ID, Transform.p, b2MakeRot(AngleRad));
+		SnapStepTransform();
+	}
+
+	void CBody::RotateTo(const float AngleRad) const
+	{
+		const b2Transform Transform = b2Body_GetTransform(ID);
+		b2Body_SetTransform(ID, Transform.p, b2MakeRot(AngleRad));
+	}
+
+	glm::vec2 CBody::GetInterpolatedPosition() const
+	{
+		const b2Vec2 Pos = b2Lerp(PreviousTransform.p, StepTransform.p, CPhysicsWorld::GetInterpolationAlpha());
+		return glm::vec2(Pos.x, Pos.y);
+	}
+
+	float CBody::GetInterpolatedRotation() const
+	{
+		return b2Rot_GetAngle(b2NLerp(PreviousTransform.q, StepTransform.q, CPhysicsWorld::GetInterpolationAlpha()));
+	}
+
+	void CBody::StoreStepTransform()
+	{
+		if (b2Body_IsValid(ID))
+		{
+			PreviousTransform = StepTransform;
+			StepTransform = b2Body_GetTransform(ID);
+		}
+	}
+
+	void CBody::SnapStepTransform() const
+	{
+		StepTransform = b2Body_GetTransform(ID);
+		PreviousTransform = StepTransform;
 	}
 
 	glm::vec2 CBody::GetLinearVelocity() const
@@ -63,6 +63,8 @@ namespace platformer2d {
 		inline const b2BodyId& GetID() const { return ID; }
 		inline const b2ShapeId& GetShapeID() const { return ShapeID; }
 
+		inline EBodyType GetType() const { return BodySpec.Type; }
+
 		inline bool IsDirty() const { return bDirty; }
 		void SetDirty(bool Dirty);
 
@@ -73,6 +75,20 @@ namespace platformer2d {
 
 		float GetRotation() const;
 		void SetRotation(float AngleRad) const;
+
+		/**
+		 * @brief Rotate without teleporting, the rendered rotation is interpolated to the new one over the next step.
+		 * For bodies moved by hand every step, the setters above place the body without interpolation.
+		 */
+		void RotateTo(float AngleRad) const;
+
+		/**
+		 * @brief Transform between the last two physics steps, used for rendering.
+		 * @see CPhysicsWorld::SetInterpolationAlpha
+		 */
+		glm::vec2 GetInterpolatedPosition() const;
+		float GetInterpolatedRotation() const;
+
 		glm::vec2 GetLinearVelocity() const;
 		void SetLinearVelocity(const glm::vec2& InVelocity) const;
 		float GetAngularVelocity() const;
@@ -129,6 +145,9 @@ namespace platformer2d {
 		void ScaleLine(const glm::vec2& Factor) const;
 		void ScaleCapsule(const glm::vec2& Factor) const;
 
+		void StoreStepTransform();
+		void SnapStepTransform() const;
+
 	private:
 		const FBodySpecification BodySpec;
 		b2BodyId ID;
@@ -140,6 +159,10 @@ namespace platformer2d {
 		bool bDirty = false;
 		float DeltaTime = 0.0f;
 
+		/* Snapped by the setters, a moved body is not interpolated from where it was. */
+		mutable b2Transform PreviousTransform = b2Transform_identity; /* Transform after the second to last step. */
+		mutable b2Transform StepTransform = b2Transform_identity;     /* Transform after the last step. */
+
 		friend class CPhysicsWorld;
 	};
 
@@ -1,5 +1,7 @@
 #include "physicsworld.h"
 
+#include <algorithm>
+
 #include "core/math/math.h"
 #include "game/player.h"
 
@@ -34,6 +36,15 @@ namespace platformer2d {
 			b2World_Step(WorldID, DeltaTime, Substep);
 		}
 
+		/* Also stored while paused so bodies moved by hand are not interpolated from a stale transform. */
+		for (CBody* Body : Bodies)
+		{
+			Body->StoreStepTransform();
+		}
+	}
+
+	void CPhysicsWorld::DrawDebug()
+	{
 		if (DebugDraw)
 		{
 			b2World_Draw(WorldID, DebugDraw.get());
@@ -52,6 +63,11 @@ namespace platformer2d {
 		bPaused = false;
 	}
 
+	bool CPhysicsWorld::IsPaused()
+	{
+		return bPaused;
+	}
+
 	b2BodyId CPhysicsWorld::CreateBody(const b2BodyDef& BodyDef)
 	{
 		LK_ASSERT(bInitialized);
@@ -64,6 +80,21 @@ namespace platformer2d {
 		b2DestroyBody(Body.ID);
 	}
 
+	void CPhysicsWorld::SetInterpolationAlpha(const float Alpha)
+	{
+		InterpolationAlpha = std::clamp(Alpha, 0.0f, 1.0f);
+	}
+
+	void CPhysicsWorld::AddBody(CBody& Body)
+	{
+		Bodies.push_back(&Body);
+	}
+
+	void CPhysicsWorld::RemoveBody(CBody& Body)
+	{
+		std::erase(Bodies, &Body);
+	}
+
 	glm::vec2 CPhysicsWorld::GetGravity()
 	{
 		return Math::Convert<glm::vec2>(b2World_GetGravity(WorldID));
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include <box2d/box2d.h>
 #include <glm/glm.hpp>
 
@@ -17,28 +19,46 @@ namespace platformer2d {
 		static void Initialize(const glm::vec2& Gravity = {0.0f, -10.0f});
 		static void Shutdown();
 
+		/**
+		 * @brief Step the world and keep the resulting body transforms for interpolation.
+		 */
 		static void Update(float DeltaTime);
+		static void DrawDebug();
 		static void Pause();
 		static void Unpause();
+		static bool IsPaused();
 
 		static inline const b2WorldId& GetID() { return WorldID; }
 
 		static b2BodyId CreateBody(const b2BodyDef& BodyDef);
 		static void Destroy(CBody& Body);
 
+		/**
+		 * @brief Set how far rendering is between the last two steps, see CBody::GetInterpolatedPosition.
+		 */
+		static void SetInterpolationAlpha(float Alpha);
+		static inline float GetInterpolationAlpha() { return InterpolationAlpha; }
+
 		static glm::vec2 GetGravity();
 		static void SetGravity(const glm::vec2& Gravity);
 
 		static void InitDebugDraw(b2DebugDraw& DebugDrawRef);
 
 	private:
+		static void AddBody(CBody& Body);
+		static void RemoveBody(CBody& Body);
+
 		bool PreSolve(b2ShapeId ShapeA, b2ShapeId ShapeB, b2Vec2 Point, b2Vec2 Normal, void* Ctx);
 
 	private:
 		static inline b2WorldId WorldID;
 		static inline int Substep = 4;
+		static inline float InterpolationAlpha = 1.0f;
+		static inline std::vector<CBody*> Bodies;
 
 		static inline std::unique_ptr<b2DebugDraw> DebugDraw = nullptr;
+
+		friend class CBody;
 	};
 
 }
\ No newline at end of file
@@ -1,17 +1,43 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <vector>
 
 namespace platformer2d {
 
+	enum class ERenderBackend : uint8_t
+	{
+		OpenGL, /* Driver functions loaded from the current context. */
+		Null,   /* Every GL call is emulated on the CPU, no context needed. */
+	};
+
+	namespace Enum
+	{
+		inline constexpr const char* ToString(const ERenderBackend Backend)
+		{
+			switch (Backend)
+			{
+				case ERenderBackend::OpenGL: return "OpenGL";
+				case ERenderBackend::Null:   return "Null";
+				default: break;
+			}
+			return nullptr;
+		}
+	}
+
 	struct FBackendInfo
 	{
+		ERenderBackend Backend = ERenderBackend::OpenGL;
 		struct {
 			int Major;
 			int Minor;
 		} Version;
+		std::string Vendor{};
+		std::string Renderer{};
+		std::string VersionString{};
 		std::vector<std::string> Extensions;
+		int ProgramBinaryFormats = 0; /* Zero if program binaries cannot be retrieved. */
 	};
 
 }
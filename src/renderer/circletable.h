@@ -0,0 +1,90 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <numbers>
+
+#include "core/core.h"
+
+namespace platformer2d::CircleTable {
+
+	struct FPoint
+	{
+		float X = 0.0f;
+		float Y = 0.0f;
+	};
+
+	constexpr int MAX_SEGMENTS = 128;
+	constexpr int MIN_SEGMENTS = 4;
+
+	/**
+	 * @brief Target length of an outline segment on screen, in pixels.
+	 */
+	constexpr float SEGMENT_LENGTH = 6.0f;
+
+	namespace _Internal
+	{
+		/* Taylor series, accurate to double precision for |X| <= pi. */
+		constexpr double Sin(const double X)
+		{
+			double Term = X;
+			double Sum = X;
+			for (int N = 1; N < 16; N++)
+			{
+				Term *= -(X * X) / static_cast<double>((2 * N) * (2 * N + 1));
+				Sum += Term;
+			}
+			return Sum;
+		}
+
+		constexpr double Cos(const double X)
+		{
+			double Term = 1.0;
+			double Sum = 1.0;
+			for (int N = 1; N < 16; N++)
+			{
+				Term *= -(X * X) / static_cast<double>((2 * N - 1) * (2 * N));
+				Sum += Term;
+			}
+			return Sum;
+		}
+
+		constexpr std::array<FPoint, MAX_SEGMENTS> CreatePoints()
+		{
+			std::array<FPoint, MAX_SEGMENTS> Points{};
+			for (int Idx = 0; Idx < MAX_SEGMENTS; Idx++)
+			{
+				double Angle = (2.0 * std::numbers::pi * Idx) / MAX_SEGMENTS;
+				if (Angle > std::numbers::pi)
+				{
+					Angle -= 2.0 * std::numbers::pi;
+				}
+				Points[Idx] = { static_cast<float>(Cos(Angle)), static_cast<float>(Sin(Angle)) };
+			}
+			return Points;
+		}
+	}
+
+	/**
+	 * @brief Points on the unit circle, counter-clockwise from (1, 0).
+	 * A circle with N segments, N being a power of two, uses every (MAX_SEGMENTS / N)th point.
+	 */
+	constexpr std::array<FPoint, MAX_SEGMENTS> Points = _Internal::CreatePoints();
+	static_assert(Points[0].X == 1.0f && Points[0].Y == 0.0f);
+	static_assert((Points[MAX_SEGMENTS / 4].Y > 0.999999f) && (Points[MAX_SEGMENTS / 2].X < -0.999999f));
+
+	/**
+	 * @brief Segment count for a circle of the given radius on screen.
+	 * @return Power of two within [MinSegments, MaxSegments].
+	 */
+	constexpr int GetSegmentCount(const float RadiusPixels, const int MinSegments, const int MaxSegments)
+	{
+		const float Circumference = 2.0f * std::numbers::pi_v<float> * RadiusPixels;
+		const int Segments = static_cast<int>(std::min(Circumference / SEGMENT_LENGTH, static_cast<float>(MAX_SEGMENTS)));
+		return std::clamp(static_cast<int>(std::bit_ceil(static_cast<unsigned int>(std::max(Segments, 1)))), MinSegments, MaxSegments);
+	}
+	static_assert(GetSegmentCount(0.0f, 8, 64) == 8);
+	static_assert(GetSegmentCount(1e6f, 8, 64) == 64);
+
+}
@@ -0,0 +1,118 @@
+#include "cookedtexture.h"
+
+#include <system_error>
+
+#include "core/hash.h"
+
+namespace platformer2d {
+
+	namespace CookedTexture
+	{
+		uint64_t Hash(const std::span<const std::byte> Data)
+		{
+			return platformer2d::Hash::FNV1a(Data);
+		}
+
+		std::size_t GetMipSize(const ECookedTextureFormat Format, const uint32_t Width, const uint32_t Height)
+		{
+			const std::size_t BlocksX = (static_cast<std::size_t>(Width) + 3) / 4;
+			const std::size_t BlocksY = (static_cast<std::size_t>(Height) + 3) / 4;
+			switch (Format)
+			{
+				case ECookedTextureFormat::RGBA8: return static_cast<std::size_t>(Width) * Height * 4;
+				case ECookedTextureFormat::BC1:   return BlocksX * BlocksY * 8;
+				case ECookedTextureFormat::BC3:   return BlocksX * BlocksY * 16;
+			}
+
+			LK_VERIFY(false, "Invalid cooked texture format: {}", static_cast<int>(Format));
+			return 0;
+		}
+
+		std::filesystem::path GetPath(const std::filesystem::path& SourcePath)
+		{
+			/* The source extension is kept, bricks.png and bricks.jpg are cooked separately. */
+			return std::filesystem::path(COOKED_TEXTURES_DIR) / (SourcePath.filename().string() + EXTENSION);
+		}
+
+		bool IsAvailable(const std::filesystem::path& SourcePath)
+		{
+			const std::filesystem::path CookedPath = GetPath(SourcePath);
+			std::error_code Error;
+			const auto CookedTime = std::filesystem::last_write_time(CookedPath, Error);
+			if (Error)
+			{
+				return false;
+			}
+
+			/* The content hash is only compared by the cooker, comparing times is enough to not load a stale file. */
+			const auto SourceTime = std::filesystem::last_write_time(SourcePath, Error);
+			return (Error || (SourceTime <= CookedTime));
+		}
+	}
+
+	bool CCookedTexture::Open(const std::filesystem::path& Path)
+	{
+		Header = nullptr;
+		Mips = {};
+		if (!File.Open(Path))
+		{
+			return false;
+		}
+
+		const std::size_t FileSize = File.GetSize();
+		if (FileSize < sizeof(FCookedTextureHeader))
+		{
+			LK_ERROR_TAG("CookedTexture", "{} is truncated", Path.filename());
+			File.Close();
+			return false;
+		}
+
+		/* Mappings are page aligned, the header and the mip table are read in place. */
+		const FCookedTextureHeader* FileHeader = reinterpret_cast<const FCookedTextureHeader*>(File.GetData());
+		if (FileHeader->Magic != CookedTexture::MAGIC)
+		{
+			LK_ERROR_TAG("CookedTexture", "{} is not a cooked texture", Path.filename());
+			File.Close();
+			return false;
+		}
+		if (FileHeader->Version != CookedTexture::VERSION)
+		{
+			LK_WARN_TAG("CookedTexture", "{} has version {}, expected {}", Path.filename(), FileHeader->Version, CookedTexture::VERSION);
+			File.Close();
+			return false;
+		}
+
+		const std::size_t TableEnd = sizeof(FCookedTextureHeader) + (FileHeader->MipCount * sizeof(FCookedTextureMip));
+		if ((FileHeader->MipCount == 0) || (TableEnd > FileSize))
+		{
+			LK_ERROR_TAG("CookedTexture", "{} has an invalid mip table", Path.filename());
+			File.Close();
+			return false;
+		}
+
+		const FCookedTextureMip* MipTable = reinterpret_cast<const FCookedTextureMip*>(File.GetData() + sizeof(FCookedTextureHeader));
+		for (uint32_t Level = 0; Level < FileHeader->MipCount; Level++)
+		{
+			const FCookedTextureMip& Mip = MipTable[Level];
+			if (((Mip.Offset + Mip.Size) > FileSize)
+				|| (Mip.Size != CookedTexture::GetMipSize(FileHeader->Format, Mip.Width, Mip.Height)))
+			{
+				LK_ERROR_TAG("CookedTexture", "{} mip {} is out of bounds", Path.filename(), Level);
+				File.Close();
+				return false;
+			}
+		}
+
+		Header = FileHeader;
+		Mips = { MipTable, FileHeader->MipCount };
+		return true;
+	}
+
+	std::span<const std::byte> CCookedTexture::GetMipData(const uint32_t Level) const
+	{
+		LK_ASSERT(IsOpen() && (Level < Mips.size()), "Invalid mip level: {}", Level);
+		const FCookedTextureMip& Mip = Mips[Level];
+		return File.GetSpan().subspan(Mip.Offset, Mip.Size);
+	}
+
+}
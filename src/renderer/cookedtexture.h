@@ -0,0 +1,134 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+
+#include "core/core.h"
+#include "core/mappedfile.h"
+
+namespace platformer2d {
+
+	/**
+	 * @brief Pixel data of a cooked texture.
+	 */
+	enum class ECookedTextureFormat : uint16_t
+	{
+		RGBA8 = 0,
+		BC1,       /* 8 bytes per 4x4 block, opaque. */
+		BC3,       /* 16 bytes per 4x4 block, interpolated alpha. */
+	};
+
+	enum ECookedTextureFlags : uint32_t
+	{
+		CookedTexture_None          = 0,
+		CookedTexture_Translucent   = 1 << 0, /* Any texel with alpha below 1. */
+		CookedTexture_FlipVertical  = 1 << 1, /* Rows stored bottom to top. */
+	};
+
+	/**
+	 * @brief File header of a cooked texture (.lktex).
+	 *
+	 * The header is followed by one FCookedTextureMip per mip level and the pixel
+	 * data of every level, each starting on a COOKED_TEXTURE_ALIGNMENT boundary.
+	 * All values are little-endian.
+	 */
+	struct FCookedTextureHeader
+	{
+		uint32_t Magic = 0;
+		uint16_t Version = 0;
+		ECookedTextureFormat Format = ECookedTextureFormat::RGBA8;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t MipCount = 0;
+		uint32_t Flags = CookedTexture_None;
+		uint64_t SourceHash = 0; /* Hash of the source image file, see CookedTexture::Hash. */
+	};
+	static_assert(sizeof(FCookedTextureHeader) == 32);
+
+	struct FCookedTextureMip
+	{
+		uint64_t Offset = 0; /* From the start of the file. */
+		uint64_t Size = 0;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+	};
+	static_assert(sizeof(FCookedTextureMip) == 24);
+
+	namespace CookedTexture
+	{
+		static constexpr uint32_t MAGIC = 0x58544B4C; /* 'LKTX' */
+		static constexpr uint16_t VERSION = 1;
+		static constexpr std::size_t ALIGNMENT = 16;
+		static constexpr const char* EXTENSION = ".lktex";
+
+		/**
+		 * @brief FNV-1a hash of the source file content.
+		 */
+		uint64_t Hash(std::span<const std::byte> Data);
+
+		/**
+		 * @brief Bytes taken by a mip level of the given size.
+		 */
+		std::size_t GetMipSize(ECookedTextureFormat Format, uint32_t Width, uint32_t Height);
+
+		/**
+		 * @brief Location of the cooked version of a source texture.
+		 */
+		std::filesystem::path GetPath(const std::filesystem::path& SourcePath);
+
+		/**
+		 * @brief Whether a cooked file exists for the source and is not older than it.
+		 */
+		bool IsAvailable(const std::filesystem::path& SourcePath);
+	}
+
+	/**
+	 * @brief Memory mapped cooked texture.
+	 *
+	 * The mip levels point straight into the mapping and are valid until the
+	 * texture is closed, nothing is decoded or copied on load.
+	 */
+	class CCookedTexture
+	{
+	public:
+		CCookedTexture() = default;
+		~CCookedTexture() = default;
+
+		/**
+		 * @brief Map and validate a cooked texture.
+		 * @return false if the file is missing, truncated or of another version.
+		 */
+		bool Open(const std::filesystem::path& Path);
+
+		FORCEINLINE bool IsOpen() const { return File.IsOpen(); }
+		FORCEINLINE const FCookedTextureHeader& GetHeader() const { return *Header; }
+		FORCEINLINE bool HasFlag(const ECookedTextureFlags Flag) const { return (Header->Flags & Flag) != 0; }
+		FORCEINLINE std::span<const FCookedTextureMip> GetMips() const { return Mips; }
+
+		/**
+		 * @brief Pixel data of a mip level.
+		 */
+		std::span<const std::byte> GetMipData(uint32_t Level) const;
+
+	private:
+		CMappedFile File;
+		const FCookedTextureHeader* Header = nullptr;
+		std::span<const FCookedTextureMip> Mips{};
+	};
+
+	namespace Enum
+	{
+		inline constexpr const char* ToString(const ECookedTextureFormat Format)
+		{
+			switch (Format)
+			{
+				case ECookedTextureFormat::RGBA8: return "RGBA8";
+				case ECookedTextureFormat::BC1:   return "BC1";
+				case ECookedTextureFormat::BC3:   return "BC3";
+				default: break;
+			}
+			return nullptr;
+		}
+	}
+
+}
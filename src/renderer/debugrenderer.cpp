@@ -1,5 +1,7 @@
 #include "debugrenderer.h"
 
+#include <array>
+
 #include <box2d/box2d.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -35,8 +37,8 @@ namespace platformer2d {
 			LK_OpenGL_Verify(glGenVertexArrays(1, &QuadVAO));
 			LK_OpenGL_Verify(glGenBuffers(1, &QuadVBO));
 
-			LK_OpenGL_Verify(glBindVertexArray(QuadVAO));
-			LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, QuadVBO));
+			OpenGL::State::BindVertexArray(QuadVAO);
+			OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, QuadVBO);
 			LK_OpenGL_Verify(glBufferData(GL_ARRAY_BUFFER, 4 * sizeof(glm::vec2), nullptr, GL_DYNAMIC_DRAW));
 			LK_OpenGL_Verify(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr));
 			LK_OpenGL_Verify(glEnableVertexAttribArray(0));
@@ -46,12 +48,14 @@ namespace platformer2d {
 				2, 3, 0  /* Triangle 2 */
 			};
 			LK_OpenGL_Verify(glGenBuffers(1, &QuadEBO));
-			LK_OpenGL_Verify(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadEBO));
+			OpenGL::State::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadEBO);
 			LK_OpenGL_Verify(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(QuadIndices), QuadIndices, GL_STATIC_DRAW));
 
 			QuadShader = std::make_shared<CShader>(SHADERS_DIR "/debug_quad.shader");
-			QuadShader->Set("u_viewproj", ViewProjection);
-			QuadShader->Set("u_color", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+			QuadUniforms.ViewProjection = QuadShader->GetUniform("u_viewproj");
+			QuadUniforms.Color = QuadShader->GetUniform("u_color");
+			QuadShader->Set(QuadUniforms.ViewProjection, ViewProjection);
+			QuadShader->Set(QuadUniforms.Color, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 		}
 
 		/* Line */
@@ -59,23 +63,25 @@ namespace platformer2d {
 			LK_OpenGL_Verify(glGenVertexArrays(1, &LineVAO));
 			LK_OpenGL_Verify(glGenBuffers(1, &LineVBO));
 
-			LK_OpenGL_Verify(glBindVertexArray(LineVAO));
-			LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, LineVBO));
+			OpenGL::State::BindVertexArray(LineVAO);
+			OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, LineVBO);
 			LK_OpenGL_Verify(glBufferData(GL_ARRAY_BUFFER, 2 * sizeof(glm::vec2), nullptr, GL_DYNAMIC_DRAW)); 
 			LK_OpenGL_Verify(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr));
 			LK_OpenGL_Verify(glEnableVertexAttribArray(0));
 
 			LineShader = std::make_shared<CShader>(SHADERS_DIR "/debug_line.shader");
-			LineShader->Set("u_viewproj", ViewProjection);
-			LineShader->Set("u_color", glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+			LineUniforms.ViewProjection = LineShader->GetUniform("u_viewproj");
+			LineUniforms.Color = LineShader->GetUniform("u_color");
+			LineShader->Set(LineUniforms.ViewProjection, ViewProjection);
+			LineShader->Set(LineUniforms.Color, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 		}
 
 		/* Circle */
 		{
 			LK_OpenGL_Verify(glGenVertexArrays(1, &CircleVAO));
 			LK_OpenGL_Verify(glGenBuffers(1, &CircleVBO));
-			LK_OpenGL_Verify(glBindVertexArray(CircleVAO));
-			LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, CircleVBO));
+			OpenGL::State::BindVertexArray(CircleVAO);
+			OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, CircleVBO);
 
 			LK_OpenGL_Verify(glBufferData(GL_ARRAY_BUFFER, 4 * 2 * sizeof(glm::vec2), nullptr, GL_DYNAMIC_DRAW));
 			LK_OpenGL_Verify(glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), nullptr));
@@ -182,23 +188,27 @@ namespace platformer2d {
             * glm::rotate(glm::mat4(1.0f), glm::radians(RotationDeg), glm::vec3(0.0f, 0.0f, 1.0f))
             * glm::scale(glm::mat4(1.0f), { Size.x, Size.y, 1.0f });
 
-		glm::vec2 Vertices[4] = {};
+		std::array<glm::vec2, 4> Vertices = {};
 		for (std::size_t Idx = 0; Idx < 4; Idx++)
 		{
 			Vertices[Idx] = Transform * QuadVertexPositions[Idx];
 		}
 
-		QuadShader->Bind();
-		QuadShader->Set("u_viewproj", ViewProjection);
-		QuadShader->Set("u_color", Color);
-		LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, QuadVBO));
-		LK_OpenGL_Verify(glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertices), Vertices));
-
-		LK_OpenGL_Verify(glBindVertexArray(QuadVAO));
-		LK_OpenGL_Verify(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr));
-
-		LK_OpenGL_Verify(glBindVertexArray(0));
-		QuadShader->Unbind();
+		/* Drawn with the debug pipeline where the context is current, in order with the rest of the frame. */
+		CRenderer::SubmitCommand([Vertices, Color, ViewProjection = ViewProjection]()
+		{
+			QuadShader->Bind();
+			QuadShader->Set(QuadUniforms.ViewProjection, ViewProjection);
+			QuadShader->Set(QuadUniforms.Color, Color);
+			OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, QuadVBO);
+			LK_OpenGL_Verify(glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertices), Vertices.data()));
+
+			OpenGL::State::BindVertexArray(QuadVAO);
+			LK_OpenGL_Verify(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, nullptr));
+
+			OpenGL::State::BindVertexArray(0);
+			QuadShader->Unbind();
+		});
 	}
 
 	void CDebugRenderer::DrawLine(const glm::vec2& P0, const glm::vec2& P1, const glm::vec4& Color, const uint16_t LineWidth)
@@ -208,16 +218,19 @@ namespace platformer2d {
 
 	void CDebugRenderer::DrawLine(const glm::vec3& P0, const glm::vec3& P1, const glm::vec4& Color, const uint16_t LineWidth)
 	{
-		LineShader->Set("u_viewproj", ViewProjection);
-		LineShader->Set("u_color", Color);
+		const std::array<glm::vec2, 2> Vertices = { glm::vec2(P0.x, P0.y), glm::vec2(P1.x, P1.y) };
+		CRenderer::SubmitCommand([Vertices, Color, LineWidth, ViewProjection = ViewProjection]()
+		{
+			LineShader->Set(LineUniforms.ViewProjection, ViewProjection);
+			LineShader->Set(LineUniforms.Color, Color);
 
-		const float Vertices[2][2] = { { P0.x, P0.y }, { P1.x, P1.y } };
-		LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, LineVBO));
-		LK_OpenGL_Verify(glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertices), Vertices));
+			OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, LineVBO);
+			LK_OpenGL_Verify(glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Vertices), Vertices.data()));
 
-		LK_OpenGL_Verify(glBindVertexArray(LineVAO));
-		LK_OpenGL_Verify(glLineWidth(LineWidth));
-		LK_OpenGL_Verify(glDrawArrays(GL_LINES, 0, 2));
+			OpenGL::State::BindVertexArray(LineVAO);
+			LK_OpenGL_Verify(glLineWidth(LineWidth));
+			LK_OpenGL_Verify(glDrawArrays(GL_LINES, 0, 2));
+		});
 	}
 
 	void CDebugRenderer::DrawCapsule(const glm::vec2& P0, const glm::vec2& P1, const float Radius, const glm::vec4& Color)
@@ -252,18 +265,20 @@ namespace platformer2d {
 		const glm::vec2 V2 = Transform * (glm::vec4(P1.x, P1.y, P1.z, 0.0f) - Offset);
 		const glm::vec2 V3 = Transform * (glm::vec4(P0.x, P0.y, P0.z, 0.0f) - Offset);
 
-		const glm::vec2 Quad[4] = { V0, V1, V2, V3 };
-
-		LK_OpenGL_Verify(glBindVertexArray(QuadVAO));
-		LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, QuadVBO));
-		LK_OpenGL_Verify(glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Quad), Quad));
-
-		QuadShader->Bind();
-		QuadShader->Set("u_color", Color);
-		QuadShader->Set("u_viewproj", glm::mat4(1.0f));
-		LK_OpenGL_Verify(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadEBO));
-		LK_OpenGL_Verify(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0));
-		QuadShader->Unbind();
+		const std::array<glm::vec2, 4> Quad = { V0, V1, V2, V3 };
+		CRenderer::SubmitCommand([Quad, Color]()
+		{
+			OpenGL::State::BindVertexArray(QuadVAO);
+			OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, QuadVBO);
+			LK_OpenGL_Verify(glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(Quad), Quad.data()));
+
+			QuadShader->Bind();
+			QuadShader->Set(QuadUniforms.Color, Color);
+			QuadShader->Set(QuadUniforms.ViewProjection, glm::mat4(1.0f));
+			OpenGL::State::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadEBO);
+			LK_OpenGL_Verify(glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0));
+			QuadShader->Unbind();
+		});
 	}
 
 	void CDebugRenderer::DrawRayHit(const FRayCast& RayCast, const float T, const uint16_t LineWidth, const glm::vec4& LineColor,
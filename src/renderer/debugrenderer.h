@@ -40,14 +40,23 @@ namespace platformer2d {
 		CDebugRenderer& operator=(CDebugRenderer&&) = delete;
 
 	private:
+		/* Resolved once, the debug shaders are set on every draw. */
+		struct FDebugUniforms
+		{
+			FUniformHandle ViewProjection{};
+			FUniformHandle Color{};
+		};
+
 		static inline GLuint QuadVAO = 0;
 		static inline GLuint QuadVBO = 0;
 		static inline GLuint QuadEBO = 0;
 		static inline std::shared_ptr<CShader> QuadShader = nullptr;
+		static inline FDebugUniforms QuadUniforms{};
 
 		static inline GLuint LineVAO = 0;
 		static inline GLuint LineVBO = 0;
 		static inline std::shared_ptr<CShader> LineShader = nullptr;
+		static inline FDebugUniforms LineUniforms{};
 		struct FLineConfig {
 			uint16_t Width = 2;
 		} static inline LineConfig;
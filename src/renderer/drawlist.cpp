@@ -0,0 +1,152 @@
+#include "drawlist.h"
+
+namespace platformer2d {
+
+	namespace
+	{
+		constexpr int RADIX_BITS = 8;
+		constexpr int RADIX_BUCKETS = (1 << RADIX_BITS);
+		constexpr int RADIX_PASSES = (sizeof(uint64_t) * 8) / RADIX_BITS;
+	}
+
+	FQuadVertex* CDrawList::AddQuad(const uint64_t Key)
+	{
+		const uint32_t Index = static_cast<uint32_t>(QuadVertices.size() / 4);
+		QuadVertices.resize(QuadVertices.size() + 4);
+		Records.push_back({ Key, Index, CShader::EType::Quad });
+
+		return &QuadVertices[Index * 4];
+	}
+
+	FQuadInstance* CDrawList::AddQuadInstance(const uint64_t Key)
+	{
+		const uint32_t Index = static_cast<uint32_t>(QuadInstances.size());
+		QuadInstances.emplace_back();
+		Records.push_back({ Key, Index, CShader::EType::Quad });
+
+		return &QuadInstances[Index];
+	}
+
+	FLineVertex* CDrawList::AddLine(const uint64_t Key)
+	{
+		const uint32_t Index = static_cast<uint32_t>(LineVertices.size() / 2);
+		LineVertices.resize(LineVertices.size() + 2);
+		Records.push_back({ Key, Index, CShader::EType::Line });
+
+		return &LineVertices[Index * 2];
+	}
+
+	FCircleVertex* CDrawList::AddCircle(const uint64_t Key)
+	{
+		const uint32_t Index = static_cast<uint32_t>(CircleVertices.size() / 4);
+		CircleVertices.resize(CircleVertices.size() + 4);
+		Records.push_back({ Key, Index, CShader::EType::Circle });
+
+		return &CircleVertices[Index * 4];
+	}
+
+	void CDrawList::Sort()
+	{
+		const std::size_t Count = Records.size();
+		if (Count < 2)
+		{
+			return;
+		}
+
+		/* Build the histograms for every pass in a single read. */
+		uint32_t Histograms[RADIX_PASSES][RADIX_BUCKETS] = {};
+		for (const FDrawRecord& Record : Records)
+		{
+			for (int Pass = 0; Pass < RADIX_PASSES; Pass++)
+			{
+				Histograms[Pass][(Record.Key >> (Pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)]++;
+			}
+		}
+
+		SortBuffer.resize(Count);
+		FDrawRecord* Source = Records.data();
+		FDrawRecord* Destination = SortBuffer.data();
+
+		for (int Pass = 0; Pass < RADIX_PASSES; Pass++)
+		{
+			const int Shift = Pass * RADIX_BITS;
+			uint32_t* Histogram = Histograms[Pass];
+
+			/* Skip the pass if every key shares the same digit, e.g. the reserved bits. */
+			const uint64_t FirstDigit = (Source[0].Key >> Shift) & (RADIX_BUCKETS - 1);
+			if (Histogram[FirstDigit] == Count)
+			{
+				continue;
+			}
+
+			uint32_t Offset = 0;
+			for (int Bucket = 0; Bucket < RADIX_BUCKETS; Bucket++)
+			{
+				const uint32_t BucketCount = Histogram[Bucket];
+				Histogram[Bucket] = Offset;
+				Offset += BucketCount;
+			}
+
+			for (std::size_t Idx = 0; Idx < Count; Idx++)
+			{
+				const FDrawRecord& Record = Source[Idx];
+				Destination[Histogram[(Record.Key >> Shift) & (RADIX_BUCKETS - 1)]++] = Record;
+			}
+
+			std::swap(Source, Destination);
+		}
+
+		/* An odd number of passes leaves the sorted result in the sort buffer. */
+		if (Source != Records.data())
+		{
+			Records.swap(SortBuffer);
+		}
+	}
+
+	void CDrawList::Append(const CDrawList& Other)
+	{
+		/* A list holds either quad vertices or quad instances, depending on the quad render path. */
+		LK_ASSERT(QuadVertices.empty() || Other.QuadInstances.empty());
+		LK_ASSERT(QuadInstances.empty() || Other.QuadVertices.empty());
+		const uint32_t QuadBase = static_cast<uint32_t>(Other.QuadInstances.empty() ? (QuadVertices.size() / 4) : QuadInstances.size());
+		const uint32_t LineBase = static_cast<uint32_t>(LineVertices.size() / 2);
+		const uint32_t CircleBase = static_cast<uint32_t>(CircleVertices.size() / 4);
+
+		Records.reserve(Records.size() + Other.Records.size());
+		for (FDrawRecord Record : Other.Records)
+		{
+			switch (Record.Type)
+			{
+				case CShader::EType::Quad:   Record.Index += QuadBase;   break;
+				case CShader::EType::Line:   Record.Index += LineBase;   break;
+				case CShader::EType::Circle: Record.Index += CircleBase; break;
+			}
+			Records.push_back(Record);
+		}
+
+		QuadVertices.insert(QuadVertices.end(), Other.QuadVertices.begin(), Other.QuadVertices.end());
+		QuadInstances.insert(QuadInstances.end(), Other.QuadInstances.begin(), Other.QuadInstances.end());
+		LineVertices.insert(LineVertices.end(), Other.LineVertices.begin(), Other.LineVertices.end());
+		CircleVertices.insert(CircleVertices.end(), Other.CircleVertices.begin(), Other.CircleVertices.end());
+	}
+
+	void CDrawList::Clear()
+	{
+		Records.clear();
+		QuadVertices.clear();
+		QuadInstances.clear();
+		LineVertices.clear();
+		CircleVertices.clear();
+	}
+
+	void CDrawList::Swap(CDrawList& Other)
+	{
+		Records.swap(Other.Records);
+		SortBuffer.swap(Other.SortBuffer);
+		QuadVertices.swap(Other.QuadVertices);
+		QuadInstances.swap(Other.QuadInstances);
+		LineVertices.swap(Other.LineVertices);
+		CircleVertices.swap(Other.CircleVertices);
+	}
+
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <bit>
+#include <vector>
+
+#include "core/core.h"
+#include "shader.h"
+#include "vertex.h"
+
+namespace platformer2d {
+
+	/**
+	 * @brief Render layer, the most significant part of a sort key.
+	 * Layers are always drawn in order, regardless of depth.
+	 */
+	enum class ERenderLayer : uint8_t
+	{
+		Background,
+		World,
+		Effects,
+		Overlay,
+		COUNT
+	};
+
+	/**
+	 * @brief 64-bit draw sort key.
+	 *
+	 * Opaque:      [Layer:4][Translucent:1][Shader:3][Texture:8][Depth:32][Reserved:16]
+	 * Translucent: [Layer:4][Translucent:1][Depth:32][Shader:3][Texture:8][Reserved:16]
+	 *
+	 * Opaque draws are grouped by state and sorted front to back within a group,
+	 * translucent draws are sorted back to front so blending stays correct.
+	 */
+	namespace SortKey
+	{
+		/**
+		 * @brief Map a float to an unsigned integer that preserves ordering.
+		 */
+		constexpr uint32_t EncodeDepth(const float Depth)
+		{
+			const uint32_t Bits = std::bit_cast<uint32_t>(Depth);
+			return (Bits & 0x80000000u) ? ~Bits : (Bits | 0x80000000u);
+		}
+
+		constexpr uint64_t Create(const ERenderLayer Layer, const bool bTranslucent, const float Depth,
+								  const CShader::EType Shader, const uint8_t Texture)
+		{
+			const uint64_t L = static_cast<uint64_t>(Layer) & 0xF;
+			const uint64_t S = static_cast<uint64_t>(Shader) & 0x7;
+			const uint64_t T = static_cast<uint64_t>(Texture);
+			const uint64_t D = static_cast<uint64_t>(EncodeDepth(Depth));
+
+			if (bTranslucent)
+			{
+				/* Higher Z is closer to the camera, ascending depth is back to front. */
+				return (L << 60) | (1ull << 59) | (D << 27) | (S << 24) | (T << 16);
+			}
+
+			return (L << 60) | (S << 56) | (T << 48) | ((~D & 0xFFFFFFFFull) << 16);
+		}
+
+		constexpr bool IsTranslucent(const uint64_t Key)
+		{
+			return (Key >> 59) & 1;
+		}
+	}
+
+	struct FDrawRecord
+	{
+		uint64_t Key = 0;
+		uint32_t Index = 0; /* Primitive index in the vertex storage of its type. */
+		CShader::EType Type = CShader::EType::Quad;
+	};
+
+	/**
+	 * @brief Deferred draw submissions.
+	 *
+	 * Vertices are written once at submission and stay in place,
+	 * only the compact records are reordered when sorting.
+	 */
+	class CDrawList
+	{
+	public:
+		CDrawList() = default;
+		~CDrawList() = default;
+
+		FQuadVertex* AddQuad(uint64_t Key);
+		FQuadInstance* AddQuadInstance(uint64_t Key);
+		FLineVertex* AddLine(uint64_t Key);
+		FCircleVertex* AddCircle(uint64_t Key);
+
+		/**
+		 * @brief Stable LSD radix sort of the records by key.
+		 */
+		void Sort();
+		void Clear();
+
+		/**
+		 * @brief Exchange the content with another list, nothing is copied.
+		 */
+		void Swap(CDrawList& Other);
+
+		/**
+		 * @brief Append the records and vertices of another list after the current ones.
+		 */
+		void Append(const CDrawList& Other);
+
+		FORCEINLINE bool IsEmpty() const { return Records.empty(); }
+		FORCEINLINE std::size_t GetSize() const { return Records.size(); }
+		FORCEINLINE const std::vector<FDrawRecord>& GetRecords() const { return Records; }
+
+		FORCEINLINE const FQuadVertex* GetQuadVertices(const FDrawRecord& Record) const
+		{
+			return &QuadVertices[Record.Index * 4];
+		}
+
+		FORCEINLINE const FQuadInstance* GetQuadInstance(const FDrawRecord& Record) const
+		{
+			return &QuadInstances[Record.Index];
+		}
+
+		FORCEINLINE const FLineVertex* GetLineVertices(const FDrawRecord& Record) const
+		{
+			return &LineVertices[Record.Index * 2];
+		}
+
+		FORCEINLINE const FCircleVertex* GetCircleVertices(const FDrawRecord& Record) const
+		{
+			return &CircleVertices[Record.Index * 4];
+		}
+
+	private:
+		std::vector<FDrawRecord> Records;
+		std::vector<FDrawRecord> SortBuffer;
+
+		std::vector<FQuadVertex> QuadVertices;
+		std::vector<FQuadInstance> QuadInstances;
+		std::vector<FLineVertex> LineVertices;
+		std::vector<FCircleVertex> CircleVertices;
+	};
+
+}
@@ -0,0 +1,83 @@
+#include "drawrecorder.h"
+
+#include <algorithm>
+
+namespace platformer2d {
+
+	namespace
+	{
+		thread_local CDrawRecorder::FContext* ThreadContext = nullptr;
+	}
+
+	void CDrawRecorder::Begin(const uint32_t Order)
+	{
+		LK_ASSERT(ThreadContext == nullptr, "Thread is already recording");
+		std::scoped_lock Lock(Mutex);
+
+		auto Iter = std::ranges::find_if(Slots, [](const FSlot& Slot) { return Slot.State == EState::Free; });
+		if (Iter == Slots.end())
+		{
+			Iter = Slots.insert(Slots.end(), FSlot{ std::make_unique<FContext>() });
+		}
+
+		FContext& Context = *Iter->Context;
+		Context.RenderLayer = ERenderLayer::World;
+		Context.Counts = {};
+		Context.Order = Order;
+		Iter->State = EState::Recording;
+
+		ThreadContext = &Context;
+	}
+
+	void CDrawRecorder::End()
+	{
+		LK_ASSERT(ThreadContext != nullptr, "Thread is not recording");
+		std::scoped_lock Lock(Mutex);
+
+		auto Iter = std::ranges::find_if(Slots, [](const FSlot& Slot) { return Slot.Context.get() == ThreadContext; });
+		LK_ASSERT(Iter != Slots.end(), "Context not owned by this recorder");
+		Iter->State = EState::Finished;
+
+		ThreadContext = nullptr;
+	}
+
+	FRecordCounts CDrawRecorder::Merge(CDrawList& Target)
+	{
+		std::scoped_lock Lock(Mutex);
+
+		std::vector<FSlot*> Finished;
+		for (FSlot& Slot : Slots)
+		{
+			LK_ASSERT(Slot.State != EState::Recording, "Merge while a thread is recording");
+			if (Slot.State == EState::Finished)
+			{
+				Finished.push_back(&Slot);
+			}
+		}
+
+		std::ranges::stable_sort(Finished, {}, [](const FSlot* Slot) { return Slot->Context->Order; });
+
+		FRecordCounts Counts{};
+		for (FSlot* Slot : Finished)
+		{
+			FContext& Context = *Slot->Context;
+			Target.Append(Context.DrawList);
+			Counts.Quads += Context.Counts.Quads;
+			Counts.Lines += Context.Counts.Lines;
+			Counts.Circles += Context.Counts.Circles;
+			Counts.Submitted += Context.Counts.Submitted;
+			Counts.Culled += Context.Counts.Culled;
+
+			Context.DrawList.Clear();
+			Slot->State = EState::Free;
+		}
+
+		return Counts;
+	}
+
+	CDrawRecorder::FContext* CDrawRecorder::GetThreadContext()
+	{
+		return ThreadContext;
+	}
+
+}
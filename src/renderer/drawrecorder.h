@@ -0,0 +1,82 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+
+#include "core/core.h"
+#include "drawlist.h"
+
+namespace platformer2d {
+
+	struct FRecordCounts
+	{
+		uint64_t Quads = 0;
+		uint64_t Lines = 0;
+		uint64_t Circles = 0;
+		uint64_t Submitted = 0;
+		uint64_t Culled = 0;
+	};
+
+	/**
+	 * @brief Per-thread draw recording.
+	 *
+	 * A thread binds a context with Begin and every draw it submits is recorded
+	 * into that context instead of the shared batch, until End is called.
+	 * Finished contexts are merged in ascending order, so the result does not
+	 * depend on which thread finished first as long as every order is unique.
+	 */
+	class CDrawRecorder
+	{
+	public:
+		struct FContext
+		{
+			CDrawList DrawList;
+			ERenderLayer RenderLayer = ERenderLayer::World;
+			FRecordCounts Counts{};
+			uint32_t Order = 0;
+		};
+
+		CDrawRecorder() = default;
+		~CDrawRecorder() = default;
+
+		/**
+		 * @brief Bind a recording context to the calling thread.
+		 * @param Order Merge position of the context, should be unique per flush.
+		 */
+		void Begin(uint32_t Order);
+
+		/**
+		 * @brief Unbind the context of the calling thread and mark it for merging.
+		 */
+		void End();
+
+		/**
+		 * @brief Append every finished context to the target list.
+		 * Must not be called while a thread is still recording.
+		 */
+		FRecordCounts Merge(CDrawList& Target);
+
+		/**
+		 * @brief Context bound to the calling thread, nullptr if it is not recording.
+		 */
+		static FContext* GetThreadContext();
+
+	private:
+		enum class EState : uint8_t
+		{
+			Free,
+			Recording,
+			Finished,
+		};
+
+		struct FSlot
+		{
+			std::unique_ptr<FContext> Context;
+			EState State = EState::Free;
+		};
+
+		std::mutex Mutex;
+		std::vector<FSlot> Slots;
+	};
+
+}
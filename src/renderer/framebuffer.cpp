@@ -0,0 +1,87 @@
+#include "framebuffer.h"
+
+#include "opengl.h"
+
+namespace platformer2d {
+
+	CFramebuffer::CFramebuffer(const uint32_t InWidth, const uint32_t InHeight)
+		: Width(InWidth)
+		, Height(InHeight)
+	{
+		Invalidate();
+	}
+
+	CFramebuffer::~CFramebuffer()
+	{
+		Release();
+	}
+
+	void CFramebuffer::Bind() const
+	{
+		OpenGL::State::BindFramebuffer(ID);
+		LK_OpenGL_Verify(glViewport(0, 0, Width, Height));
+	}
+
+	void CFramebuffer::BindDefault(const uint32_t ViewportWidth, const uint32_t ViewportHeight)
+	{
+		OpenGL::State::BindFramebuffer(0);
+		LK_OpenGL_Verify(glViewport(0, 0, ViewportWidth, ViewportHeight));
+	}
+
+	bool CFramebuffer::Resize(const uint32_t InWidth, const uint32_t InHeight)
+	{
+		if ((InWidth == Width) && (InHeight == Height))
+		{
+			return false;
+		}
+
+		Width = InWidth;
+		Height = InHeight;
+		Invalidate();
+		return true;
+	}
+
+	void CFramebuffer::Clear(const glm::vec4& Color) const
+	{
+		LK_OpenGL_Verify(glClearNamedFramebufferfv(ID, GL_COLOR, 0, &Color.r));
+	}
+
+	void CFramebuffer::Invalidate()
+	{
+		LK_ASSERT((Width > 0) && (Height > 0), "Invalid framebuffer size: {}x{}", Width, Height);
+		Release();
+
+		LK_OpenGL_Verify(glCreateTextures(GL_TEXTURE_2D, 1, &ColorAttachment));
+		LK_OpenGL_Verify(glTextureStorage2D(ColorAttachment, 1, GL_RGBA8, Width, Height));
+		LK_OpenGL_Verify(glTextureParameteri(ColorAttachment, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
+		LK_OpenGL_Verify(glTextureParameteri(ColorAttachment, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
+		LK_OpenGL_Verify(glTextureParameteri(ColorAttachment, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+		LK_OpenGL_Verify(glTextureParameteri(ColorAttachment, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+		LK_OpenGL_Verify(glCreateFramebuffers(1, &ID));
+		LK_OpenGL_Verify(glNamedFramebufferTexture(ID, GL_COLOR_ATTACHMENT0, ColorAttachment, 0));
+
+		GLenum Status;
+		LK_OpenGL_Verify(Status = glCheckNamedFramebufferStatus(ID, GL_FRAMEBUFFER));
+		LK_VERIFY(Status == GL_FRAMEBUFFER_COMPLETE, "Framebuffer {} incomplete: {:#x}", ID, Status);
+		LK_TRACE_TAG("Framebuffer", "Created {} ({}x{})", ID, Width, Height);
+	}
+
+	void CFramebuffer::Release()
+	{
+		if (ID != 0)
+		{
+			OpenGL::State::ForgetFramebuffer(ID);
+			LK_OpenGL_Verify(glDeleteFramebuffers(1, &ID));
+			ID = 0;
+		}
+
+		if (ColorAttachment != 0)
+		{
+			OpenGL::State::ForgetTexture(ColorAttachment);
+			LK_OpenGL_Verify(glDeleteTextures(1, &ColorAttachment));
+			ColorAttachment = 0;
+		}
+	}
+
+}
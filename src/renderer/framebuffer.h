@@ -0,0 +1,59 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "core/core.h"
+
+namespace platformer2d {
+
+	/**
+	 * @brief Offscreen render target with a single RGBA8 color attachment.
+	 *
+	 * There is no depth attachment, draws into the framebuffer are ordered by submission.
+	 */
+	class CFramebuffer
+	{
+	public:
+		CFramebuffer(uint32_t InWidth, uint32_t InHeight);
+		CFramebuffer() = delete;
+		~CFramebuffer();
+
+		/**
+		 * @brief Bind the framebuffer and set the viewport to cover it.
+		 */
+		void Bind() const;
+
+		/**
+		 * @brief Bind the default framebuffer and set the viewport to the window.
+		 * The window size is passed in, the window may be resized by another thread.
+		 */
+		static void BindDefault(uint32_t ViewportWidth, uint32_t ViewportHeight);
+
+		/**
+		 * @brief Recreate the attachments if the size changed.
+		 * @return true if the framebuffer was recreated and its content is lost.
+		 */
+		bool Resize(uint32_t InWidth, uint32_t InHeight);
+
+		void Clear(const glm::vec4& Color) const;
+
+		LRendererID GetID() const { return ID; }
+		LRendererID GetColorAttachment() const { return ColorAttachment; }
+		uint32_t GetWidth() const { return Width; }
+		uint32_t GetHeight() const { return Height; }
+
+	private:
+		void Invalidate();
+		void Release();
+
+	private:
+		LRendererID ID = 0;
+		LRendererID ColorAttachment = 0;
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+
+		CFramebuffer(const CFramebuffer&) = delete;
+		CFramebuffer& operator=(const CFramebuffer&) = delete;
+	};
+
+}
@@ -0,0 +1,66 @@
+#include "gputimer.h"
+
+namespace platformer2d {
+
+	CGpuTimer::CGpuTimer(const uint8_t InFrameCount)
+	{
+		LK_ASSERT(InFrameCount > 0);
+		Frames.resize(InFrameCount);
+		for (FFrameQueries& Frame : Frames)
+		{
+			LK_OpenGL_Verify(glCreateQueries(GL_TIME_ELAPSED, PASS_COUNT, Frame.IDs.data()));
+		}
+	}
+
+	CGpuTimer::~CGpuTimer()
+	{
+		for (FFrameQueries& Frame : Frames)
+		{
+			LK_OpenGL_Verify(glDeleteQueries(PASS_COUNT, Frame.IDs.data()));
+		}
+	}
+
+	void CGpuTimer::Begin(const EGpuPass Pass)
+	{
+		LK_ASSERT(!bActive, "GPU pass {} started inside another pass", Enum::ToString(Pass));
+		FFrameQueries& Frame = Frames[FrameIndex];
+		const int Idx = static_cast<int>(Pass);
+		LK_OpenGL_Verify(glBeginQuery(GL_TIME_ELAPSED, Frame.IDs[Idx]));
+		Frame.bIssued[Idx] = true;
+		bActive = true;
+	}
+
+	void CGpuTimer::End(const EGpuPass Pass)
+	{
+		LK_ASSERT(bActive, "GPU pass {} ended without being started", Enum::ToString(Pass));
+		LK_OpenGL_Verify(glEndQuery(GL_TIME_ELAPSED));
+		bActive = false;
+	}
+
+	void CGpuTimer::EndFrame()
+	{
+		LK_ASSERT(!bActive, "Frame ended inside a GPU pass");
+		FrameIndex = (FrameIndex + 1) % Frames.size();
+
+		/* The queries of this frame are reused next, collect whatever the GPU has finished. */
+		FFrameQueries& Frame = Frames[FrameIndex];
+		for (int Idx = 0; Idx < PASS_COUNT; Idx++)
+		{
+			if (!Frame.bIssued[Idx])
+			{
+				continue;
+			}
+
+			GLint bAvailable = GL_FALSE;
+			LK_OpenGL_Verify(glGetQueryObjectiv(Frame.IDs[Idx], GL_QUERY_RESULT_AVAILABLE, &bAvailable));
+			if (bAvailable == GL_TRUE)
+			{
+				GLuint64 Nanoseconds = 0;
+				LK_OpenGL_Verify(glGetQueryObjectui64v(Frame.IDs[Idx], GL_QUERY_RESULT, &Nanoseconds));
+				Times[Idx] = static_cast<float>(static_cast<double>(Nanoseconds) / 1'000'000.0);
+			}
+			Frame.bIssued[Idx] = false;
+		}
+	}
+
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "core/core.h"
+#include "opengl.h"
+
+namespace platformer2d {
+
+	enum class EGpuPass : uint8_t
+	{
+		World, /* Scene geometry, from the start of the frame until the final flush. */
+		UI,    /* ImGui draw data. */
+		COUNT
+	};
+
+	namespace Enum
+	{
+		inline constexpr const char* ToString(const EGpuPass Pass)
+		{
+			switch (Pass)
+			{
+				case EGpuPass::World: return "World";
+				case EGpuPass::UI:    return "UI";
+				default: break;
+			}
+			return nullptr;
+		}
+	}
+
+	/**
+	 * @brief GPU time per render pass, measured with GL_TIME_ELAPSED queries.
+	 *
+	 * Every frame in flight has its own set of queries. A result is only read once
+	 * the GPU has made it available, which is normally the case when the frame comes
+	 * around again, so reading the timings never stalls the pipeline.
+	 * Passes cannot be nested.
+	 */
+	class CGpuTimer
+	{
+	public:
+		static constexpr int PASS_COUNT = static_cast<int>(EGpuPass::COUNT);
+
+		explicit CGpuTimer(uint8_t InFrameCount = 3);
+		~CGpuTimer();
+
+		void Begin(EGpuPass Pass);
+		void End(EGpuPass Pass);
+
+		/**
+		 * @brief Move on to the queries of the next frame, reading back their results if available.
+		 */
+		void EndFrame();
+
+		/**
+		 * @brief Most recent GPU time of a pass in milliseconds.
+		 * Lags behind the current frame by up to the number of frames in flight.
+		 */
+		FORCEINLINE float GetTime(const EGpuPass Pass) const { return Times[static_cast<int>(Pass)]; }
+
+	private:
+		struct FFrameQueries
+		{
+			std::array<GLuint, PASS_COUNT> IDs{};
+			std::array<bool, PASS_COUNT> bIssued{};
+		};
+
+		std::vector<FFrameQueries> Frames;
+		uint8_t FrameIndex = 0;
+		std::array<float, PASS_COUNT> Times{};
+		bool bActive = false;
+
+		CGpuTimer(const CGpuTimer&) = delete;
+		CGpuTimer& operator=(const CGpuTimer&) = delete;
+	};
+
+}
@@ -45,36 +45,90 @@ namespace platformer2d {
 			| ImGuiDockNodeFlags_NoDockingInCentralNode;
 	}
 
-	CImGuiLayer::CImGuiLayer(GLFWwindow* InContext)
+	CImGuiDrawSnapshot::~CImGuiDrawSnapshot()
+	{
+		Clear();
+	}
+
+	void CImGuiDrawSnapshot::Capture(const ImDrawData& Source)
+	{
+		Clear();
+
+		/* The command and vertex buffers are cloned, ImGui reuses its own draw lists on the next frame. */
+		DrawData = Source;
+		for (int Idx = 0; Idx < DrawData.CmdLists.Size; Idx++)
+		{
+			DrawData.CmdLists[Idx] = Source.CmdLists[Idx]->CloneOutput();
+		}
+	}
+
+	void CImGuiDrawSnapshot::Clear()
+	{
+		for (ImDrawList* DrawList : DrawData.CmdLists)
+		{
+			IM_DELETE(DrawList);
+		}
+		DrawData.Clear();
+	}
+
+	CImGuiLayer::CImGuiLayer(GLFWwindow* InContext, const bool bInRenderThread)
+		: bHeadless(InContext == nullptr)
+		, bRenderThread(bInRenderThread)
 	{
-		LK_VERIFY(InContext);
 		ImGui::CreateContext();
 		ImGuiIO& IO = ImGui::GetIO();
 		IO.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
 		IO.ConfigDockingAlwaysTabBar = false;
 
-		ImGui_ImplGlfw_InitForOpenGL(InContext, true);
-		ImGui_ImplOpenGL3_Init("#version 450");
-		LK_INFO("ImGui: {}", ImGui::GetVersion());
+		if (!bHeadless)
+		{
+			ImGui_ImplGlfw_InitForOpenGL(InContext, true);
+			ImGui_ImplOpenGL3_Init("#version 450");
+		}
+		LK_INFO("ImGui: {}{}", ImGui::GetVersion(), bHeadless ? " (headless)" : "");
 
 		AddFonts();
 		SetDarkTheme();
 
+		if (!bHeadless && bRenderThread)
+		{
+			/* Creates the device objects and the font texture while the context is still current here. */
+			ImGui_ImplOpenGL3_NewFrame();
+		}
+
+		if (bHeadless)
+		{
+			/* Normally done by the platform and renderer backends. */
+			const CWindow* Window = CWindow::Get();
+			IO.DisplaySize = (Window != nullptr) ? ImVec2(Window->GetWidth(), Window->GetHeight()) : ImVec2(SCREEN_WIDTH, SCREEN_HEIGHT);
+			IO.DeltaTime = 1.0f / 60.0f;
+			IO.Fonts->Build();
+		}
+
 		CWindow::OnResized.Add(this, &CImGuiLayer::OnWindowResized);
 	}
 
 	void CImGuiLayer::Destroy()
 	{
 		LK_DEBUG_TAG("ImGuiLayer", "Destroy");
-		ImGui_ImplGlfw_Shutdown();
-		ImGui_ImplOpenGL3_Shutdown();
+		if (!bHeadless)
+		{
+			ImGui_ImplGlfw_Shutdown();
+			ImGui_ImplOpenGL3_Shutdown();
+		}
 		ImGui::DestroyContext();
 	}
 
 	void CImGuiLayer::BeginFrame()
 	{
-		ImGui_ImplOpenGL3_NewFrame();
-		ImGui_ImplGlfw_NewFrame();
+		if (!bHeadless)
+		{
+			if (!bRenderThread)
+			{
+				ImGui_ImplOpenGL3_NewFrame();
+			}
+			ImGui_ImplGlfw_NewFrame();
+		}
 		ImGui::NewFrame();
 		ImGuizmo::BeginFrame();
 
@@ -120,9 +174,15 @@ namespace platformer2d {
 	void CImGuiLayer::EndFrame()
 	{
 		ImGui::End(); /* Viewport */
-
 		ImGui::Render();
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	}
+
+	void CImGuiLayer::RenderDrawData(ImDrawData* DrawData)
+	{
+		if (!bHeadless && (DrawData != nullptr))
+		{
+			ImGui_ImplOpenGL3_RenderDrawData(DrawData);
+		}
 	}
 
 	void CImGuiLayer::AddViewportFlags(const ImGuiWindowFlags Flags)
@@ -4,24 +4,58 @@
 
 #include <imgui/imgui.h>
 
+#include "core/core.h"
 #include "renderer/imgui.h"
 
 struct GLFWwindow;
 
 namespace platformer2d {
 
+	/**
+	 * @brief Copy of the draw data of a frame, rendered while the next frame is built.
+	 */
+	class CImGuiDrawSnapshot
+	{
+	public:
+		CImGuiDrawSnapshot() = default;
+		~CImGuiDrawSnapshot();
+		CImGuiDrawSnapshot(const CImGuiDrawSnapshot&) = delete;
+		CImGuiDrawSnapshot& operator=(const CImGuiDrawSnapshot&) = delete;
+
+		void Capture(const ImDrawData& Source);
+		void Clear();
+
+		FORCEINLINE ImDrawData* Get() { return DrawData.Valid ? &DrawData : nullptr; }
+
+	private:
+		ImDrawData DrawData;
+	};
+
 	class CImGuiLayer
 	{
 	public:
-		CImGuiLayer(GLFWwindow* InContext);
+		/**
+		 * @param InContext Window to render to, nullptr to only build the draw data.
+		 * @param bInRenderThread Draw data is rendered on another thread, see RenderDrawData.
+		 */
+		CImGuiLayer(GLFWwindow* InContext, bool bInRenderThread = false);
 		CImGuiLayer() = delete;
 		~CImGuiLayer() = default;
 
 		void Destroy();
 
 		void BeginFrame();
+
+		/**
+		 * @brief End the frame and build its draw data, see ImGui::GetDrawData.
+		 */
 		void EndFrame();
 
+		/**
+		 * @brief Draw the draw data of a frame, on the thread that owns the GL context.
+		 */
+		void RenderDrawData(ImDrawData* DrawData);
+
 		static void AddViewportFlags(ImGuiWindowFlags Flags);
 		static void RemoveViewportFlags(ImGuiWindowFlags Flags);
 
@@ -30,6 +64,10 @@ namespace platformer2d {
 	private:
 		void AddFonts();
 		void OnWindowResized(uint16_t InWidth, uint16_t InHeight);
+
+	private:
+		bool bHeadless = false;
+		bool bRenderThread = false;
 	};
 
 }
\ No newline at end of file
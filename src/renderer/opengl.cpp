@@ -1,5 +1,8 @@
 #include "opengl.h"
 
+#include <limits>
+#include <numeric>
+
 #include <glm/glm.hpp>
 
 namespace platformer2d::OpenGL {
@@ -12,6 +15,16 @@ namespace platformer2d::OpenGL {
 		Info.Version.Major = Major;
 		Info.Version.Minor = Minor;
 
+		auto GetString = [](const GLenum Name) -> std::string
+		{
+			const GLubyte* String = glGetString(Name);
+			return String ? reinterpret_cast<const char*>(String) : "";
+		};
+		Info.Vendor = GetString(GL_VENDOR);
+		Info.Renderer = GetString(GL_RENDERER);
+		Info.VersionString = GetString(GL_VERSION);
+		LK_OpenGL_Verify(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &Info.ProgramBinaryFormats));
+
 		int ExtensionCount;
 		glGetIntegerv(GL_NUM_EXTENSIONS, &ExtensionCount);
 		Info.Extensions.reserve(ExtensionCount);
@@ -238,4 +251,338 @@ namespace platformer2d::OpenGL {
 		return (Width * Height * GetFormatBPP(ImageFormat));
 	}
 
-}
\ No newline at end of file
+	namespace State
+	{
+		namespace
+		{
+			constexpr GLuint Unknown = std::numeric_limits<GLuint>::max();
+			constexpr int MAX_TEXTURE_UNITS = 32;
+			constexpr int MAX_BUFFER_BINDINGS = 16;
+
+			enum EBufferTarget : uint8_t { Array, ElementArray, Uniform, PixelUnpack, PixelPack, BufferTargetCount };
+			enum ETextureTarget : uint8_t { Texture2D, Texture2DArray, TextureTargetCount };
+			enum ECapability : uint8_t { Blend, DepthTest, CullFace, ScissorTest, LineSmooth, CapabilityCount };
+
+			struct FState
+			{
+				GLuint Program = Unknown;
+				GLuint VertexArray = Unknown;
+				std::array<GLuint, BufferTargetCount> Buffers{};
+				std::array<GLuint, MAX_BUFFER_BINDINGS> UniformBindings{};
+				std::array<std::array<GLuint, TextureTargetCount>, MAX_TEXTURE_UNITS> Textures{};
+				GLuint Framebuffer = Unknown;
+				std::array<int8_t, CapabilityCount> Capabilities{}; /* -1 if unknown. */
+				std::array<GLenum, 4> BlendFunc = { Unknown, Unknown, Unknown, Unknown }; /* RGB and alpha factors. */
+				GLenum DepthFunc = Unknown;
+				int8_t DepthMask = -1;
+			};
+
+			FState Cache;
+			FCounters Counters;
+
+			/* The active unit is left at 0, anything that changes it restores it. */
+			constexpr GLuint ActiveUnit = 0;
+
+			FORCEINLINE bool Update(GLuint& Cached, const GLuint Value, const ECall Call)
+			{
+				if (Cached == Value)
+				{
+					Counters.Skipped[static_cast<int>(Call)]++;
+					return false;
+				}
+
+				Cached = Value;
+				Counters.Issued[static_cast<int>(Call)]++;
+				return true;
+			}
+
+			int GetBufferTarget(const GLenum Target)
+			{
+				switch (Target)
+				{
+					case GL_ARRAY_BUFFER:         return EBufferTarget::Array;
+					case GL_ELEMENT_ARRAY_BUFFER: return EBufferTarget::ElementArray;
+					case GL_UNIFORM_BUFFER:       return EBufferTarget::Uniform;
+					case GL_PIXEL_UNPACK_BUFFER:  return EBufferTarget::PixelUnpack;
+					case GL_PIXEL_PACK_BUFFER:    return EBufferTarget::PixelPack;
+				}
+				return -1;
+			}
+
+			int GetTextureTarget(const GLenum Target)
+			{
+				switch (Target)
+				{
+					case GL_TEXTURE_2D:       return ETextureTarget::Texture2D;
+					case GL_TEXTURE_2D_ARRAY: return ETextureTarget::Texture2DArray;
+				}
+				return -1;
+			}
+
+			int GetCapability(const GLenum Capability)
+			{
+				switch (Capability)
+				{
+					case GL_BLEND:        return ECapability::Blend;
+					case GL_DEPTH_TEST:   return ECapability::DepthTest;
+					case GL_CULL_FACE:    return ECapability::CullFace;
+					case GL_SCISSOR_TEST: return ECapability::ScissorTest;
+					case GL_LINE_SMOOTH:  return ECapability::LineSmooth;
+				}
+				return -1;
+			}
+
+			struct FInitializer
+			{
+				FInitializer() { Invalidate(); }
+			} static Initializer;
+		}
+
+		uint64_t FCounters::GetIssued() const
+		{
+			return std::accumulate(Issued.begin(), Issued.end(), uint64_t(0));
+		}
+
+		uint64_t FCounters::GetSkipped() const
+		{
+			return std::accumulate(Skipped.begin(), Skipped.end(), uint64_t(0));
+		}
+
+		void UseProgram(const GLuint Program)
+		{
+			if (Update(Cache.Program, Program, ECall::Program))
+			{
+				LK_OpenGL_Verify(glUseProgram(Program));
+			}
+		}
+
+		void BindVertexArray(const GLuint VertexArray)
+		{
+			if (Update(Cache.VertexArray, VertexArray, ECall::VertexArray))
+			{
+				LK_OpenGL_Verify(glBindVertexArray(VertexArray));
+				Cache.Buffers[EBufferTarget::ElementArray] = Unknown;
+			}
+		}
+
+		void BindBuffer(const GLenum Target, const GLuint Buffer)
+		{
+			const int Idx = GetBufferTarget(Target);
+			if (Idx < 0)
+			{
+				Counters.Issued[static_cast<int>(ECall::Buffer)]++;
+				LK_OpenGL_Verify(glBindBuffer(Target, Buffer));
+				return;
+			}
+
+			if (Update(Cache.Buffers[Idx], Buffer, ECall::Buffer))
+			{
+				LK_OpenGL_Verify(glBindBuffer(Target, Buffer));
+			}
+		}
+
+		void BindBufferBase(const GLenum Target, const GLuint Index, const GLuint Buffer)
+		{
+			const int Idx = GetBufferTarget(Target);
+			const bool bTracked = (Target == GL_UNIFORM_BUFFER) && (Index < MAX_BUFFER_BINDINGS);
+			if (!bTracked || Update(Cache.UniformBindings[Index], Buffer, ECall::Buffer))
+			{
+				if (!bTracked)
+				{
+					Counters.Issued[static_cast<int>(ECall::Buffer)]++;
+				}
+				LK_OpenGL_Verify(glBindBufferBase(Target, Index, Buffer));
+				if (Idx >= 0)
+				{
+					Cache.Buffers[Idx] = Buffer;
+				}
+			}
+		}
+
+		void BindTextureUnit(const GLuint Unit, const GLenum Target, const GLuint Texture)
+		{
+			const int Idx = GetTextureTarget(Target);
+			if ((Unit >= MAX_TEXTURE_UNITS) || (Idx < 0))
+			{
+				Counters.Issued[static_cast<int>(ECall::Texture)]++;
+				LK_OpenGL_Verify(glBindTextureUnit(Unit, Texture));
+				return;
+			}
+
+			if (Update(Cache.Textures[Unit][Idx], Texture, ECall::Texture))
+			{
+				LK_OpenGL_Verify(glBindTextureUnit(Unit, Texture));
+				if (Texture == 0)
+				{
+					Cache.Textures[Unit].fill(0);
+				}
+			}
+		}
+
+		void BindTexture(const GLenum Target, const GLuint Texture)
+		{
+			const int Idx = GetTextureTarget(Target);
+			if ((Idx < 0) || Update(Cache.Textures[ActiveUnit][Idx], Texture, ECall::Texture))
+			{
+				LK_OpenGL_Verify(glBindTexture(Target, Texture));
+			}
+		}
+
+		void BindFramebuffer(const GLuint Framebuffer)
+		{
+			if (Update(Cache.Framebuffer, Framebuffer, ECall::Framebuffer))
+			{
+				LK_OpenGL_Verify(glBindFramebuffer(GL_FRAMEBUFFER, Framebuffer));
+			}
+		}
+
+		void SetEnabled(const GLenum Capability, const bool bEnabled)
+		{
+			const int Idx = GetCapability(Capability);
+			if ((Idx >= 0) && (Cache.Capabilities[Idx] == static_cast<int8_t>(bEnabled)))
+			{
+				Counters.Skipped[static_cast<int>(ECall::Capability)]++;
+				return;
+			}
+
+			if (Idx >= 0)
+			{
+				Cache.Capabilities[Idx] = static_cast<int8_t>(bEnabled);
+			}
+			Counters.Issued[static_cast<int>(ECall::Capability)]++;
+			if (bEnabled)
+			{
+				LK_OpenGL_Verify(glEnable(Capability));
+			}
+			else
+			{
+				LK_OpenGL_Verify(glDisable(Capability));
+			}
+		}
+
+		void BlendFunc(const GLenum Source, const GLenum Destination)
+		{
+			const std::array<GLenum, 4> Factors = { Source, Destination, Source, Destination };
+			if (Cache.BlendFunc == Factors)
+			{
+				Counters.Skipped[static_cast<int>(ECall::BlendFunc)]++;
+				return;
+			}
+
+			Cache.BlendFunc = Factors;
+			Counters.Issued[static_cast<int>(ECall::BlendFunc)]++;
+			LK_OpenGL_Verify(glBlendFunc(Source, Destination));
+		}
+
+		void BlendFuncSeparate(const GLenum SourceRGB, const GLenum DestinationRGB, const GLenum SourceAlpha, const GLenum DestinationAlpha)
+		{
+			const std::array<GLenum, 4> Factors = { SourceRGB, DestinationRGB, SourceAlpha, DestinationAlpha };
+			if (Cache.BlendFunc == Factors)
+			{
+				Counters.Skipped[static_cast<int>(ECall::BlendFunc)]++;
+				return;
+			}
+
+			Cache.BlendFunc = Factors;
+			Counters.Issued[static_cast<int>(ECall::BlendFunc)]++;
+			LK_OpenGL_Verify(glBlendFuncSeparate(SourceRGB, DestinationRGB, SourceAlpha, DestinationAlpha));
+		}
+
+		void DepthFunc(const GLenum Function)
+		{
+			if (Update(Cache.DepthFunc, Function, ECall::DepthFunc))
+			{
+				LK_OpenGL_Verify(glDepthFunc(Function));
+			}
+		}
+
+		void DepthMask(const bool bWrite)
+		{
+			if (Cache.DepthMask == static_cast<int8_t>(bWrite))
+			{
+				Counters.Skipped[static_cast<int>(ECall::DepthMask)]++;
+				return;
+			}
+
+			Cache.DepthMask = static_cast<int8_t>(bWrite);
+			Counters.Issued[static_cast<int>(ECall::DepthMask)]++;
+			LK_OpenGL_Verify(glDepthMask(bWrite ? GL_TRUE : GL_FALSE));
+		}
+
+		void ForgetProgram(const GLuint Program)
+		{
+			if (Cache.Program == Program)
+			{
+				Cache.Program = Unknown;
+			}
+		}
+
+		void ForgetVertexArray(const GLuint VertexArray)
+		{
+			if (Cache.VertexArray == VertexArray)
+			{
+				Cache.VertexArray = Unknown;
+				Cache.Buffers[EBufferTarget::ElementArray] = Unknown;
+			}
+		}
+
+		void ForgetBuffer(const GLuint Buffer)
+		{
+			for (GLuint& Cached : Cache.Buffers)
+			{
+				Cached = (Cached == Buffer) ? Unknown : Cached;
+			}
+			for (GLuint& Cached : Cache.UniformBindings)
+			{
+				Cached = (Cached == Buffer) ? Unknown : Cached;
+			}
+		}
+
+		void ForgetTexture(const GLuint Texture)
+		{
+			for (auto& Unit : Cache.Textures)
+			{
+				for (GLuint& Cached : Unit)
+				{
+					Cached = (Cached == Texture) ? Unknown : Cached;
+				}
+			}
+		}
+
+		void ForgetFramebuffer(const GLuint Framebuffer)
+		{
+			if (Cache.Framebuffer == Framebuffer)
+			{
+				Cache.Framebuffer = Unknown;
+			}
+		}
+
+		void Invalidate()
+		{
+			Cache.Program = Unknown;
+			Cache.VertexArray = Unknown;
+			Cache.Buffers.fill(Unknown);
+			Cache.UniformBindings.fill(Unknown);
+			for (auto& Unit : Cache.Textures)
+			{
+				Unit.fill(Unknown);
+			}
+			Cache.Framebuffer = Unknown;
+			Cache.Capabilities.fill(-1);
+			Cache.BlendFunc.fill(Unknown);
+			Cache.DepthFunc = Unknown;
+			Cache.DepthMask = -1;
+		}
+
+		const FCounters& GetCounters()
+		{
+			return Counters;
+		}
+
+		void ResetCounters()
+		{
+			Counters = {};
+		}
+	}
+
+}
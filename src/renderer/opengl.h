@@ -5,20 +5,31 @@
 #include <glad/glad.h>
 
 #include "core/assert.h"
+#include "core/macros.h"
 #include "backendinfo.h"
 #include "texture_enums.h"
 #include "vertexbufferlayout.h"
 
-#ifdef LK_BUILD_DEBUG
 #include "opengl_debug.h"
-#endif
 
 #define LK_VERTEXARRAY_RETURN_STD_ARRAY 1
 
+/**
+ * Without LK_OPENGL_ERROR_CHECK the wrapper is the bare call and errors are
+ * only reported through the debug callback, see EOpenGLErrorCheck.
+ */
+#ifdef LK_OPENGL_ERROR_CHECK
 #define LK_OpenGL_Verify(OpenGLFunction) \
-	::platformer2d::OpenGL::Internal::CheckForErrors(); \
+	if (::platformer2d::OpenGL::Internal::bCheckErrors) { ::platformer2d::OpenGL::Internal::CheckForErrors(); } \
 	OpenGLFunction; \
-	LK_VERIFY(::platformer2d::OpenGL::Internal::VerifyFunctionResult(#OpenGLFunction, __FILE__, __LINE__))
+	if (::platformer2d::OpenGL::Internal::bCheckErrors \
+		&& !::platformer2d::OpenGL::Internal::VerifyFunctionResult(#OpenGLFunction, __FILE__, __LINE__)) \
+	{ \
+		LK_VERIFY(false, "{} failed", #OpenGLFunction); \
+	}
+#else
+#define LK_OpenGL_Verify(OpenGLFunction) OpenGLFunction
+#endif
 
 namespace platformer2d {
 
@@ -78,6 +89,92 @@ namespace platformer2d::OpenGL {
 	uint32_t GetFormatBPP(EImageFormat ImageFormat);
 	uint32_t CalculateImageSize(EImageFormat ImageFormat, uint32_t Width, uint32_t Height);
 
+	/**
+	 * @brief Shadow copy of the bound GL state.
+	 *
+	 * Binds and state changes routed through here are only passed on to the driver
+	 * when the value differs from the last one set. Code that changes the state
+	 * directly must call Invalidate afterwards, and deleted objects must be
+	 * forgotten as GL reuses their names.
+	 */
+	namespace State
+	{
+		enum class ECall : uint8_t
+		{
+			Program,
+			VertexArray,
+			Buffer,
+			Texture,
+			Framebuffer,
+			Capability,
+			BlendFunc,
+			DepthFunc,
+			DepthMask,
+			COUNT
+		};
+
+		struct FCounters
+		{
+			std::array<uint64_t, static_cast<int>(ECall::COUNT)> Issued{};
+			std::array<uint64_t, static_cast<int>(ECall::COUNT)> Skipped{};
+
+			FORCEINLINE uint64_t GetIssued(const ECall Call) const { return Issued[static_cast<int>(Call)]; }
+			FORCEINLINE uint64_t GetSkipped(const ECall Call) const { return Skipped[static_cast<int>(Call)]; }
+			uint64_t GetIssued() const;
+			uint64_t GetSkipped() const;
+		};
+
+		void UseProgram(GLuint Program);
+		void BindVertexArray(GLuint VertexArray);
+
+		/**
+		 * @brief Bind a buffer to a target.
+		 * The element array binding belongs to the vertex array and is forgotten when it changes.
+		 */
+		void BindBuffer(GLenum Target, GLuint Buffer);
+
+		/**
+		 * @brief Bind a buffer to an indexed target, also sets the generic binding of the target.
+		 */
+		void BindBufferBase(GLenum Target, GLuint Index, GLuint Buffer);
+
+		/**
+		 * @brief Bind a texture to a unit.
+		 * @param Target Target of the texture, binding 0 unbinds every target of the unit.
+		 */
+		void BindTextureUnit(GLuint Unit, GLenum Target, GLuint Texture);
+
+		/**
+		 * @brief Bind a texture to the active unit, for the non-DSA texture functions.
+		 */
+		void BindTexture(GLenum Target, GLuint Texture);
+
+		/**
+		 * @brief Bind a framebuffer for both drawing and reading, 0 is the default framebuffer.
+		 */
+		void BindFramebuffer(GLuint Framebuffer);
+
+		void SetEnabled(GLenum Capability, bool bEnabled);
+		void BlendFunc(GLenum Source, GLenum Destination);
+		void BlendFuncSeparate(GLenum SourceRGB, GLenum DestinationRGB, GLenum SourceAlpha, GLenum DestinationAlpha);
+		void DepthFunc(GLenum Function);
+		void DepthMask(bool bWrite);
+
+		void ForgetProgram(GLuint Program);
+		void ForgetVertexArray(GLuint VertexArray);
+		void ForgetBuffer(GLuint Buffer);
+		void ForgetTexture(GLuint Texture);
+		void ForgetFramebuffer(GLuint Framebuffer);
+
+		/**
+		 * @brief Mark every cached value as unknown so the next call of each kind is issued.
+		 */
+		void Invalidate();
+
+		const FCounters& GetCounters();
+		void ResetCounters();
+	}
+
 	static constexpr GLenum ShaderDataTypeToOpenGLBaseType(const EShaderDataType Type)
 	{
 		switch (Type)
@@ -93,6 +190,10 @@ namespace platformer2d::OpenGL {
 			case EShaderDataType::Int3:
 			case EShaderDataType::Int4:	  return GL_INT;
 			case EShaderDataType::Bool:	  return GL_BOOL;
+			case EShaderDataType::UByte4:  return GL_UNSIGNED_BYTE;
+			case EShaderDataType::UShort2:
+			case EShaderDataType::UShort4: return GL_UNSIGNED_SHORT;
+			case EShaderDataType::UInt:    return GL_UNSIGNED_INT;
 		}
 		return GL_INVALID_ENUM;
 	}
@@ -109,6 +210,9 @@ namespace platformer2d::OpenGL {
 				case EShaderDataType::Float2:
 				case EShaderDataType::Float3:
 				case EShaderDataType::Float4:
+				case EShaderDataType::UByte4:
+				case EShaderDataType::UShort2:
+				case EShaderDataType::UShort4:
 				{
 					glEnableVertexAttribArray(VertexBufferIndex);
 					glVertexAttribPointer(
@@ -119,6 +223,10 @@ namespace platformer2d::OpenGL {
 						Layout.GetStride(),
 						(const void*)Element.Offset
 					);
+					if (Element.Divisor > 0)
+					{
+						glVertexAttribDivisor(VertexBufferIndex, Element.Divisor);
+					}
 					VertexBufferIndex++;
 					break;
 				}
@@ -127,6 +235,7 @@ namespace platformer2d::OpenGL {
 				case EShaderDataType::Int3:
 				case EShaderDataType::Int4:
 				case EShaderDataType::Bool:
+				case EShaderDataType::UInt:
 				{
 					glEnableVertexAttribArray(VertexBufferIndex);
 					glVertexAttribIPointer(
@@ -136,6 +245,10 @@ namespace platformer2d::OpenGL {
 						Layout.GetStride(),
 						(const void*)Element.Offset
 					);
+					if (Element.Divisor > 0)
+					{
+						glVertexAttribDivisor(VertexBufferIndex, Element.Divisor);
+					}
 					VertexBufferIndex++;
 					break;
 				}
@@ -176,7 +289,7 @@ namespace platformer2d::OpenGL {
 			{
 				GLuint VAO;
 				LK_OpenGL_Verify(glGenVertexArrays(1, &VAO));
-				LK_OpenGL_Verify(glBindVertexArray(VAO));
+				State::BindVertexArray(VAO);
 				return VAO;
 			}
 			/* Return type: std::array<GLuint, N> */
@@ -187,7 +300,7 @@ namespace platformer2d::OpenGL {
 				LK_OpenGL_Verify(glGenVertexArrays(static_cast<GLsizei>(N), VAO.data()));
 			#else
 				GLuint VAO[N];
-				LK_OpenGL_Verify(glBindVertexArray(VAO[0]));
+				State::BindVertexArray(VAO[0]);
 			#endif
 				return VAO;
 			}
@@ -200,7 +313,7 @@ namespace platformer2d::OpenGL {
 		{
 			GLuint VBO;
 			LK_OpenGL_Verify(glGenBuffers(1, &VBO));
-			LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, VBO));
+			State::BindBuffer(GL_ARRAY_BUFFER, VBO);
 			LK_OpenGL_Verify(glBufferData(GL_ARRAY_BUFFER, DataSize, nullptr, BufferType));
 			LK_TRACE_TAG("VertexBuffer", "VBO={} Size={}", VBO, DataSize);
 			ApplyVertexBufferLayout(Layout);
@@ -212,7 +325,7 @@ namespace platformer2d::OpenGL {
 		{
 			GLuint VBO;
 			LK_OpenGL_Verify(glGenBuffers(1, &VBO));
-			LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, VBO));
+			State::BindBuffer(GL_ARRAY_BUFFER, VBO);
 			LK_OpenGL_Verify(glBufferData(GL_ARRAY_BUFFER, sizeof(Data), Data, BufferType));
 			LK_TRACE_TAG("VertexBuffer", "VBO={} Size={}", VBO, sizeof(Data));
 			ApplyVertexBufferLayout(Layout);
@@ -228,7 +341,7 @@ namespace platformer2d::OpenGL {
 			static_assert(N > 0);
 			GLuint EBO;
 			LK_OpenGL_Verify(glGenBuffers(1, &EBO));
-			LK_OpenGL_Verify(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO));
+			State::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
 			LK_OpenGL_Verify(glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(Data), Data, GL_STATIC_DRAW));
 			return EBO;
 		}
@@ -239,7 +352,7 @@ namespace platformer2d::OpenGL {
 			LK_ASSERT(Size > 0);
 			GLuint EBO;
 			LK_OpenGL_Verify(glGenBuffers(1, &EBO));
-			LK_OpenGL_Verify(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO));
+			State::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
 			LK_OpenGL_Verify(glBufferData(GL_ELEMENT_ARRAY_BUFFER, Size, Data, GL_STATIC_DRAW));
 			return EBO;
 		}
@@ -14,6 +14,51 @@
 #error "Missing extension: GL_KHR_debug"
 #endif
 
+namespace platformer2d::OpenGL {
+
+	namespace
+	{
+		EOpenGLErrorCheck ErrorCheck = EOpenGLErrorCheck::Full;
+		uint16_t ErrorCheckInterval = 60;
+		uint16_t ErrorCheckFrame = 0;
+	}
+
+	void SetErrorCheck(const EOpenGLErrorCheck Policy, const uint16_t Interval)
+	{
+		LK_ASSERT(Interval > 0, "Invalid error check interval");
+		ErrorCheck = Policy;
+		ErrorCheckInterval = Interval;
+		ErrorCheckFrame = 0;
+		Internal::bCheckErrors = (Policy == EOpenGLErrorCheck::Full) || (Policy == EOpenGLErrorCheck::Sampled);
+	}
+
+	EOpenGLErrorCheck GetErrorCheck()
+	{
+		return ErrorCheck;
+	}
+
+	void BeginErrorCheckFrame()
+	{
+		if (ErrorCheck != EOpenGLErrorCheck::Sampled)
+		{
+			return;
+		}
+
+		ErrorCheckFrame = (ErrorCheckFrame + 1) % ErrorCheckInterval;
+		Internal::bCheckErrors = (ErrorCheckFrame == 0);
+#ifdef LK_OPENGL_ERROR_CHECK
+		if (Internal::bCheckErrors)
+		{
+			while (const GLenum Error = glGetError())
+			{
+				LK_ERROR_TAG("OpenGL", "Error {:#x} raised in an unchecked frame", static_cast<int>(Error));
+			}
+		}
+#endif
+	}
+
+}
+
 namespace platformer2d::OpenGL::Internal {
 
 	static const char* SourceToString(const GLenum Source)
@@ -79,20 +124,28 @@ namespace platformer2d::OpenGL::Internal {
 					 Message
 		);
 
+#ifdef LK_BUILD_DEBUG
 		if (Type == GL_DEBUG_TYPE_ERROR)
 		{
 			LK_DEBUG_BREAK();
 		}
+#endif
 	}
 
 	void SetupDebugContext(void* Ctx)
 	{
 		int Flags = 0;
 		glGetIntegerv(GL_CONTEXT_FLAGS, &Flags);
-		LK_ASSERT(Flags & GL_CONTEXT_FLAG_DEBUG_BIT);
+		if (!(Flags & GL_CONTEXT_FLAG_DEBUG_BIT))
+		{
+			LK_WARN_TAG("OpenGL", "Not a debug context, the driver may not report any messages");
+		}
 
 		glEnable(GL_DEBUG_OUTPUT);
+#ifdef LK_BUILD_DEBUG
+		/* Report on the calling thread so a break lands on the failing call. */
 		glEnable(GL_DEBUG_OUTPUT_SYNCHRONOUS);
+#endif
 
 		glDebugMessageCallback(DebugCallback, Ctx);
 		glDebugMessageControl(
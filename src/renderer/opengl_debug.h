@@ -1,7 +1,63 @@
 #pragma once
 
-namespace platformer2d::OpenGL::Internal {
+#include <cstdint>
 
-	void SetupDebugContext(void* Ctx);
+namespace platformer2d {
 
-}
\ No newline at end of file
+	/**
+	 * @brief How OpenGL errors are detected.
+	 *
+	 * Full and Sampled poll glGetError around every LK_OpenGL_Verify call, which
+	 * synchronizes with the driver. They only have an effect when the checks are
+	 * compiled in with LK_OPENGL_ERROR_CHECK, otherwise the wrapper is the bare call.
+	 */
+	enum class EOpenGLErrorCheck : uint8_t
+	{
+		None,          /* No error reporting. */
+		DebugCallback, /* Errors are reported by the driver through KHR_debug. */
+		Sampled,       /* Debug callback, and glGetError around every call once every N frames. */
+		Full,          /* Debug callback, and glGetError around every call. */
+	};
+
+	namespace Enum
+	{
+		inline constexpr const char* ToString(const EOpenGLErrorCheck Policy)
+		{
+			switch (Policy)
+			{
+				case EOpenGLErrorCheck::None:          return "None";
+				case EOpenGLErrorCheck::DebugCallback: return "DebugCallback";
+				case EOpenGLErrorCheck::Sampled:       return "Sampled";
+				case EOpenGLErrorCheck::Full:          return "Full";
+				default: break;
+			}
+			return nullptr;
+		}
+	}
+
+}
+
+namespace platformer2d::OpenGL {
+
+	/**
+	 * @brief Set the error check policy.
+	 * @param Interval Frames between checked frames, Sampled only.
+	 */
+	void SetErrorCheck(EOpenGLErrorCheck Policy, uint16_t Interval = 60);
+	EOpenGLErrorCheck GetErrorCheck();
+
+	/**
+	 * @brief Advance the error check policy by one frame.
+	 * A sampled frame first reports any error left behind by the unchecked frames before it.
+	 */
+	void BeginErrorCheckFrame();
+
+	namespace Internal
+	{
+		/* Whether LK_OpenGL_Verify polls glGetError in the current frame. */
+		inline bool bCheckErrors = true;
+
+		void SetupDebugContext(void* Ctx);
+	}
+
+}
@@ -0,0 +1,403 @@
+#include "opengl_null.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "core/assert.h"
+#include "core/log.h"
+
+namespace platformer2d::OpenGL::Null {
+
+	namespace
+	{
+		/* Names are never reused, so the state cache never sees a stale one. */
+		GLuint NextName = 1;
+
+		/* Backing memory of buffers that may be mapped. */
+		std::unordered_map<GLuint, std::vector<uint8_t>> Buffers;
+		std::unordered_map<GLenum, GLuint> BufferBindings;
+
+		/* Every fence is signaled, they only need to be distinct from nullptr. */
+		int SyncObject = 0;
+
+		void GenerateNames(const GLsizei Count, GLuint* Names)
+		{
+			for (GLsizei Idx = 0; Idx < Count; Idx++)
+			{
+				Names[Idx] = NextName++;
+			}
+		}
+
+		void AllocateBuffer(const GLuint Buffer, const GLsizeiptr Size, const void* Data)
+		{
+			std::vector<uint8_t>& Memory = Buffers[Buffer];
+			Memory.resize(static_cast<std::size_t>(Size));
+			if (Data != nullptr)
+			{
+				std::memcpy(Memory.data(), Data, Memory.size());
+			}
+		}
+
+		void* MapBuffer(const GLuint Buffer, const GLintptr Offset, const GLsizeiptr Length)
+		{
+			auto Iter = Buffers.find(Buffer);
+			if ((Iter == Buffers.end()) || (static_cast<std::size_t>(Offset + Length) > Iter->second.size()))
+			{
+				LK_ERROR_TAG("OpenGL", "Null backend: invalid map of buffer {}", Buffer);
+				return nullptr;
+			}
+			return Iter->second.data() + Offset;
+		}
+
+		/**
+		 * @brief Stub of a GL function that has no effect, typed after the glad function pointer.
+		 * Anything returned is zero, which is GL_NO_ERROR, GL_FALSE or nullptr.
+		 */
+		template<typename T>
+		struct TIgnore;
+
+		template<typename R, typename... TArgs>
+		struct TIgnore<R (APIENTRYP)(TArgs...)>
+		{
+			static R APIENTRY Call(TArgs...)
+			{
+				if constexpr (!std::is_void_v<R>)
+				{
+					return R{};
+				}
+			}
+		};
+
+		const GLubyte* APIENTRY GetString(const GLenum Name)
+		{
+			switch (Name)
+			{
+				case GL_VENDOR:                   return reinterpret_cast<const GLubyte*>("platformer2d");
+				case GL_RENDERER:                 return reinterpret_cast<const GLubyte*>("Null");
+				case GL_VERSION:                  return reinterpret_cast<const GLubyte*>("4.5.0 Null");
+				case GL_SHADING_LANGUAGE_VERSION: return reinterpret_cast<const GLubyte*>("4.50");
+				default: break;
+			}
+			return reinterpret_cast<const GLubyte*>("");
+		}
+
+		const GLubyte* APIENTRY GetStringi(const GLenum Name, const GLuint Index)
+		{
+			return reinterpret_cast<const GLubyte*>("");
+		}
+
+		void APIENTRY GetIntegerv(const GLenum Name, GLint* Data)
+		{
+			switch (Name)
+			{
+				case GL_MAJOR_VERSION: *Data = 4; break;
+				case GL_MINOR_VERSION: *Data = 5; break;
+				case GL_NUM_PROGRAM_BINARY_FORMATS: *Data = 1; break;
+				default:               *Data = 0; break;
+			}
+		}
+
+		GLenum APIENTRY GetError()
+		{
+			return GL_NO_ERROR;
+		}
+
+		void APIENTRY GenNames(const GLsizei Count, GLuint* Names)
+		{
+			GenerateNames(Count, Names);
+		}
+
+		void APIENTRY CreateTargetNames(const GLenum Target, const GLsizei Count, GLuint* Names)
+		{
+			GenerateNames(Count, Names);
+		}
+
+		GLuint APIENTRY CreateShader(const GLenum Type)
+		{
+			return NextName++;
+		}
+
+		GLuint APIENTRY CreateProgram()
+		{
+			return NextName++;
+		}
+
+		void APIENTRY DeleteBuffers(const GLsizei Count, const GLuint* Names)
+		{
+			for (GLsizei Idx = 0; Idx < Count; Idx++)
+			{
+				Buffers.erase(Names[Idx]);
+			}
+		}
+
+		void APIENTRY BindBuffer(const GLenum Target, const GLuint Buffer)
+		{
+			BufferBindings[Target] = Buffer;
+		}
+
+		void APIENTRY BufferData(const GLenum Target, const GLsizeiptr Size, const void* Data, const GLenum Usage)
+		{
+			AllocateBuffer(BufferBindings[Target], Size, Data);
+		}
+
+		void APIENTRY NamedBufferData(const GLuint Buffer, const GLsizeiptr Size, const void* Data, const GLenum Usage)
+		{
+			AllocateBuffer(Buffer, Size, Data);
+		}
+
+		void APIENTRY NamedBufferStorage(const GLuint Buffer, const GLsizeiptr Size, const void* Data, const GLbitfield Flags)
+		{
+			AllocateBuffer(Buffer, Size, Data);
+		}
+
+		void* APIENTRY MapNamedBufferRange(const GLuint Buffer, const GLintptr Offset, const GLsizeiptr Length, const GLbitfield Access)
+		{
+			return MapBuffer(Buffer, Offset, Length);
+		}
+
+		GLboolean APIENTRY UnmapNamedBuffer(const GLuint Buffer)
+		{
+			return GL_TRUE;
+		}
+
+		void APIENTRY GetShaderiv(const GLuint Shader, const GLenum Name, GLint* Params)
+		{
+			*Params = (Name == GL_COMPILE_STATUS) ? GL_TRUE : 0;
+		}
+
+		constexpr std::string_view NullProgramBinary = "NULLPROG";
+
+		void APIENTRY GetProgramiv(const GLuint Program, const GLenum Name, GLint* Params)
+		{
+			switch (Name)
+			{
+				case GL_LINK_STATUS:
+				case GL_VALIDATE_STATUS:        *Params = GL_TRUE; break;
+				case GL_PROGRAM_BINARY_LENGTH:  *Params = static_cast<GLint>(NullProgramBinary.size()); break;
+				default:                        *Params = 0; break;
+			}
+		}
+
+		void APIENTRY GetProgramBinary(const GLuint Program, const GLsizei BufferSize, GLsizei* Length, GLenum* BinaryFormat, void* Binary)
+		{
+			const GLsizei Size = std::min(BufferSize, static_cast<GLsizei>(NullProgramBinary.size()));
+			std::memcpy(Binary, NullProgramBinary.data(), Size);
+			if (Length != nullptr)
+			{
+				*Length = Size;
+			}
+			*BinaryFormat = 1;
+		}
+
+		void APIENTRY GetInfoLog(const GLuint Object, const GLsizei BufferSize, GLsizei* Length, GLchar* InfoLog)
+		{
+			if (Length != nullptr)
+			{
+				*Length = 0;
+			}
+			if ((InfoLog != nullptr) && (BufferSize > 0))
+			{
+				InfoLog[0] = '\0';
+			}
+		}
+
+		void APIENTRY GetProgramInterfaceiv(const GLuint Program, const GLenum Interface, const GLenum Name, GLint* Params)
+		{
+			/* No uniforms are reflected, they resolve through GetUniformLocation instead. */
+			*Params = 0;
+		}
+
+		GLint APIENTRY GetUniformLocation(const GLuint Program, const GLchar* Name)
+		{
+			return 0;
+		}
+
+		GLuint APIENTRY GetUniformBlockIndex(const GLuint Program, const GLchar* Name)
+		{
+			return 0;
+		}
+
+		void APIENTRY GetUniformfv(const GLuint Program, const GLint Location, GLfloat* Params)
+		{
+			/* The value count depends on the uniform type, the caller keeps its own values. */
+		}
+
+		GLenum APIENTRY CheckNamedFramebufferStatus(const GLuint Framebuffer, const GLenum Target)
+		{
+			return GL_FRAMEBUFFER_COMPLETE;
+		}
+
+		GLsync APIENTRY FenceSync(const GLenum Condition, const GLbitfield Flags)
+		{
+			return reinterpret_cast<GLsync>(&SyncObject);
+		}
+
+		GLenum APIENTRY ClientWaitSync(const GLsync Sync, const GLbitfield Flags, const GLuint64 Timeout)
+		{
+			return GL_ALREADY_SIGNALED;
+		}
+
+		void APIENTRY GetQueryObjectiv(const GLuint Query, const GLenum Name, GLint* Params)
+		{
+			*Params = (Name == GL_QUERY_RESULT_AVAILABLE) ? GL_TRUE : 0;
+		}
+
+		void APIENTRY GetQueryObjectui64v(const GLuint Query, const GLenum Name, GLuint64* Params)
+		{
+			*Params = 0;
+		}
+
+		/*
+		 * Every GL function used by the engine, with a stub above or ignored.
+		 * The stubs are checked against the glad function pointer types at compile time.
+		 */
+		#define LK_NULL_GL_FUNCTIONS(Stub, Ignore) \
+			Ignore(glActiveTexture) \
+			Ignore(glAttachShader) \
+			Ignore(glBeginQuery) \
+			Ignore(glBeginTransformFeedback) \
+			Stub(glBindBuffer, BindBuffer) \
+			Ignore(glBindBufferBase) \
+			Ignore(glBindFramebuffer) \
+			Ignore(glBindTexture) \
+			Ignore(glBindTextureUnit) \
+			Ignore(glBindVertexArray) \
+			Ignore(glBlendFunc) \
+			Ignore(glBlendFuncSeparate) \
+			Stub(glBufferData, BufferData) \
+			Ignore(glBufferSubData) \
+			Stub(glCheckNamedFramebufferStatus, CheckNamedFramebufferStatus) \
+			Ignore(glClear) \
+			Ignore(glClearColor) \
+			Ignore(glClearNamedFramebufferfv) \
+			Ignore(glClearTexImage) \
+			Ignore(glClearTexSubImage) \
+			Stub(glClientWaitSync, ClientWaitSync) \
+			Ignore(glCompileShader) \
+			Ignore(glCompressedTextureSubImage2D) \
+			Stub(glCreateBuffers, GenNames) \
+			Stub(glCreateFramebuffers, GenNames) \
+			Stub(glCreateProgram, CreateProgram) \
+			Stub(glCreateQueries, CreateTargetNames) \
+			Stub(glCreateShader, CreateShader) \
+			Stub(glCreateTextures, CreateTargetNames) \
+			Ignore(glDebugMessageCallback) \
+			Ignore(glDebugMessageControl) \
+			Stub(glDeleteBuffers, DeleteBuffers) \
+			Ignore(glDeleteFramebuffers) \
+			Ignore(glDeleteProgram) \
+			Ignore(glDeleteQueries) \
+			Ignore(glDeleteShader) \
+			Ignore(glDeleteSync) \
+			Ignore(glDeleteTextures) \
+			Ignore(glDeleteVertexArrays) \
+			Ignore(glDepthFunc) \
+			Ignore(glDepthMask) \
+			Ignore(glDetachShader) \
+			Ignore(glDisable) \
+			Ignore(glDisableVertexAttribArray) \
+			Ignore(glDrawArrays) \
+			Ignore(glDrawArraysInstanced) \
+			Ignore(glDrawArraysInstancedBaseInstance) \
+			Ignore(glDrawElements) \
+			Ignore(glDrawElementsBaseVertex) \
+			Ignore(glEnable) \
+			Ignore(glEnableVertexAttribArray) \
+			Ignore(glEndQuery) \
+			Ignore(glEndTransformFeedback) \
+			Stub(glFenceSync, FenceSync) \
+			Stub(glGenBuffers, GenNames) \
+			Stub(glGenTextures, GenNames) \
+			Stub(glGenVertexArrays, GenNames) \
+			Ignore(glGenerateTextureMipmap) \
+			Stub(glGetError, GetError) \
+			Stub(glGetIntegerv, GetIntegerv) \
+			Stub(glGetProgramBinary, GetProgramBinary) \
+			Stub(glGetProgramInfoLog, GetInfoLog) \
+			Stub(glGetProgramInterfaceiv, GetProgramInterfaceiv) \
+			Ignore(glGetProgramResourceName) \
+			Ignore(glGetProgramResourceiv) \
+			Stub(glGetProgramiv, GetProgramiv) \
+			Stub(glGetQueryObjectiv, GetQueryObjectiv) \
+			Stub(glGetQueryObjectui64v, GetQueryObjectui64v) \
+			Stub(glGetShaderInfoLog, GetInfoLog) \
+			Stub(glGetShaderiv, GetShaderiv) \
+			Stub(glGetString, GetString) \
+			Stub(glGetStringi, GetStringi) \
+			Stub(glGetUniformBlockIndex, GetUniformBlockIndex) \
+			Stub(glGetUniformLocation, GetUniformLocation) \
+			Stub(glGetUniformfv, GetUniformfv) \
+			Ignore(glLineWidth) \
+			Ignore(glLinkProgram) \
+			Stub(glMapNamedBufferRange, MapNamedBufferRange) \
+			Stub(glNamedBufferData, NamedBufferData) \
+			Stub(glNamedBufferStorage, NamedBufferStorage) \
+			Ignore(glNamedBufferSubData) \
+			Ignore(glNamedFramebufferTexture) \
+			Ignore(glProgramBinary) \
+			Ignore(glProgramParameteri) \
+			Ignore(glShaderSource) \
+			Ignore(glTexImage2D) \
+			Ignore(glTexParameteri) \
+			Ignore(glTextureParameteri) \
+			Ignore(glTextureStorage2D) \
+			Ignore(glTextureStorage3D) \
+			Ignore(glTextureSubImage2D) \
+			Ignore(glTextureSubImage3D) \
+			Ignore(glTextureView) \
+			Ignore(glTransformFeedbackVaryings) \
+			Ignore(glUniform1f) \
+			Ignore(glUniform1i) \
+			Ignore(glUniform1iv) \
+			Ignore(glUniform1ui) \
+			Ignore(glUniform1uiv) \
+			Ignore(glUniform2f) \
+			Ignore(glUniform3f) \
+			Ignore(glUniform4f) \
+			Ignore(glUniform4fv) \
+			Ignore(glUniformBlockBinding) \
+			Ignore(glUniformMatrix4fv) \
+			Stub(glUnmapNamedBuffer, UnmapNamedBuffer) \
+			Ignore(glUseProgram) \
+			Ignore(glValidateProgram) \
+			Ignore(glVertexAttribDivisor) \
+			Ignore(glVertexAttribIPointer) \
+			Ignore(glVertexAttribPointer) \
+			Ignore(glViewport)
+
+		#define LK_NULL_STUB(Name, Function) { #Name, reinterpret_cast<void*>(static_cast<decltype(glad_##Name)>(&Function)) },
+		#define LK_NULL_IGNORE(Name) { #Name, reinterpret_cast<void*>(&TIgnore<decltype(glad_##Name)>::Call) },
+		const std::unordered_map<std::string_view, void*> Procs = {
+			LK_NULL_GL_FUNCTIONS(LK_NULL_STUB, LK_NULL_IGNORE)
+		};
+		#undef LK_NULL_IGNORE
+		#undef LK_NULL_STUB
+	}
+
+	void* LoadProc(const char* Name)
+	{
+		LK_ASSERT(Name);
+		const auto Iter = Procs.find(Name);
+		LK_VERIFY(Iter != Procs.end(), "Null backend: no stub for {}", Name);
+
+		return Iter->second;
+	}
+
+	bool Load()
+	{
+		/* Only the functions in the table are set, calling any other GL function is a null pointer call. */
+		#define LK_NULL_LOAD(Name, ...) glad_##Name = reinterpret_cast<decltype(glad_##Name)>(LoadProc(#Name));
+		LK_NULL_GL_FUNCTIONS(LK_NULL_LOAD, LK_NULL_LOAD)
+		#undef LK_NULL_LOAD
+
+		LK_DEBUG_TAG("OpenGL", "Null backend: {} functions stubbed", Procs.size());
+		return true;
+	}
+
+}
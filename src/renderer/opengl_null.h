@@ -0,0 +1,20 @@
+#pragma once
+
+namespace platformer2d::OpenGL::Null {
+
+	/**
+	 * @brief Point the glad function table at CPU-side stubs, in place of gladLoadGLLoader.
+	 *
+	 * Object names are handed out, buffers that may be mapped get CPU memory,
+	 * queries and fences complete immediately and shaders always compile.
+	 * Everything else is ignored, so the renderer runs without a GL context.
+	 * Only the GL functions used by the engine have a stub, a new one has to be added to the table.
+	 */
+	bool Load();
+
+	/**
+	 * @brief Stub of a GL function, verifies that it exists.
+	 */
+	void* LoadProc(const char* Name);
+
+}
@@ -0,0 +1,305 @@
+#include "quadkernel.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/macros.h"
+
+#if defined(__AVX2__)
+#	define LK_QUADKERNEL_AVX2
+#	include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#	define LK_QUADKERNEL_SSE2
+#	include <emmintrin.h>
+#endif
+
+namespace platformer2d::QuadKernel {
+
+	namespace
+	{
+		constexpr float TileFactor = 1.0f;
+
+		/* Writes the four vertices of a quad from its computed corners. */
+		FORCEINLINE void WriteQuad(const FQuadInstance& Instance, const float (&X)[4], const float (&Y)[4], FQuadVertexPacked* Vertex)
+		{
+			/* UNORM16x2 words are (U, V), the corners mix the halves of the bottom left and top right UV. */
+			const uint32_t UV0 = Instance.TexCoords[0];
+			const uint32_t UV1 = Instance.TexCoords[1];
+			const uint32_t TexCoords[4] = {
+				UV0,
+				(UV0 & 0x0000FFFF) | (UV1 & 0xFFFF0000),
+				UV1,
+				(UV1 & 0x0000FFFF) | (UV0 & 0xFFFF0000)
+			};
+			const uint32_t TexIndexTile = FQuadVertexPacked::PackTexIndex(Instance.TexIndex, TileFactor);
+
+			for (int Corner = 0; Corner < 4; Corner++)
+			{
+				Vertex->Position = { X[Corner], Y[Corner], Instance.Position.z };
+				Vertex->Color = Instance.Color;
+				Vertex->TexCoord = TexCoords[Corner];
+				Vertex->TexIndexTile = TexIndexTile;
+				Vertex++;
+			}
+		}
+
+		FORCEINLINE void WriteQuad(const FQuadInstance& Instance, const float (&X)[4], const float (&Y)[4], FQuadVertex* Vertex)
+		{
+			const glm::vec4 Color = glm::unpackUnorm4x8(Instance.Color);
+			const glm::vec2 UV0 = glm::unpackUnorm2x16(Instance.TexCoords[0]);
+			const glm::vec2 UV1 = glm::unpackUnorm2x16(Instance.TexCoords[1]);
+			const glm::vec2 TexCoords[4] = {
+				{ UV0.x, UV0.y },
+				{ UV0.x, UV1.y },
+				{ UV1.x, UV1.y },
+				{ UV1.x, UV0.y }
+			};
+
+			for (int Corner = 0; Corner < 4; Corner++)
+			{
+				Vertex->Position = { X[Corner], Y[Corner], Instance.Position.z };
+				Vertex->Color = Color;
+				Vertex->TexCoord = TexCoords[Corner];
+				Vertex->TexIndex = static_cast<int>(Instance.TexIndex);
+				Vertex->TileFactor = TileFactor;
+				Vertex++;
+			}
+		}
+
+		template<typename TVertex>
+		void GenerateVerticesScalarImpl(const std::span<const FQuadInstance> Instances, TVertex* Vertices)
+		{
+			for (const FQuadInstance& Instance : Instances)
+			{
+				const float Sin = std::sin(Instance.Rotation);
+				const float Cos = std::cos(Instance.Rotation);
+				const float Hx = Instance.Size.x * 0.5f;
+				const float Hy = Instance.Size.y * 0.5f;
+
+				const float Ax = Cos * Hx;
+				const float Ay = Sin * Hx;
+				const float Bx = -Sin * Hy;
+				const float By = Cos * Hy;
+
+				const float Px = Instance.Position.x;
+				const float Py = Instance.Position.y;
+				const float X[4] = { Px - Ax - Bx, Px - Ax + Bx, Px + Ax + Bx, Px + Ax - Bx };
+				const float Y[4] = { Py - Ay - By, Py - Ay + By, Py + Ay + By, Py + Ay - By };
+
+				WriteQuad(Instance, X, Y, Vertices);
+				Vertices += 4;
+			}
+		}
+
+#if defined(LK_QUADKERNEL_SSE2) || defined(LK_QUADKERNEL_AVX2)
+		/* Cody-Waite split of pi/2 and the sinf/cosf minimax coefficients on [-pi/4, pi/4]. */
+		constexpr float TwoOverPi = 0.636619772367581343f;
+		constexpr float PiOver2[3] = { 1.5703125f, 4.837512969970703125e-4f, 7.54978995489188216e-8f };
+		constexpr float SinCoeff[3] = { -1.6666654611e-1f, 8.3321608736e-3f, -1.9515295891e-4f };
+		constexpr float CosCoeff[3] = { 4.166664568298827e-2f, -1.388731625493765e-3f, 2.443315711809948e-5f };
+#endif
+
+#if defined(LK_QUADKERNEL_AVX2)
+		struct FLanes
+		{
+			using FFloat = __m256;
+			using FInt = __m256i;
+			static constexpr int Width = 8;
+			static constexpr const char* Name = "AVX2";
+
+			static FORCEINLINE FFloat Load(const float* P) { return _mm256_load_ps(P); }
+			static FORCEINLINE void Store(float* P, const FFloat V) { _mm256_store_ps(P, V); }
+			static FORCEINLINE FFloat Set(const float V) { return _mm256_set1_ps(V); }
+			static FORCEINLINE FFloat Add(const FFloat A, const FFloat B) { return _mm256_add_ps(A, B); }
+			static FORCEINLINE FFloat Sub(const FFloat A, const FFloat B) { return _mm256_sub_ps(A, B); }
+			static FORCEINLINE FFloat Mul(const FFloat A, const FFloat B) { return _mm256_mul_ps(A, B); }
+			static FORCEINLINE FInt Round(const FFloat V) { return _mm256_cvtps_epi32(V); }
+			static FORCEINLINE FFloat ToFloat(const FInt V) { return _mm256_cvtepi32_ps(V); }
+			static FORCEINLINE FInt SetInt(const int V) { return _mm256_set1_epi32(V); }
+			static FORCEINLINE FInt AddInt(const FInt A, const FInt B) { return _mm256_add_epi32(A, B); }
+			static FORCEINLINE FInt AndInt(const FInt A, const FInt B) { return _mm256_and_si256(A, B); }
+			static FORCEINLINE FInt EqualInt(const FInt A, const FInt B) { return _mm256_cmpeq_epi32(A, B); }
+			static FORCEINLINE FInt ShiftLeft30(const FInt V) { return _mm256_slli_epi32(V, 30); }
+			static FORCEINLINE FFloat Select(const FInt Mask, const FFloat A, const FFloat B)
+			{
+				return _mm256_blendv_ps(B, A, _mm256_castsi256_ps(Mask));
+			}
+			static FORCEINLINE FFloat FlipSign(const FFloat V, const FInt SignBits)
+			{
+				return _mm256_xor_ps(V, _mm256_castsi256_ps(SignBits));
+			}
+		};
+#elif defined(LK_QUADKERNEL_SSE2)
+		struct FLanes
+		{
+			using FFloat = __m128;
+			using FInt = __m128i;
+			static constexpr int Width = 4;
+			static constexpr const char* Name = "SSE2";
+
+			static FORCEINLINE FFloat Load(const float* P) { return _mm_load_ps(P); }
+			static FORCEINLINE void Store(float* P, const FFloat V) { _mm_store_ps(P, V); }
+			static FORCEINLINE FFloat Set(const float V) { return _mm_set1_ps(V); }
+			static FORCEINLINE FFloat Add(const FFloat A, const FFloat B) { return _mm_add_ps(A, B); }
+			static FORCEINLINE FFloat Sub(const FFloat A, const FFloat B) { return _mm_sub_ps(A, B); }
+			static FORCEINLINE FFloat Mul(const FFloat A, const FFloat B) { return _mm_mul_ps(A, B); }
+			static FORCEINLINE FInt Round(const FFloat V) { return _mm_cvtps_epi32(V); }
+			static FORCEINLINE FFloat ToFloat(const FInt V) { return _mm_cvtepi32_ps(V); }
+			static FORCEINLINE FInt SetInt(const int V) { return _mm_set1_epi32(V); }
+			static FORCEINLINE FInt AddInt(const FInt A, const FInt B) { return _mm_add_epi32(A, B); }
+			static FORCEINLINE FInt AndInt(const FInt A, const FInt B) { return _mm_and_si128(A, B); }
+			static FORCEINLINE FInt EqualInt(const FInt A, const FInt B) { return _mm_cmpeq_epi32(A, B); }
+			static FORCEINLINE FInt ShiftLeft30(const FInt V) { return _mm_slli_epi32(V, 30); }
+			static FORCEINLINE FFloat Select(const FInt Mask, const FFloat A, const FFloat B)
+			{
+				const __m128 M = _mm_castsi128_ps(Mask);
+				return _mm_or_ps(_mm_and_ps(M, A), _mm_andnot_ps(M, B));
+			}
+			static FORCEINLINE FFloat FlipSign(const FFloat V, const FInt SignBits)
+			{
+				return _mm_xor_ps(V, _mm_castsi128_ps(SignBits));
+			}
+		};
+#endif
+
+#if defined(LK_QUADKERNEL_SSE2) || defined(LK_QUADKERNEL_AVX2)
+		using T = FLanes;
+
+		/**
+		 * Reduce the angle to [-pi/4, pi/4] around the nearest multiple of pi/2,
+		 * evaluate both polynomials and pick/negate by quadrant.
+		 */
+		FORCEINLINE void SinCos(const T::FFloat X, T::FFloat& OutSin, T::FFloat& OutCos)
+		{
+			const T::FInt Quadrant = T::Round(T::Mul(X, T::Set(TwoOverPi)));
+			const T::FFloat Q = T::ToFloat(Quadrant);
+
+			T::FFloat R = T::Sub(X, T::Mul(Q, T::Set(PiOver2[0])));
+			R = T::Sub(R, T::Mul(Q, T::Set(PiOver2[1])));
+			R = T::Sub(R, T::Mul(Q, T::Set(PiOver2[2])));
+			const T::FFloat R2 = T::Mul(R, R);
+
+			T::FFloat S = T::Add(T::Mul(R2, T::Set(SinCoeff[2])), T::Set(SinCoeff[1]));
+			S = T::Add(T::Mul(S, R2), T::Set(SinCoeff[0]));
+			S = T::Add(T::Mul(T::Mul(S, R2), R), R);
+
+			T::FFloat C = T::Add(T::Mul(R2, T::Set(CosCoeff[2])), T::Set(CosCoeff[1]));
+			C = T::Add(T::Mul(C, R2), T::Set(CosCoeff[0]));
+			C = T::Add(T::Sub(T::Mul(T::Mul(C, R2), R2), T::Mul(R2, T::Set(0.5f))), T::Set(1.0f));
+
+			const T::FInt One = T::SetInt(1);
+			const T::FInt Two = T::SetInt(2);
+			const T::FInt Swap = T::EqualInt(T::AndInt(Quadrant, One), One);
+			const T::FInt SinSign = T::ShiftLeft30(T::AndInt(Quadrant, Two));
+			const T::FInt CosSign = T::ShiftLeft30(T::AndInt(T::AddInt(Quadrant, One), Two));
+
+			OutSin = T::FlipSign(T::Select(Swap, C, S), SinSign);
+			OutCos = T::FlipSign(T::Select(Swap, S, C), CosSign);
+		}
+
+		template<typename TVertex>
+		void GenerateVerticesSimd(const std::span<const FQuadInstance> Instances, TVertex* Vertices)
+		{
+			constexpr int W = T::Width;
+			alignas(32) float Px[W], Py[W], Hx[W], Hy[W], Rotation[W];
+			alignas(32) float X[4][W], Y[4][W];
+
+			const std::size_t Count = Instances.size();
+			for (std::size_t Base = 0; Base < Count; Base += W)
+			{
+				const int Lanes = static_cast<int>(std::min<std::size_t>(W, Count - Base));
+
+				/* Transpose to one lane per quad, unused lanes are zeroed. */
+				for (int Lane = 0; Lane < W; Lane++)
+				{
+					if (Lane < Lanes)
+					{
+						const FQuadInstance& Instance = Instances[Base + Lane];
+						Px[Lane] = Instance.Position.x;
+						Py[Lane] = Instance.Position.y;
+						Hx[Lane] = Instance.Size.x * 0.5f;
+						Hy[Lane] = Instance.Size.y * 0.5f;
+						Rotation[Lane] = Instance.Rotation;
+					}
+					else
+					{
+						Px[Lane] = Py[Lane] = Hx[Lane] = Hy[Lane] = Rotation[Lane] = 0.0f;
+					}
+				}
+
+				T::FFloat Sin, Cos;
+				SinCos(T::Load(Rotation), Sin, Cos);
+
+				/* Rotated half extents along the local x (A) and y (B) axes. */
+				const T::FFloat HalfX = T::Load(Hx);
+				const T::FFloat HalfY = T::Load(Hy);
+				const T::FFloat Ax = T::Mul(Cos, HalfX);
+				const T::FFloat Ay = T::Mul(Sin, HalfX);
+				const T::FFloat Bx = T::Mul(T::Sub(T::Set(0.0f), Sin), HalfY);
+				const T::FFloat By = T::Mul(Cos, HalfY);
+
+				const T::FFloat PosX = T::Load(Px);
+				const T::FFloat PosY = T::Load(Py);
+				const T::FFloat LeftX = T::Sub(PosX, Ax);
+				const T::FFloat LeftY = T::Sub(PosY, Ay);
+				const T::FFloat RightX = T::Add(PosX, Ax);
+				const T::FFloat RightY = T::Add(PosY, Ay);
+
+				T::Store(X[0], T::Sub(LeftX, Bx));  T::Store(Y[0], T::Sub(LeftY, By));  /* Bottom Left.  */
+				T::Store(X[1], T::Add(LeftX, Bx));  T::Store(Y[1], T::Add(LeftY, By));  /* Top Left.     */
+				T::Store(X[2], T::Add(RightX, Bx)); T::Store(Y[2], T::Add(RightY, By)); /* Top Right.    */
+				T::Store(X[3], T::Sub(RightX, Bx)); T::Store(Y[3], T::Sub(RightY, By)); /* Bottom Right. */
+
+				for (int Lane = 0; Lane < Lanes; Lane++)
+				{
+					const float CornerX[4] = { X[0][Lane], X[1][Lane], X[2][Lane], X[3][Lane] };
+					const float CornerY[4] = { Y[0][Lane], Y[1][Lane], Y[2][Lane], Y[3][Lane] };
+					WriteQuad(Instances[Base + Lane], CornerX, CornerY, Vertices + ((Base + Lane) * 4));
+				}
+			}
+		}
+#endif
+	}
+
+	int GetWidth()
+	{
+#if defined(LK_QUADKERNEL_SSE2) || defined(LK_QUADKERNEL_AVX2)
+		return FLanes::Width;
+#else
+		return 1;
+#endif
+	}
+
+	const char* GetInstructionSet()
+	{
+#if defined(LK_QUADKERNEL_SSE2) || defined(LK_QUADKERNEL_AVX2)
+		return FLanes::Name;
+#else
+		return "Scalar";
+#endif
+	}
+
+	void GenerateVertices(const std::span<const FQuadInstance> Instances, FQuadVertex* Vertices)
+	{
+#if defined(LK_QUADKERNEL_SSE2) || defined(LK_QUADKERNEL_AVX2)
+		GenerateVerticesSimd(Instances, Vertices);
+#else
+		GenerateVerticesScalarImpl(Instances, Vertices);
+#endif
+	}
+
+	void GenerateVertices(const std::span<const FQuadInstance> Instances, FQuadVertexPacked* Vertices)
+	{
+#if defined(LK_QUADKERNEL_SSE2) || defined(LK_QUADKERNEL_AVX2)
+		GenerateVerticesSimd(Instances, Vertices);
+#else
+		GenerateVerticesScalarImpl(Instances, Vertices);
+#endif
+	}
+
+	void GenerateVerticesScalar(const std::span<const FQuadInstance> Instances, FQuadVertex* Vertices)
+	{
+		GenerateVerticesScalarImpl(Instances, Vertices);
+	}
+
+}
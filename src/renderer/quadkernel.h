@@ -0,0 +1,36 @@
+#pragma once
+
+#include <span>
+
+#include "vertex.h"
+
+namespace platformer2d::QuadKernel {
+
+	/**
+	 * @brief Quads processed per iteration of the vectorized kernel.
+	 */
+	int GetWidth();
+
+	/**
+	 * @brief Instruction set the kernel was compiled for.
+	 */
+	const char* GetInstructionSet();
+
+	/**
+	 * @brief Expand quad instances to four vertices each.
+	 *
+	 * The corners are computed from the position, half size and the sine and cosine
+	 * of the rotation, without building a transform matrix.
+	 * The vertices are written in the order: bottom left, top left, top right, bottom right.
+	 *
+	 * @param Vertices Destination with room for (4 * Instances.size()) vertices.
+	 */
+	void GenerateVertices(std::span<const FQuadInstance> Instances, FQuadVertex* Vertices);
+	void GenerateVertices(std::span<const FQuadInstance> Instances, FQuadVertexPacked* Vertices);
+
+	/**
+	 * @brief Scalar reference of GenerateVertices.
+	 */
+	void GenerateVerticesScalar(std::span<const FQuadInstance> Instances, FQuadVertex* Vertices);
+
+}
@@ -1,65 +1,200 @@
 #include "rendercommandqueue.h"
 
-#include <memory>
+#include <algorithm>
+#include <new>
 
 namespace platformer2d {
 
-	CRenderCommandQueue::CRenderCommandQueue()
+	namespace
 	{
-		CommandBuffer = new uint8_t[10 * 1024 * 1024];
-		CommandBufferPtr = CommandBuffer;
-		std::memset(CommandBuffer, 0, 10 * 1024 * 1024);
+		/*
+		  +----------------+---------+----------------+
+		  | FCommandHeader | Padding | Command data   |
+		  +----------------+---------+----------------+
+		  Next: Offset from the header to the next header, 0 on the last command of a page.
+		  The command data of a submitted closure is the closure itself.
+		 */
+		struct FCommandHeader
+		{
+			CRenderCommandQueue::FRenderCommand Command = nullptr;
+			CRenderCommandQueue::FRenderCommand Destroy = nullptr; /* Run instead of the command if it is never executed. */
+			uint32_t PayloadOffset = 0;
+			uint32_t Next = 0;
+		};
+
+		FORCEINLINE constexpr std::size_t AlignUp(const std::size_t Value, const std::size_t Alignment)
+		{
+			return (Value + (Alignment - 1)) & ~(Alignment - 1);
+		}
+	}
+
+	CRenderCommandQueue::CRenderCommandQueue(const std::size_t InPageSize)
+		: PageSize(AlignUp(InPageSize, PAGE_ALIGNMENT))
+	{
+		LK_VERIFY(PageSize > sizeof(FCommandHeader));
+		AddPage(0, PageSize);
 	}
 
 	CRenderCommandQueue::~CRenderCommandQueue()
 	{
-		delete[] CommandBuffer;
+		/* Captures of commands that were never executed are still released. */
+		ForEachCommand([](const FCommandHeader& Header, void* Payload)
+		{
+			if (Header.Destroy)
+			{
+				Header.Destroy(Payload);
+			}
+		});
+
+		for (FPage& Page : Pages)
+		{
+			::operator delete(Page.Memory, std::align_val_t(PAGE_ALIGNMENT));
+		}
+	}
+
+	template<typename TFunction>
+	void CRenderCommandQueue::ForEachCommand(TFunction&& Function)
+	{
+		for (std::size_t Idx = 0; Idx <= PageIndex; Idx++)
+		{
+			FPage& Page = Pages[Idx];
+			std::size_t Offset = 0;
+			while (Offset < Page.Used)
+			{
+				const FCommandHeader& Header = *reinterpret_cast<const FCommandHeader*>(Page.Memory + Offset);
+				LK_ASSERT((Offset + Header.PayloadOffset) <= Page.Used, "Command payload outside of its page");
+				Function(Header, Page.Memory + Offset + Header.PayloadOffset);
+				if (Header.Next == 0)
+				{
+					break;
+				}
+				Offset += Header.Next;
+			}
+		}
+
+		/* The pages are refilled from the start by the next frame. */
+		for (std::size_t Idx = 0; Idx <= PageIndex; Idx++)
+		{
+			Pages[Idx].Used = 0;
+			Pages[Idx].bNeeded = true;
+		}
+		PageIndex = 0;
+		LastCommandOffset = NO_COMMAND;
+		Statistics.CommandCount = 0;
+		Statistics.BytesUsed = 0;
 	}
 
 	void CRenderCommandQueue::Execute()
 	{
-		/*
-		  +----------------+-----------------+--------------+
-		  | Render Command | Size (uint32_t) | Command data | 
-		  +----------------+-----------------+--------------+
-		 */
-		uint8_t* TargetBuf = CommandBuffer;
-		for (uint32_t i = 0; i < CommandCount; i++)
+		ForEachCommand([](const FCommandHeader& Header, void* Payload)
 		{
-			FRenderCommand RenderCommand = *(FRenderCommand*)TargetBuf;
-			TargetBuf += sizeof(FRenderCommand);
+			Header.Command(Payload);
+		});
 
-			const uint32_t Size = *(uint32_t*)TargetBuf;
-			TargetBuf += sizeof(uint32_t);
+		if (++ExecutionCount >= SHRINK_INTERVAL)
+		{
+			Shrink();
+		}
+	}
+
+	void* CRenderCommandQueue::Allocate(const FRenderCommand RenderCommand, const uint32_t Size, const std::size_t Alignment,
+										const FRenderCommand Destroy)
+	{
+		LK_ASSERT(RenderCommand);
+		LK_ASSERT((Alignment > 0) && ((Alignment & (Alignment - 1)) == 0) && (Alignment <= PAGE_ALIGNMENT),
+				  "Invalid payload alignment: {}", Alignment);
+
+		/* The header is placed at the start of the block, the payload after it at its own alignment. */
+		const std::size_t PayloadOffset = AlignUp(sizeof(FCommandHeader), Alignment);
+		const std::size_t BlockSize = AlignUp(PayloadOffset + Size, alignof(FCommandHeader));
+		uint8_t* Block = AllocateFromPage(BlockSize, std::max(Alignment, alignof(FCommandHeader)));
+
+		FCommandHeader* Header = new (Block) FCommandHeader();
+		Header->Command = RenderCommand;
+		Header->Destroy = Destroy;
+		Header->PayloadOffset = static_cast<uint32_t>(PayloadOffset);
 
-			RenderCommand(TargetBuf);
-			TargetBuf += Size;
+		Statistics.CommandCount++;
+		Statistics.BytesUsed += BlockSize;
+		Statistics.HighWater = std::max(Statistics.HighWater, Statistics.BytesUsed);
+
+		return Block + PayloadOffset;
+	}
+
+	uint8_t* CRenderCommandQueue::AllocateFromPage(const std::size_t Size, const std::size_t Alignment)
+	{
+		FPage* Page = &Pages[PageIndex];
+		std::size_t Offset = AlignUp(Page->Used, Alignment);
+		if ((Offset + Size) > Page->Size)
+		{
+			/* Continue on the next page, a page that is too small for the block is replaced by a new one in front of it. */
+			PageIndex++;
+			if ((PageIndex == Pages.size()) || (Pages[PageIndex].Size < Size))
+			{
+				AddPage(PageIndex, Size);
+			}
+			Page = &Pages[PageIndex];
+			Offset = 0;
+			LastCommandOffset = NO_COMMAND;
 		}
 
-		CommandBufferPtr = TargetBuf;
-		CommandCount = 0;
+		/* Link the previous command of the page to this one. */
+		if (LastCommandOffset != NO_COMMAND)
+		{
+			FCommandHeader* Header = reinterpret_cast<FCommandHeader*>(Page->Memory + LastCommandOffset);
+			Header->Next = static_cast<uint32_t>(Offset - LastCommandOffset);
+		}
+		LastCommandOffset = Offset;
+
+		LK_ASSERT((Offset + Size) <= Page->Size, "Command of {} bytes does not fit its page", Size);
+		Page->Used = Offset + Size;
+		return Page->Memory + Offset;
 	}
 
-	void* CRenderCommandQueue::Allocate(FRenderCommand RenderCommand, const uint32_t Size)
+	void CRenderCommandQueue::AddPage(const std::size_t Index, const std::size_t MinSize)
 	{
-		/*
-		  +----------------+-----------------+--------------+
-		  | Render Command | Size (uint32_t) | Command data | 
-		  +----------------+-----------------+--------------+
-		 */
-		//*reinterpret_cast<FRenderCommand*>(CommandBufferPtr) = RenderCommand;
-		*(FRenderCommand*)CommandBufferPtr = RenderCommand;
-		CommandBufferPtr += sizeof(FRenderCommand);
+		FPage Page;
+		Page.Size = std::max(PageSize, AlignUp(MinSize, PAGE_ALIGNMENT));
+		Page.Memory = static_cast<uint8_t*>(::operator new(Page.Size, std::align_val_t(PAGE_ALIGNMENT)));
+		Pages.insert(Pages.begin() + Index, Page);
 
-		//*reinterpret_cast<uint32_t*>(CommandBufferPtr) = Size;
-		*(uint32_t*)(CommandBufferPtr) = Size;
-		CommandBufferPtr += sizeof(uint32_t);
+		Statistics.PageCount = static_cast<uint32_t>(Pages.size());
+		Statistics.BytesReserved += Page.Size;
+		LK_TRACE_TAG("RenderCommandQueue", "Added page {} ({} bytes, {} reserved)", Index, Page.Size, Statistics.BytesReserved);
+	}
 
-		void* MemPtr = CommandBufferPtr;
-		CommandBufferPtr += Size;
-		CommandCount++;
+	void CRenderCommandQueue::Shrink()
+	{
+		/**
+		 * Pages no frame reached during the interval are released, such as the pages of a
+		 * burst or one sized for a single large command. One spare page of the default size
+		 * is kept so a frame slightly larger than usual does not allocate.
+		 */
+		bool bSpare = false;
+		std::size_t Released = 0;
+		std::erase_if(Pages, [&](FPage& Page)
+		{
+			const bool bKeep = Page.bNeeded || (!bSpare && (Page.Size == PageSize));
+			bSpare = bSpare || (!Page.bNeeded && bKeep);
+			Page.bNeeded = false;
+			if (bKeep)
+			{
+				return false;
+			}
+
+			Statistics.BytesReserved -= Page.Size;
+			::operator delete(Page.Memory, std::align_val_t(PAGE_ALIGNMENT));
+			Released++;
+			return true;
+		});
 
-		return MemPtr;
+		if (Released > 0)
+		{
+			Statistics.PagesReleased += static_cast<uint32_t>(Released);
+			LK_DEBUG_TAG("RenderCommandQueue", "Released {} pages, {} bytes reserved", Released, Statistics.BytesReserved);
+		}
+		Statistics.PageCount = static_cast<uint32_t>(Pages.size());
+		ExecutionCount = 0;
 	}
 
-}
\ No newline at end of file
+}
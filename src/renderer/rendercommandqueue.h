@@ -1,24 +1,126 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/core.h"
 
 namespace platformer2d {
 
+	struct FRenderCommandQueueStatistics
+	{
+		uint32_t CommandCount = 0;   /* Commands recorded since the last execution. */
+		std::size_t BytesUsed = 0;   /* Bytes recorded since the last execution, padding included. */
+		std::size_t HighWater = 0;   /* Most bytes recorded in a single frame since the queue was created. */
+		std::size_t BytesReserved = 0;
+		uint32_t PageCount = 0;
+		uint32_t PagesReleased = 0;  /* Pages freed by the shrink policy since the queue was created. */
+	};
+
+	/**
+	 * @brief Commands recorded on one thread and executed in order, possibly on another.
+	 *
+	 * Commands are written to a list of aligned pages. Pages are allocated when a
+	 * frame needs more than the queue has and are reused by the next frame after
+	 * execution. A command larger than a page gets a page of its own size.
+	 * Pages that were not needed during the last SHRINK_INTERVAL executions are released.
+	 */
 	class CRenderCommandQueue
 	{
 	public:
 		using FRenderCommand = void(*)(void*);
 
-		CRenderCommandQueue();
+		static constexpr std::size_t PAGE_SIZE = 64 * 1024;
+		static constexpr std::size_t PAGE_ALIGNMENT = 64;
+		static constexpr uint32_t SHRINK_INTERVAL = 240; /* Executions. */
+
+		CRenderCommandQueue(std::size_t InPageSize = PAGE_SIZE);
 		~CRenderCommandQueue();
 
 		void Execute();
-		void* Allocate(FRenderCommand RenderCommand, uint32_t Size);
+
+		/**
+		 * @brief Record a command.
+		 * @param Alignment Alignment of the payload, a power of two of at most PAGE_ALIGNMENT.
+		 * @return Payload of Size bytes, passed to the command when it is executed.
+		 */
+		void* Allocate(FRenderCommand RenderCommand, uint32_t Size, std::size_t Alignment = alignof(std::max_align_t),
+					   FRenderCommand Destroy = nullptr);
+
+		/**
+		 * @brief Record a function object, constructed in place in the command buffer.
+		 *
+		 * The closure is invoked where it was written and destroyed right after.
+		 * Closures the queue is destroyed with are destroyed without being invoked.
+		 * Captures are stored by value, captured containers still own their heap memory,
+		 * capture pointers or small trivially copyable values instead.
+		 */
+		template<typename TFunction>
+		void Submit(TFunction&& Function)
+		{
+			using FClosure = std::decay_t<TFunction>;
+			static_assert(std::is_invocable_v<FClosure&>, "Submitted functions take no arguments");
+			static_assert(alignof(FClosure) <= PAGE_ALIGNMENT, "Closure alignment exceeds the page alignment");
+			static_assert(sizeof(FClosure) < PAGE_SIZE, "Closure does not fit a page");
+
+			FRenderCommand Destroy = nullptr;
+			if constexpr (!std::is_trivially_destructible_v<FClosure>)
+			{
+				Destroy = [](void* Payload) { std::destroy_at(static_cast<FClosure*>(Payload)); };
+			}
+
+			void* Payload = Allocate([](void* Payload)
+			{
+				FClosure& Closure = *std::launder(static_cast<FClosure*>(Payload));
+				Closure();
+				if constexpr (!std::is_trivially_destructible_v<FClosure>)
+				{
+					std::destroy_at(&Closure);
+				}
+			}, static_cast<uint32_t>(sizeof(FClosure)), alignof(FClosure), Destroy);
+			::new (Payload) FClosure(std::forward<TFunction>(Function));
+		}
+
+		FORCEINLINE bool IsEmpty() const { return (Statistics.CommandCount == 0); }
+		FORCEINLINE const FRenderCommandQueueStatistics& GetStatistics() const { return Statistics; }
+
+	private:
+		static constexpr std::size_t NO_COMMAND = static_cast<std::size_t>(-1);
+
+		struct FPage
+		{
+			uint8_t* Memory = nullptr;
+			std::size_t Size = 0;
+			std::size_t Used = 0;
+			bool bNeeded = false; /* Written to during the current shrink interval. */
+		};
+
+		uint8_t* AllocateFromPage(std::size_t Size, std::size_t Alignment);
+
+		/**
+		 * @brief Invoke a function on every recorded command and reset the pages.
+		 */
+		template<typename TFunction>
+		void ForEachCommand(TFunction&& Function);
+		void AddPage(std::size_t Index, std::size_t MinSize);
+		void Shrink();
+
+		CRenderCommandQueue(const CRenderCommandQueue&) = delete;
+		CRenderCommandQueue& operator=(const CRenderCommandQueue&) = delete;
 
 	private:
-		uint8_t* CommandBuffer = nullptr;
-		uint8_t* CommandBufferPtr = nullptr;
-		uint32_t CommandCount = 0;
+		std::vector<FPage> Pages;
+		std::size_t PageIndex = 0; /* Page currently written to. */
+		std::size_t LastCommandOffset = NO_COMMAND; /* Last command on the current page, linked to the next one. */
+		std::size_t PageSize = PAGE_SIZE;
+		uint32_t ExecutionCount = 0; /* Executions since the last shrink. */
+
+		FRenderCommandQueueStatistics Statistics{};
 	};
 
-}
\ No newline at end of file
+}
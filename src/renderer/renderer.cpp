@@ -1,5 +1,6 @@
 #include "renderer.h"
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 
@@ -17,20 +18,32 @@
 
 #include "core/window.h"
 #include "backendinfo.h"
+#include "circletable.h"
+#include "cookedtexture.h"
 #include "debugrenderer.h"
+#include "framebuffer.h"
 #include "imguilayer.h"
 #include "opengl.h"
+#include "opengl_null.h"
+#include "quadkernel.h"
 #include "rendercommandqueue.h"
+#include "renderthread.h"
+#include "shadercache.h"
 #include "ui/ui.h"
 #include "asset/assetmanager.h"
 #include "scene/effectmanager.h"
 
 namespace platformer2d {
 
-	namespace
+	struct FRenderLayerTarget
 	{
-		constexpr int CIRCLE_SEGMENTS = 32;
-	}
+		FRenderLayerSpecification Specification{};
+		std::unique_ptr<CFramebuffer> Framebuffer = nullptr;
+		glm::mat4 ViewProjection = glm::mat4(1.0f); /* Camera the framebuffer content was drawn with. */
+		glm::vec2 Margin = glm::vec2(0.0f);         /* Pixels drawn outside the viewport on each side. */
+		glm::uvec2 Size = glm::uvec2(0);            /* Size of the framebuffer, known before the render thread creates it. */
+		bool bValid = false;
+	};
 
 	struct FRendererData
 	{
@@ -38,6 +51,20 @@ namespace platformer2d {
 		uint16_t RefreshRate = 0;
 		std::shared_ptr<CTexture> WhiteTexture = nullptr;
 		std::unordered_map<ETexture, std::shared_ptr<CTexture>> Textures;
+		std::unique_ptr<CTextureArray> TextureArray = nullptr;
+		FViewBounds View{};
+		float PixelsPerUnit = 0.0f; /* Zero until a scene is started. */
+
+		std::array<FRenderLayerTarget, static_cast<std::size_t>(ERenderLayer::COUNT)> Layers;
+		struct
+		{
+			bool bActive = false;
+			bool bDrawing = false; /* False if a cached layer is reused. */
+			ERenderLayer Layer = ERenderLayer::World;
+			ERenderLayer PreviousLayer = ERenderLayer::World;
+			glm::mat4 ViewProjection = glm::mat4(1.0f); /* Camera of the scene, restored when the layer ends. */
+			FViewBounds View{};
+		} ActiveLayer;
 
 		struct
 		{
@@ -55,15 +82,38 @@ namespace platformer2d {
 		constexpr uint32_t MaxLines = 1000;
 		constexpr uint32_t MaxVertices = MaxQuads * 4;
 		constexpr uint32_t MaxIndices = MaxQuads * 6;
+		constexpr uint32_t MaxQuadInstances = 65536;
 		constexpr uint32_t MaxLineVertices = MaxLines * 2;
 		constexpr uint32_t MaxLineIndices = MaxLines * 6;
+		constexpr uint32_t TextureArrayUnit = 0;
+		constexpr uint32_t CompositeTextureUnit = 1;
 
 		FRendererData Data{};
 		FDrawStatistics DrawStats;
+		FDrawStatistics LastFrameDrawStats;
+		CDrawList DrawList;
+		CDrawRecorder DrawRecorder;
 
 		std::array<CRenderCommandQueue*, 2> CommandQueue;
 		std::atomic<uint32_t> CommandQueueSubmissionIndex = 0;
 
+		/* Render thread, see FRendererSpecification::bRenderThread. */
+		std::unique_ptr<CRenderThread> RenderThread = nullptr;
+		FDrawStatistics RecordedFrameStats; /* Main thread statistics of the frame the render thread executes. */
+		FDrawStatistics RenderThreadStats;  /* Written by the render thread only. */
+		FDrawStatistics RenderedFrameStats; /* Render thread statistics of the last executed frame. */
+		CTimer RenderThreadTimer;
+		std::array<std::vector<std::unique_ptr<CDrawList>>, 2> SubmittedDrawLists; /* Per command queue. */
+		std::array<uint32_t, 2> SubmittedDrawListCount{};
+		std::array<CImGuiDrawSnapshot, 2> ImGuiDrawSnapshots;
+
+		/* Followed by the quads in the command queue. */
+		struct FStaticBatchUpload
+		{
+			FStaticBatchBuffers* Buffers = nullptr;
+			uint64_t QuadCount = 0;
+		};
+
 		constexpr glm::vec2 QuadTextureCoords[] = {
 			{ 0.0f, 0.0f }, /*  Bottom Left.  */
 			{ 0.0f, 1.0f }, /*  Top Left.     */
@@ -72,50 +122,216 @@ namespace platformer2d {
 		};
 	}
 
-	FORCEINLINE static void BindTextures()
+	CRenderCommandQueue& CRenderer::GetSubmissionQueue()
 	{
-		for (auto& [Texture, TextureRef] : Data.Textures)
+		return *CommandQueue[CommandQueueSubmissionIndex];
+	}
+
+	/**
+	 * @brief Statistics written by render commands.
+	 * Kept apart with a render thread, the main thread is already recording the next frame.
+	 */
+	FORCEINLINE static FDrawStatistics& GetRenderStats()
+	{
+		return RenderThread ? RenderThreadStats : DrawStats;
+	}
+
+	/**
+	 * @brief Draw list handed over to the render thread, reused once the queue it was submitted with has been executed.
+	 */
+	static CDrawList& AcquireDrawList()
+	{
+		const uint32_t SubmissionIndex = CommandQueueSubmissionIndex;
+		std::vector<std::unique_ptr<CDrawList>>& DrawLists = SubmittedDrawLists[SubmissionIndex];
+		uint32_t& Count = SubmittedDrawListCount[SubmissionIndex];
+		if (Count == DrawLists.size())
 		{
-			if (TextureRef != nullptr)
+			DrawLists.push_back(std::make_unique<CDrawList>());
+		}
+
+		return *DrawLists[Count++];
+	}
+
+	FORCEINLINE static bool IsTextureTranslucent(const uint32_t Slot)
+	{
+		const auto Iter = Data.Textures.find(static_cast<ETexture>(Slot));
+		return (Iter != Data.Textures.end()) && Iter->second && Iter->second->IsTranslucent();
+	}
+
+	/**
+	 * @brief Half extent of the axis-aligned box enclosing a rotated quad.
+	 * Rotated quads use the half diagonal, which holds for any angle and needs no sine or cosine.
+	 */
+	FORCEINLINE static glm::vec2 GetQuadHalfExtent(const glm::vec2& Size, const float RotationRad)
+	{
+		const glm::vec2 HalfSize = glm::abs(Size) * 0.50f;
+		return (RotationRad == 0.0f) ? HalfSize : glm::vec2(glm::length(HalfSize));
+	}
+
+	/**
+	 * @brief Test a primitive against the view and count it as submitted or culled.
+	 */
+	FORCEINLINE static bool IsInView(const glm::vec2& Center, const glm::vec2& HalfExtent)
+	{
+		const bool bVisible = Data.View.Overlaps(Center, HalfExtent);
+		if (CDrawRecorder::FContext* Context = CDrawRecorder::GetThreadContext(); Context != nullptr)
+		{
+			bVisible ? Context->Counts.Submitted++ : Context->Counts.Culled++;
+		}
+		else
+		{
+			bVisible ? DrawStats.SubmittedCount++ : DrawStats.CulledCount++;
+		}
+
+		return bVisible;
+	}
+
+	FORCEINLINE static void SetViewBounds(const FViewBounds& Bounds)
+	{
+		Data.View = Bounds;
+		const float ViewHeight = Bounds.Max.y - Bounds.Min.y;
+		const CWindow* Window = CWindow::Get();
+		Data.PixelsPerUnit = ((Window != nullptr) && (ViewHeight > 0.0f)) ? (Window->GetHeight() / ViewHeight) : 0.0f;
+	}
+
+	/**
+	 * @brief Bounds of the world-space region that maps to clip space.
+	 */
+	static FViewBounds ComputeViewBounds(const glm::mat4& ViewProjection)
+	{
+		const glm::mat4 InverseViewProjection = glm::inverse(ViewProjection);
+		FViewBounds Bounds{ .Min = glm::vec2(std::numeric_limits<float>::max()), .Max = glm::vec2(std::numeric_limits<float>::lowest()) };
+		for (const float X : { -1.0f, 1.0f })
+		{
+			for (const float Y : { -1.0f, 1.0f })
+			{
+				for (const float Z : { -1.0f, 1.0f })
+				{
+					const glm::vec4 Corner = InverseViewProjection * glm::vec4(X, Y, Z, 1.0f);
+					const glm::vec2 WorldPos = glm::vec2(Corner) / Corner.w;
+					Bounds.Min = glm::min(Bounds.Min, WorldPos);
+					Bounds.Max = glm::max(Bounds.Max, WorldPos);
+				}
+			}
+		}
+
+		return Bounds;
+	}
+
+	/**
+	 * @brief Camera translation in pixels since the content of a layer was drawn.
+	 */
+	static glm::vec2 GetLayerShift(const FRenderLayerTarget& Target, const glm::mat4& ViewProjection, const glm::vec2& ViewportSize)
+	{
+		return (glm::vec2(ViewProjection[3]) - glm::vec2(Target.ViewProjection[3])) * (ViewportSize * 0.50f);
+	}
+
+	/**
+	 * @brief Whether the cached content of a layer can be reused with the current camera.
+	 * Only a translation within the threshold is covered by the margin, anything else needs a redraw.
+	 */
+	static bool IsLayerCacheValid(const FRenderLayerTarget& Target, const glm::mat4& ViewProjection, const glm::vec2& ViewportSize)
+	{
+		static constexpr float Epsilon = 1e-6f;
+		for (int Col = 0; Col < 3; Col++)
+		{
+			if (glm::any(glm::greaterThan(glm::abs(ViewProjection[Col] - Target.ViewProjection[Col]), glm::vec4(Epsilon))))
 			{
-				TextureRef->Bind(static_cast<uint32_t>(Texture));
+				return false;
 			}
 		}
+		if (glm::any(glm::greaterThan(glm::abs(glm::vec2(ViewProjection[3].z, ViewProjection[3].w)
+											   - glm::vec2(Target.ViewProjection[3].z, Target.ViewProjection[3].w)), glm::vec2(Epsilon))))
+		{
+			return false;
+		}
+
+		const glm::vec2 Shift = GetLayerShift(Target, ViewProjection, ViewportSize);
+		return glm::all(glm::lessThanEqual(glm::abs(Shift), glm::vec2(Target.Specification.CacheThreshold)));
 	}
 
-	void CRenderer::Initialize()
+	void CRenderer::Initialize(const FRendererSpecification& InSpecification)
 	{
 		LK_VERIFY(bInitialized == false, "Initialize called multiple times");
-		const GLenum GladInitResult = gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
-		LK_OpenGL_Verify(glEnable(GL_BLEND));
+		Specification = InSpecification;
+		const bool bNullBackend = (Specification.Backend == ERenderBackend::Null);
+		const int GladInitResult = bNullBackend ? OpenGL::Null::Load() : gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+		LK_VERIFY(GladInitResult, "Failed to load OpenGL functions");
+		SetBlending(true);
 		SetBlendFunction(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 		SetDepthTest(true);
 		SetDepthFunction(GL_LESS);
-		LK_OpenGL_Verify(glEnable(GL_LINE_SMOOTH));
+		OpenGL::State::SetEnabled(GL_LINE_SMOOTH, true);
 
 		OpenGL::LoadInfo(BackendInfo);
-		LK_INFO("OpenGL {}.{}", BackendInfo.Version.Major, BackendInfo.Version.Minor);
-#ifdef LK_BUILD_DEBUG
-		OpenGL::Internal::SetupDebugContext(nullptr);
+		BackendInfo.Backend = Specification.Backend;
+		LK_INFO("OpenGL {}.{} ({})", BackendInfo.Version.Major, BackendInfo.Version.Minor, Enum::ToString(BackendInfo.Backend));
+
+		/* There is no driver to report errors. */
+		if (bNullBackend)
+		{
+			Specification.ErrorCheck = EOpenGLErrorCheck::None;
+		}
+
+#ifndef LK_OPENGL_ERROR_CHECK
+		if ((Specification.ErrorCheck == EOpenGLErrorCheck::Full) || (Specification.ErrorCheck == EOpenGLErrorCheck::Sampled))
+		{
+			LK_WARN_TAG("Renderer", "OpenGL error checks are not compiled in, using the debug callback only");
+			Specification.ErrorCheck = EOpenGLErrorCheck::DebugCallback;
+		}
 #endif
+		OpenGL::SetErrorCheck(Specification.ErrorCheck, Specification.ErrorCheckInterval);
+		if (Specification.ErrorCheck != EOpenGLErrorCheck::None)
+		{
+			OpenGL::Internal::SetupDebugContext(nullptr);
+		}
+		LK_INFO_TAG("Renderer", "OpenGL error check: {}", Enum::ToString(Specification.ErrorCheck));
+
+		if (Specification.VertexUploadMode == EVertexUploadMode::PersistentMapped)
+		{
+			const bool bBufferStorage = ((BackendInfo.Version.Major > 4) || ((BackendInfo.Version.Major == 4) && (BackendInfo.Version.Minor >= 4)))
+				|| std::ranges::contains(BackendInfo.Extensions, "GL_ARB_buffer_storage");
+			if (!bBufferStorage)
+			{
+				LK_WARN_TAG("Renderer", "Buffer storage not supported, falling back to BufferSubData uploads");
+				Specification.VertexUploadMode = EVertexUploadMode::BufferSubData;
+			}
+		}
+		LK_INFO_TAG("Renderer", "Quad render path: {}", (Specification.QuadRenderPath == EQuadRenderPath::Instanced) ? "Instanced" : "Batched");
+		if (Specification.QuadRenderPath == EQuadRenderPath::Batched)
+		{
+			LK_INFO_TAG("Renderer", "Quad vertex format: {}", (Specification.QuadVertexFormat == EQuadVertexFormat::Packed) ? "Packed" : "Full");
+		}
+		LK_INFO_TAG("Renderer", "Vertex upload: {}", (Specification.VertexUploadMode == EVertexUploadMode::PersistentMapped)
+					? "Persistent mapped" : "BufferSubData");
+
+		LK_VERIFY(std::has_single_bit(Specification.CircleSegmentsMin) && std::has_single_bit(Specification.CircleSegmentsMax)
+				  && (Specification.CircleSegmentsMin >= CircleTable::MIN_SEGMENTS)
+				  && (Specification.CircleSegmentsMax <= CircleTable::MAX_SEGMENTS)
+				  && (Specification.CircleSegmentsMin <= Specification.CircleSegmentsMax),
+				  "Invalid circle segment range: {}-{}", Specification.CircleSegmentsMin, Specification.CircleSegmentsMax);
 
 		for (int Idx = 0; Idx < CommandQueue.size(); Idx++)
 		{
 			CommandQueue[Idx] = new CRenderCommandQueue();
 		}
 
+		if (Specification.bShaderCache)
+		{
+			CShaderCache::Initialize(BackendInfo);
+		}
+
 		SetupQuadRenderer();
 		SetupLineRenderer();
 		SetupCircleRenderer();
+		SetupCompositeRenderer();
+		GpuTimer = std::make_unique<CGpuTimer>(Specification.FramesInFlight);
 
 		LoadTextures();
 		LK_INFO_TAG("Renderer", "Loaded {} textures", Data.Textures.size());
 
-		QuadShader->Bind();
-		BindTextures();
-
 		/* @todo Move the ImGui layer to CWindow, or keep here? */
-		ImGuiLayer = std::make_unique<CImGuiLayer>(CWindow::Get()->GetGlfwWindow());
+		ImGuiLayer = std::make_unique<CImGuiLayer>(bNullBackend ? nullptr : CWindow::Get()->GetGlfwWindow(), Specification.bRenderThread);
 		Data.RefreshRate = CWindow::Get()->GetRefreshRate();
 		LK_VERIFY(Data.RefreshRate > 0, "Failed to get window refresh rate");
 
@@ -125,29 +341,62 @@ namespace platformer2d {
 #endif
 
 		UI::Initialize();
+
+		if (Specification.bRenderThread)
+		{
+			/* Everything above ran with the context on this thread, from here on only the render thread uses it. */
+			CWindow::Get()->ReleaseContext();
+			RenderThread = std::make_unique<CRenderThread>(CWindow::Get());
+			LK_INFO_TAG("Renderer", "Render thread enabled");
+		}
 		bInitialized = true;
 	}
 
 	void CRenderer::Destroy()
 	{
+		if (RenderThread)
+		{
+			/* Commands recorded after the last frame, such as released static batches, still need to run. */
+			RenderThread->Kick(GetSubmissionQueue());
+			RenderThread.reset();
+			CWindow::Get()->MakeContextCurrent();
+			for (CImGuiDrawSnapshot& Snapshot : ImGuiDrawSnapshots)
+			{
+				Snapshot.Clear();
+			}
+		}
+
+		TextureLoader.reset();
 		Data.WhiteTexture = nullptr;
+		Data.TextureArray.reset();
 		for (auto& [Texture, TextureRef] : Data.Textures)
 		{
 			if (TextureRef != nullptr)
 			{
 				LK_TRACE_TAG("Renderer", "Release: {}", Enum::ToString(Texture));
-				TextureRef->Unbind();
 				TextureRef.reset();
 			}
 		}
 
+		for (FRenderLayerTarget& Target : Data.Layers)
+		{
+			Target.Framebuffer.reset();
+			Target.bValid = false;
+		}
+
+		QuadVertexStream.reset();
+		LineVertexStream.reset();
+		CircleVertexStream.reset();
+		GpuTimer.reset();
+		CShaderCache::Destroy();
+
 		ImGuiLayer->Destroy();
 		ImGuiLayer.release();
 	}
 
-	void CRenderer::SetupQuadRenderer()
+	const FVertexBufferLayout& CRenderer::GetQuadLayout()
 	{
-		const FVertexBufferLayout QuadLayout = {
+		static const FVertexBufferLayout QuadLayout = {
 			{ "pos",        EShaderDataType::Float3, },
 			{ "color",      EShaderDataType::Float4, },
 			{ "texcoord",   EShaderDataType::Float2, },
@@ -155,10 +404,49 @@ namespace platformer2d {
 			{ "tilefactor", EShaderDataType::Float,  },
 		};
 
+		static const FVertexBufferLayout QuadPackedLayout = {
+			{ "pos",          EShaderDataType::Float3,  },
+			{ "color",        EShaderDataType::UByte4,  true },
+			{ "texcoord",     EShaderDataType::UShort2, true },
+			{ "texindextile", EShaderDataType::UInt,    },
+		};
+		static_assert(sizeof(FQuadVertexPacked) == (4 * 3) + 4 + (2 * 2) + 4);
+
+		static const FVertexBufferLayout QuadInstanceLayout = {
+			{ "transform", EShaderDataType::Float4,  false, 1 },
+			{ "size",      EShaderDataType::Float2,  false, 1 },
+			{ "texcoords", EShaderDataType::UShort4, true,  1 },
+			{ "color",     EShaderDataType::UByte4,  true,  1 },
+			{ "texindex",  EShaderDataType::UInt,    false, 1 },
+		};
+		static_assert(sizeof(FQuadInstance) == (4 * 4) + (4 * 2) + (2 * 4) + 4 + 4);
+
+		if (Specification.QuadRenderPath == EQuadRenderPath::Instanced)
+		{
+			return QuadInstanceLayout;
+		}
+
+		return (Specification.QuadVertexFormat == EQuadVertexFormat::Packed) ? QuadPackedLayout : QuadLayout;
+	}
+
+	void CRenderer::SetupQuadRenderer()
+	{
+		std::size_t StreamSize = MaxVertices * sizeof(FQuadVertex);
+		if (Specification.QuadRenderPath == EQuadRenderPath::Instanced)
+		{
+			StreamSize = MaxQuadInstances * sizeof(FQuadInstance);
+		}
+		else if (Specification.QuadVertexFormat == EQuadVertexFormat::Packed)
+		{
+			StreamSize = MaxVertices * sizeof(FQuadVertexPacked);
+		}
+
 		QuadVAO = OpenGL::VertexArray::Create();
-		QuadVBO = OpenGL::VertexBuffer::Create(MaxVertices * sizeof(FQuadVertex), QuadLayout);
+		QuadVertexStream = std::make_unique<CStreamBuffer>(StreamSize, Specification.VertexUploadMode, Specification.FramesInFlight);
+		OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, QuadVertexStream->GetID());
+		OpenGL::ApplyVertexBufferLayout(GetQuadLayout());
 
-		QuadVertexBufferBase = new FQuadVertex[MaxVertices];
+		/* Created for both paths as the circle renderer shares the index buffer. */
 		uint32_t* QuadIndices = new uint32_t[MaxIndices];
 		LK_VERIFY(QuadIndices, "Failed to alloc QuadIndices on the heap");
 		uint32_t Offset = 0;
@@ -180,10 +468,23 @@ namespace platformer2d {
 		QuadEBO = OpenGL::ElementBuffer::Create(QuadIndices, MaxIndices * sizeof(uint32_t));
 		delete[] QuadIndices;
 
-		QuadVertexBufferPtr = QuadVertexBufferBase;
-		LK_VERIFY(QuadVertexBufferPtr);
+		ResetBatch(CShader::EType::Quad);
 
-		QuadShader = std::make_shared<CShader>(SHADERS_DIR "/quad.shader");
+		if (Specification.QuadRenderPath == EQuadRenderPath::Instanced)
+		{
+			LK_VERIFY(QuadInstanceBufferPtr);
+			QuadShader = std::make_shared<CShader>(SHADERS_DIR "/quad_instanced.shader");
+		}
+		else if (Specification.QuadVertexFormat == EQuadVertexFormat::Packed)
+		{
+			LK_VERIFY(QuadPackedVertexBufferPtr);
+			QuadShader = std::make_shared<CShader>(SHADERS_DIR "/quad_packed.shader");
+		}
+		else
+		{
+			LK_VERIFY(QuadVertexBufferPtr);
+			QuadShader = std::make_shared<CShader>(SHADERS_DIR "/quad.shader");
+		}
 
 		CameraData.ViewProjection = glm::mat4(1.0f);
 		CameraUniformBuffer = std::make_unique<CUniformBuffer>(sizeof(FCameraData));
@@ -199,8 +500,10 @@ namespace platformer2d {
 		};
 
 		LineVAO = OpenGL::VertexArray::Create();
-		LineVBO = OpenGL::VertexBuffer::Create(MaxVertices * sizeof(FLineVertex), LineLayout);
-		LineVertexBufferBase = new FLineVertex[MaxVertices];
+		LineVertexStream = std::make_unique<CStreamBuffer>(MaxLineIndices * sizeof(FLineVertex),
+														   Specification.VertexUploadMode, Specification.FramesInFlight);
+		OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, LineVertexStream->GetID());
+		OpenGL::ApplyVertexBufferLayout(LineLayout);
 
 		uint32_t* LineIndices = new uint32_t[MaxLineIndices];
 		for (uint32_t Idx = 0; Idx < MaxLineIndices; Idx++)
@@ -210,7 +513,7 @@ namespace platformer2d {
 		LineEBO = OpenGL::ElementBuffer::Create(LineIndices, MaxLineIndices * sizeof(uint32_t));
 		delete[] LineIndices;
 
-		LineVertexBufferPtr = LineVertexBufferBase;
+		ResetBatch(CShader::EType::Line);
 		LK_VERIFY(LineVertexBufferPtr);
 
 		LineShader = std::make_shared<CShader>(SHADERS_DIR "/line.shader");
@@ -227,21 +530,32 @@ namespace platformer2d {
 		};
 
 		CircleVAO = OpenGL::VertexArray::Create();
-		CircleVBO = OpenGL::VertexBuffer::Create(MaxVertices * sizeof(FQuadVertex), CircleLayout);
+		CircleVertexStream = std::make_unique<CStreamBuffer>(MaxVertices * sizeof(FCircleVertex),
+															 Specification.VertexUploadMode, Specification.FramesInFlight);
+		OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, CircleVertexStream->GetID());
+		OpenGL::ApplyVertexBufferLayout(CircleLayout);
 
-		CircleVertexBufferBase = new FCircleVertex[MaxVertices];
 		/**
 		 * Re-use the quad EBO as the rendering of filled circles use
 		 * triangles in segments.
 		 */
-		LK_OpenGL_Verify(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadEBO));
+		OpenGL::State::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadEBO);
 
 		CircleShader = std::make_shared<CShader>(SHADERS_DIR "/circle.shader");
 
-		CircleVertexBufferPtr = CircleVertexBufferBase;
+		ResetBatch(CShader::EType::Circle);
 		LK_VERIFY(CircleVertexBufferPtr);
 	}
 
+	void CRenderer::SetupCompositeRenderer()
+	{
+		/* The fullscreen quad is generated from gl_VertexID, the vertex array has no attributes. */
+		CompositeVAO = OpenGL::VertexArray::Create();
+		CompositeShader = std::make_shared<CShader>(SHADERS_DIR "/composite.shader");
+		CompositeShader->Set("u_texture", static_cast<int>(CompositeTextureUnit));
+		CompositeRectUniform = CompositeShader->GetUniform("u_rect");
+	}
+
 	void CRenderer::LoadTextures()
 	{
 		LK_VERIFY(QuadShader, "QuadShader not initialized");
@@ -258,6 +572,9 @@ namespace platformer2d {
 				.Format = Format,
 				.SamplerWrap = ETextureWrap::Clamp,
 				.SamplerFilter = ETextureFilter::Nearest,
+				/* The white texture is the placeholder of the others. */
+				.bAsync = (Specification.bAsyncTextureLoading && (Texture != ETexture::White)),
+				.bArrayBacked = true,
 			};
 			if (Size.x > 0.0f)
 			{
@@ -268,6 +585,25 @@ namespace platformer2d {
 				Spec.Height = Size.y;
 			}
 
+			/*
+			 * A cooked texture is only mapped and uploaded, there is nothing left to load asynchronously.
+			 * The texture array holds RGBA8 mip 0 only, block compressed files are decoded from the source instead.
+			 */
+			if (CookedTexture::IsAvailable(Path))
+			{
+				const std::filesystem::path CookedPath = CookedTexture::GetPath(Path);
+				CCookedTexture Cooked;
+				if (Cooked.Open(CookedPath) && (Cooked.GetHeader().Format == ECookedTextureFormat::RGBA8))
+				{
+					Spec.Path = CookedPath.string();
+					Spec.bAsync = false;
+				}
+				else
+				{
+					LK_WARN_TAG("Renderer", "Ignoring {}, textures of the texture array must be cooked as rgba8", CookedPath.filename());
+				}
+			}
+
 			Data.Textures.emplace(std::make_pair(Texture, std::make_shared<CTexture>(Spec)));
 		};
 
@@ -280,15 +616,67 @@ namespace platformer2d {
 		LoadTexture(TEXTURES_DIR "/swoosh.png", ETexture::Swoosh, EImageFormat::RGBA8);
 		LoadTexture(TEXTURES_DIR "/cloud-1.png", ETexture::Cloud, EImageFormat::RGBA8);
 
-		/* Bind every texture. */
-		for (auto& [Texture, TextureRef] : Data.Textures)
+		/*
+		 * Every texture is packed into a region of the texture array so all of them are
+		 * sampled through a single binding. The layers are sized after the largest texture.
+		 */
+		const int TextureCount = static_cast<int>(Data.Textures.size());
+		LK_VERIFY(TextureCount <= MAX_ARRAY_TEXTURES, "Too many textures: {}", TextureCount);
+		std::vector<glm::uvec2> Sizes(TextureCount);
+		glm::uvec2 LayerSize(1, 1);
+		for (int Idx = 0; Idx < TextureCount; Idx++)
 		{
+			const ETexture Texture = static_cast<ETexture>(Idx);
+			LK_VERIFY(Data.Textures.contains(Texture), "Texture slots are not contiguous, missing {}", Idx);
+			const std::shared_ptr<CTexture>& TextureRef = Data.Textures[Texture];
 			LK_VERIFY(TextureRef, "Invalid texture reference: {}", Enum::ToString(Texture));
-			const int Idx = static_cast<int>(Texture);
-			QuadShader->Set(std::format("u_texture{}", Idx), Idx);
-			TextureRef->Bind(Idx);
+			Sizes[Idx] = glm::uvec2(TextureRef->GetWidth(), TextureRef->GetHeight());
+			LayerSize = glm::max(LayerSize, Sizes[Idx]);
+		}
+
+		const std::vector<FTextureRegion> Regions = CTextureArray::Pack(Sizes, LayerSize);
+		uint32_t Layers = 0;
+		for (const FTextureRegion& Region : Regions)
+		{
+			Layers = std::max(Layers, Region.Layer + 1);
+		}
+
+		if (Specification.bAsyncTextureLoading)
+		{
+			TextureLoader = std::make_unique<CTextureLoader>(Specification.TextureUploadBudget, Specification.VertexUploadMode,
+															 Specification.FramesInFlight);
+		}
+
+		Data.TextureArray = std::make_unique<CTextureArray>(FTextureArraySpecification{
+			.ImageFormat = EImageFormat::RGBA8,
+			.Layers = static_cast<uint16_t>(Layers),
+			.Width = LayerSize.x,
+			.Height = LayerSize.y,
+			.DebugName = "QuadTextures",
+		});
+		LK_INFO_TAG("Renderer", "Texture array: {} textures on {} layers of {}x{} ({} KiB)", TextureCount, Layers,
+					LayerSize.x, LayerSize.y, (static_cast<uint64_t>(LayerSize.x) * LayerSize.y * 4 * Layers) / 1024);
+
+		std::vector<glm::vec4> TexRegions(TextureCount);
+		std::vector<int> TexLayers(TextureCount);
+		for (int Idx = 0; Idx < TextureCount; Idx++)
+		{
+			const ETexture Texture = static_cast<ETexture>(Idx);
+			std::shared_ptr<CTexture>& TextureRef = Data.Textures[Texture];
+			const FTextureRegion& Region = Regions[Idx];
+			const int Index = Data.TextureArray->AddTexture(TextureRef, Region);
+			LK_VERIFY(Index == Idx, "Texture {} added at index {}", Enum::ToString(Texture), Index);
 			TextureRef->SetSlot(Idx);
+			if (TextureRef->IsPending())
+			{
+				TextureLoader->Load(TextureRef, Data.TextureArray.get(), Index);
+			}
+			TexRegions[Idx] = glm::vec4(glm::vec2(Region.Offset), glm::vec2(Region.Size));
+			TexLayers[Idx] = static_cast<int>(Region.Layer);
 		}
+		QuadShader->Set(QuadShader->GetUniform("u_texregion"), std::span<const glm::vec4>(TexRegions));
+		QuadShader->Set(QuadShader->GetUniform("u_texlayer"), std::span<const int>(TexLayers));
+		QuadShader->Set("u_textures", static_cast<int>(TextureArrayUnit));
 
 		Data.WhiteTexture = Data.Textures[ETexture::White];
 		CAssetManager::Get().Initialize();
@@ -297,28 +685,150 @@ namespace platformer2d {
 
 	void CRenderer::BeginFrame()
 	{
-		LK_OpenGL_Verify(glClearColor(ClearColor.r, ClearColor.g, ClearColor.b, ClearColor.a));
-		LK_OpenGL_Verify(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+		/* With a render thread the statistics are published once the frame has been executed, see EndFrame. */
+		if (!RenderThread)
+		{
+			LastFrameDrawStats = DrawStats;
+		}
+		ResetDrawStatistics();
+		FrameTimer.Reset();
 		Data.FrameIndex = (Data.FrameIndex + 1) % Data.RefreshRate;
 
-		ImGuiLayer->BeginFrame();
+		SubmitCommand([InClearColor = ClearColor]()
+		{
+			ExecuteBeginFrame(InClearColor);
+		});
 
-		QuadShader->Bind();
-		BindTextures();
+		ImGuiLayer->BeginFrame();
 	}
 
 	void CRenderer::EndFrame()
 	{
+		LK_ASSERT(!Data.ActiveLayer.bActive, "Frame ended inside a render layer");
 		UI::Render();
 		Flush();
-
 		ImGuiLayer->EndFrame();
+
+		if (!RenderThread)
+		{
+			ExecuteEndFrame(ImGui::GetDrawData());
+			DrawStats.CpuTimeMs = FrameTimer.GetElapsed<std::chrono::microseconds>().count() / 1000.0f;
+			return;
+		}
+
+		/* ImGui reuses its draw lists on the next frame, the render thread draws a copy. */
+		CImGuiDrawSnapshot& ImGuiDrawData = ImGuiDrawSnapshots[CommandQueueSubmissionIndex];
+		ImGuiDrawData.Capture(*ImGui::GetDrawData());
+		SubmitCommand([&ImGuiDrawData]()
+		{
+			ExecuteEndFrame(ImGuiDrawData.Get());
+		});
+		DrawStats.CpuTimeMs = FrameTimer.GetElapsed<std::chrono::microseconds>().count() / 1000.0f;
+
+		/* The main thread is at most one frame ahead, the previous frame has to be done before this one is handed over. */
+		const CTimer WaitTimer;
+		RenderThread->WaitForIdle();
+		DrawStats.RenderThreadWaitMs = WaitTimer.GetElapsed<std::chrono::microseconds>().count() / 1000.0f;
+
+		const FRenderCommandQueueStatistics& QueueStats = GetSubmissionQueue().GetStatistics();
+		DrawStats.RenderCommands = QueueStats.CommandCount;
+		DrawStats.RenderCommandBytes = QueueStats.BytesUsed;
+		DrawStats.RenderCommandBytesReserved = 0;
+		for (const CRenderCommandQueue* Queue : CommandQueue)
+		{
+			DrawStats.RenderCommandBytesReserved += Queue->GetStatistics().BytesReserved;
+		}
+
+		LastFrameDrawStats = RecordedFrameStats;
+		LastFrameDrawStats.Accumulate(RenderedFrameStats);
+		RecordedFrameStats = DrawStats;
+
+		const uint32_t SubmissionIndex = CommandQueueSubmissionIndex;
+		CommandQueueSubmissionIndex = (SubmissionIndex + 1) % CommandQueue.size();
+		SubmittedDrawListCount[CommandQueueSubmissionIndex] = 0;
+		RenderThread->Kick(*CommandQueue[SubmissionIndex]);
+	}
+
+	void CRenderer::ExecuteBeginFrame(const glm::vec4& InClearColor)
+	{
+		if (RenderThread)
+		{
+			std::memset(&RenderThreadStats, 0, sizeof(RenderThreadStats));
+			RenderThreadTimer.Reset();
+		}
+		FDrawStatistics& Stats = GetRenderStats();
+
+		/* Anything outside the renderer may have changed the bindings since the last frame. */
+		OpenGL::State::Invalidate();
+		OpenGL::State::ResetCounters();
+		OpenGL::BeginErrorCheckFrame();
+
+		LK_OpenGL_Verify(glClearColor(InClearColor.r, InClearColor.g, InClearColor.b, InClearColor.a));
+		LK_OpenGL_Verify(glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT));
+
+		if (TextureLoader)
+		{
+			Stats.TextureBytesUploaded = TextureLoader->Update();
+			Stats.TexturesPending = TextureLoader->GetPendingCount();
+		}
+
+		QuadShader->Bind();
+
+		GpuTimer->Begin(EGpuPass::World);
+	}
+
+	void CRenderer::ExecuteEndFrame(ImDrawData* ImGuiDrawData)
+	{
+		FDrawStatistics& Stats = GetRenderStats();
+		GpuTimer->End(EGpuPass::World);
+
+		/* Hand the regions written this frame over to the GPU. */
+		for (CStreamBuffer* Stream : { QuadVertexStream.get(), LineVertexStream.get(), CircleVertexStream.get() })
+		{
+			Stream->EndFrame();
+			Stats.FenceWaits += Stream->ConsumeFenceWaits();
+		}
+		if (TextureLoader)
+		{
+			TextureLoader->EndFrame();
+			Stats.FenceWaits += TextureLoader->ConsumeFenceWaits();
+		}
+		ResetBatch(CShader::EType::Quad);
+		ResetBatch(CShader::EType::Line);
+		ResetBatch(CShader::EType::Circle);
+
+		GpuTimer->Begin(EGpuPass::UI);
+		ImGuiLayer->RenderDrawData(ImGuiDrawData);
+		GpuTimer->End(EGpuPass::UI);
+
+		/* The timings of this frame are read back when its queries come around again. */
+		GpuTimer->EndFrame();
+		for (int Idx = 0; Idx < CGpuTimer::PASS_COUNT; Idx++)
+		{
+			Stats.GpuTimeMs[Idx] = GpuTimer->GetTime(static_cast<EGpuPass>(Idx));
+		}
+
+		const OpenGL::State::FCounters& StateCounters = OpenGL::State::GetCounters();
+		Stats.ShaderBinds = StateCounters.GetIssued(OpenGL::State::ECall::Program);
+		Stats.TextureBinds = StateCounters.GetIssued(OpenGL::State::ECall::Texture);
+		Stats.StateCallsIssued = StateCounters.GetIssued();
+		Stats.StateCallsSkipped = StateCounters.GetSkipped();
+
+		if (RenderThread)
+		{
+			Stats.RenderThreadTimeMs = RenderThreadTimer.GetElapsed<std::chrono::microseconds>().count() / 1000.0f;
+			RenderedFrameStats = Stats;
+			CWindow::Get()->SwapBuffers();
+		}
 	}
 
 	void CRenderer::BeginScene(const CCamera& Camera)
 	{
 		CameraData.ViewProjection = Camera.GetViewProjection();
-		CameraUniformBuffer->SetData(&CameraData, sizeof(FCameraData));
+		UploadCameraData();
+
+		const auto [RangeMin, RangeMax] = Camera.GetMinMaxRange();
+		SetViewBounds({ .Min = Camera.GetPosition() + RangeMin, .Max = Camera.GetPosition() + RangeMax });
 
 		if (bDebugRender)
 		{
@@ -331,7 +841,8 @@ namespace platformer2d {
 	void CRenderer::BeginScene(const CCamera& Camera, const glm::mat4& Transform)
 	{
 		CameraData.ViewProjection = Camera.GetViewProjection() * glm::inverse(Transform);
-		CameraUniformBuffer->SetData(&CameraData, sizeof(FCameraData));
+		UploadCameraData();
+		SetViewBounds(ComputeViewBounds(CameraData.ViewProjection));
 
 		StartBatch();
 	}
@@ -341,16 +852,86 @@ namespace platformer2d {
 		Flush();
 	}
 
+	void CRenderer::UploadCameraData()
+	{
+		SubmitCommand([Camera = CameraData]()
+		{
+			CameraUniformBuffer->SetData(&Camera, sizeof(FCameraData));
+		});
+	}
+
 	void CRenderer::StartBatch()
 	{
-		QuadIndexCount = 0;
-		QuadVertexBufferPtr = QuadVertexBufferBase;
+		SubmitCommand([]()
+		{
+			ResetBatch(CShader::EType::Quad);
+			ResetBatch(CShader::EType::Line);
+			ResetBatch(CShader::EType::Circle);
+		});
+	}
+
+	void CRenderer::ResetBatch(const CShader::EType BatchType)
+	{
+		/**
+		 * A batch is bound by the index buffer and the space left in the stream region.
+		 * The limits are rounded down to whole primitives and a region tail too small for
+		 * a single primitive is skipped, so the full check before each allocation is enough
+		 * to never write past the region.
+		 */
+		switch (BatchType)
+		{
+			case CShader::EType::Quad:
+			{
+				QuadIndexCount = 0;
+				if (Specification.QuadRenderPath == EQuadRenderPath::Instanced)
+				{
+					QuadVertexStream->Reserve(sizeof(FQuadInstance));
+					const std::size_t Capacity = QuadVertexStream->GetBatchCapacity() / sizeof(FQuadInstance);
+					QuadInstanceBufferBase = reinterpret_cast<FQuadInstance*>(QuadVertexStream->GetBatchBase());
+					QuadInstanceBufferPtr = QuadInstanceBufferBase;
+					QuadInstanceBufferLimit = QuadInstanceBufferBase + std::min<std::size_t>(MaxQuadInstances, Capacity);
+				}
+				else if (Specification.QuadVertexFormat == EQuadVertexFormat::Packed)
+				{
+					QuadVertexStream->Reserve(4 * sizeof(FQuadVertexPacked));
+					const std::size_t Capacity = QuadVertexStream->GetBatchCapacity() / sizeof(FQuadVertexPacked);
+					QuadPackedVertexBufferBase = reinterpret_cast<FQuadVertexPacked*>(QuadVertexStream->GetBatchBase());
+					QuadPackedVertexBufferPtr = QuadPackedVertexBufferBase;
+					QuadPackedVertexBufferLimit = QuadPackedVertexBufferBase + (std::min<std::size_t>(MaxVertices, Capacity) & ~std::size_t(3));
+				}
+				else
+				{
+					QuadVertexStream->Reserve(4 * sizeof(FQuadVertex));
+					const std::size_t Capacity = QuadVertexStream->GetBatchCapacity() / sizeof(FQuadVertex);
+					QuadVertexBufferBase = reinterpret_cast<FQuadVertex*>(QuadVertexStream->GetBatchBase());
+					QuadVertexBufferPtr = QuadVertexBufferBase;
+					QuadVertexBufferLimit = QuadVertexBufferBase + (std::min<std::size_t>(MaxVertices, Capacity) & ~std::size_t(3));
+				}
+				break;
+			}
 
-		LineIndexCount = 0;
-		LineVertexBufferPtr = LineVertexBufferBase;
+			case CShader::EType::Line:
+			{
+				LineVertexStream->Reserve(2 * sizeof(FLineVertex));
+				const std::size_t Capacity = LineVertexStream->GetBatchCapacity() / sizeof(FLineVertex);
+				LineIndexCount = 0;
+				LineVertexBufferBase = reinterpret_cast<FLineVertex*>(LineVertexStream->GetBatchBase());
+				LineVertexBufferPtr = LineVertexBufferBase;
+				LineVertexBufferLimit = LineVertexBufferBase + (std::min<std::size_t>(MaxLineIndices, Capacity) & ~std::size_t(1));
+				break;
+			}
 
-		CircleIndexCount = 0;
-		CircleVertexBufferPtr = CircleVertexBufferBase;
+			case CShader::EType::Circle:
+			{
+				CircleVertexStream->Reserve(4 * sizeof(FCircleVertex));
+				const std::size_t Capacity = CircleVertexStream->GetBatchCapacity() / sizeof(FCircleVertex);
+				CircleIndexCount = 0;
+				CircleVertexBufferBase = reinterpret_cast<FCircleVertex*>(CircleVertexStream->GetBatchBase());
+				CircleVertexBufferPtr = CircleVertexBufferBase;
+				CircleVertexBufferLimit = CircleVertexBufferBase + (std::min<std::size_t>(MaxVertices, Capacity) & ~std::size_t(3));
+				break;
+			}
+		}
 	}
 
 	void CRenderer::NextBatch()
@@ -361,196 +942,479 @@ namespace platformer2d {
 
 	void CRenderer::Flush()
 	{
-		if (QuadIndexCount > 0)
+		const FRecordCounts Recorded = DrawRecorder.Merge(DrawList);
+		DrawStats.QuadCount += Recorded.Quads;
+		DrawStats.LineCount += Recorded.Lines;
+		DrawStats.CircleCount += Recorded.Circles;
+		DrawStats.SubmittedCount += Recorded.Submitted;
+		DrawStats.CulledCount += Recorded.Culled;
+
+		/* Immediate mode only records the draws of other threads or for the render thread, these are kept in merge order. */
+		const bool bSort = (SubmissionMode == ESubmissionMode::Sorted);
+		CDrawList* List = nullptr;
+		if (!DrawList.IsEmpty() && RenderThread)
 		{
-			/* Compute byte count. */
-			const uint32_t DataSize = static_cast<uint32_t>((uint8_t*)QuadVertexBufferPtr - (uint8_t*)QuadVertexBufferBase);
-			LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, QuadVBO));
-			LK_OpenGL_Verify(glBufferSubData(GL_ARRAY_BUFFER, 0, DataSize, QuadVertexBufferBase));
-
-			QuadShader->Bind();
-			CameraUniformBuffer->Bind();
-			LK_OpenGL_Verify(glBindVertexArray(QuadVAO));
-			LK_OpenGL_Verify(glDrawElements(GL_TRIANGLES, QuadIndexCount, GL_UNSIGNED_INT, nullptr));
-			CameraUniformBuffer->Unbind();
-			QuadShader->Unbind();
+			/* The records are handed over and replaced by a list the render thread is done with. */
+			List = &AcquireDrawList();
+			List->Swap(DrawList);
 		}
-
-		if (LineIndexCount > 0)
+		else if (!DrawList.IsEmpty())
 		{
-			/* Compute byte count. */
-			const uint32_t DataSize = static_cast<uint32_t>((uint8_t*)LineVertexBufferPtr - (uint8_t*)LineVertexBufferBase);
-			LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, LineVBO));
-			LK_OpenGL_Verify(glBufferSubData(GL_ARRAY_BUFFER, 0, DataSize, LineVertexBufferBase));
-
-			LineShader->Bind();
-			CameraUniformBuffer->Bind();
-			Data.WhiteTexture->Bind(0);
-			LK_OpenGL_Verify(glBindVertexArray(LineVAO));
-			LK_OpenGL_Verify(glDrawElements(GL_LINES, LineIndexCount, GL_UNSIGNED_INT, nullptr));
-			Data.WhiteTexture->Unbind(0);
-			CameraUniformBuffer->Unbind();
-			LineShader->Unbind();
+			List = &DrawList;
 		}
 
-		if (CircleIndexCount > 0)
+		SubmitCommand([List, bSort]()
 		{
-			/* Compute byte count. */
-			const uint32_t DataSize = static_cast<uint32_t>((uint8_t*)CircleVertexBufferPtr - (uint8_t*)CircleVertexBufferBase);
-			LK_OpenGL_Verify(glBindBuffer(GL_ARRAY_BUFFER, CircleVBO));
-			LK_OpenGL_Verify(glBufferSubData(GL_ARRAY_BUFFER, 0, DataSize, CircleVertexBufferBase));
+			if (List)
+			{
+				SubmitDrawList(*List, bSort);
+			}
 
-			CircleShader->Bind();
-			CameraUniformBuffer->Bind();
-			Data.WhiteTexture->Bind(0);
-			LK_OpenGL_Verify(glBindVertexArray(CircleVAO));
-			LK_OpenGL_Verify(glDrawElements(GL_TRIANGLES, CircleIndexCount, GL_UNSIGNED_INT, nullptr));
-			Data.WhiteTexture->Unbind(0);
-			CameraUniformBuffer->Unbind();
-			CircleShader->Unbind();
-		}
+			FlushBatch(CShader::EType::Quad, EBatchBreak::Flush);
+			FlushBatch(CShader::EType::Line, EBatchBreak::Flush);
+			FlushBatch(CShader::EType::Circle, EBatchBreak::Flush);
+		});
 	}
 
-	uint16_t CRenderer::GetFrameIndex()
+	void CRenderer::FlushBatch(const CShader::EType BatchType, const EBatchBreak Reason)
 	{
-		return Data.FrameIndex;
+		FDrawStatistics& Stats = GetRenderStats();
+		switch (BatchType)
+		{
+			case CShader::EType::Quad:
+			{
+				const bool bInstanced = (Specification.QuadRenderPath == EQuadRenderPath::Instanced);
+				const std::size_t InstanceCount = static_cast<std::size_t>(QuadInstanceBufferPtr - QuadInstanceBufferBase);
+				if ((bInstanced && (InstanceCount == 0)) || (!bInstanced && (QuadIndexCount == 0)))
+				{
+					return;
+				}
+
+				/* Compute byte count. */
+				const bool bPacked = (Specification.QuadVertexFormat == EQuadVertexFormat::Packed);
+				const std::size_t DataSize = bInstanced
+					? static_cast<std::size_t>((uint8_t*)QuadInstanceBufferPtr - (uint8_t*)QuadInstanceBufferBase)
+					: bPacked
+						? static_cast<std::size_t>((uint8_t*)QuadPackedVertexBufferPtr - (uint8_t*)QuadPackedVertexBufferBase)
+						: static_cast<std::size_t>((uint8_t*)QuadVertexBufferPtr - (uint8_t*)QuadVertexBufferBase);
+				const std::size_t Offset = QuadVertexStream->Submit(DataSize);
+				Stats.BytesUploaded += DataSize;
+
+				QuadShader->Bind();
+				CameraUniformBuffer->Bind();
+				Data.TextureArray->Bind(TextureArrayUnit);
+				OpenGL::State::BindVertexArray(QuadVAO);
+				if (bInstanced)
+				{
+					const GLuint BaseInstance = static_cast<GLuint>(Offset / sizeof(FQuadInstance));
+					LK_OpenGL_Verify(glDrawArraysInstancedBaseInstance(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(InstanceCount), BaseInstance));
+					Stats.VertexCount += 4 * InstanceCount;
+				}
+				else
+				{
+					const std::size_t Stride = bPacked ? sizeof(FQuadVertexPacked) : sizeof(FQuadVertex);
+					const GLint BaseVertex = static_cast<GLint>(Offset / Stride);
+					LK_OpenGL_Verify(glDrawElementsBaseVertex(GL_TRIANGLES, QuadIndexCount, GL_UNSIGNED_INT, nullptr, BaseVertex));
+					Stats.VertexCount += (DataSize / Stride);
+					Stats.IndexCount += QuadIndexCount;
+				}
+
+				ResetBatch(CShader::EType::Quad);
+				break;
+			}
+
+			case CShader::EType::Line:
+			{
+				if (LineIndexCount == 0)
+				{
+					return;
+				}
+
+				/* Compute byte count. */
+				const std::size_t DataSize = static_cast<std::size_t>((uint8_t*)LineVertexBufferPtr - (uint8_t*)LineVertexBufferBase);
+				const std::size_t Offset = LineVertexStream->Submit(DataSize);
+				const GLint BaseVertex = static_cast<GLint>(Offset / sizeof(FLineVertex));
+				Stats.BytesUploaded += DataSize;
+
+				LineShader->Bind();
+				CameraUniformBuffer->Bind();
+				OpenGL::State::BindVertexArray(LineVAO);
+				LK_OpenGL_Verify(glDrawElementsBaseVertex(GL_LINES, LineIndexCount, GL_UNSIGNED_INT, nullptr, BaseVertex));
+				Stats.VertexCount += (DataSize / sizeof(FLineVertex));
+				Stats.IndexCount += LineIndexCount;
+
+				ResetBatch(CShader::EType::Line);
+				break;
+			}
+
+			case CShader::EType::Circle:
+			{
+				if (CircleIndexCount == 0)
+				{
+					return;
+				}
+
+				/* Compute byte count. */
+				const std::size_t DataSize = static_cast<std::size_t>((uint8_t*)CircleVertexBufferPtr - (uint8_t*)CircleVertexBufferBase);
+				const std::size_t Offset = CircleVertexStream->Submit(DataSize);
+				const GLint BaseVertex = static_cast<GLint>(Offset / sizeof(FCircleVertex));
+				Stats.BytesUploaded += DataSize;
+
+				CircleShader->Bind();
+				CameraUniformBuffer->Bind();
+				OpenGL::State::BindVertexArray(CircleVAO);
+				LK_OpenGL_Verify(glDrawElementsBaseVertex(GL_TRIANGLES, CircleIndexCount, GL_UNSIGNED_INT, nullptr, BaseVertex));
+				Stats.VertexCount += (DataSize / sizeof(FCircleVertex));
+				Stats.IndexCount += CircleIndexCount;
+
+				ResetBatch(CShader::EType::Circle);
+				break;
+			}
+		}
+
+		Stats.DrawCallCount++;
+		Stats.FlushCount++;
+		Stats.BatchBreaks[static_cast<int>(Reason)]++;
 	}
 
-	void CRenderer::DrawQuad(const glm::vec2& Pos, const glm::vec2& Size,
-							 const glm::vec4& Color, const float RotationDeg)
+	void CRenderer::SubmitDrawList(CDrawList& List, const bool bSort)
 	{
-		if (QuadIndexCount >= MaxIndices)
+		if (List.IsEmpty())
 		{
-			NextBatch();
+			return;
 		}
 
-		static constexpr int TextureIndex = 0;
-		static constexpr float TileFactor = 1.0f;
-
-		const glm::mat4 Transform = glm::translate(glm::mat4(1.0f), { Pos.x, Pos.y, 0.0f })
-            * glm::rotate(glm::mat4(1.0f), glm::radians(RotationDeg), glm::vec3(0.0f, 0.0f, 1.0f))
-            * glm::scale(glm::mat4(1.0f), { Size.x, Size.y, 1.0f });
+		if (bSort)
+		{
+			List.Sort();
+		}
+		GetRenderStats().RecordCount += List.GetSize();
 
-		for (std::size_t Idx = 0; Idx < 4; Idx++)
+		/* Batches only break when the primitive type changes or a buffer is full. */
+		CShader::EType BatchType = List.GetRecords().front().Type;
+		for (const FDrawRecord& Record : List.GetRecords())
 		{
-			QuadVertexBufferPtr->Position = Transform * QuadVertexPositions[Idx];
-			QuadVertexBufferPtr->Color = Color;
-			QuadVertexBufferPtr->TexCoord = QuadTextureCoords[Idx];
-			QuadVertexBufferPtr->TexIndex = TextureIndex;
-			QuadVertexBufferPtr->TileFactor = TileFactor;
-			QuadVertexBufferPtr++;
+			if (Record.Type != BatchType)
+			{
+				FlushBatch(BatchType, EBatchBreak::TypeChange);
+				BatchType = Record.Type;
+			}
+
+			switch (Record.Type)
+			{
+				case CShader::EType::Quad:
+				{
+					if (Specification.QuadRenderPath == EQuadRenderPath::Instanced)
+					{
+						if (QuadInstanceBufferPtr >= QuadInstanceBufferLimit)
+						{
+							FlushBatch(CShader::EType::Quad, EBatchBreak::BufferFull);
+						}
+
+						*QuadInstanceBufferPtr++ = *List.GetQuadInstance(Record);
+						break;
+					}
+
+					if (Specification.QuadVertexFormat == EQuadVertexFormat::Packed)
+					{
+						if (QuadPackedVertexBufferPtr >= QuadPackedVertexBufferLimit)
+						{
+							FlushBatch(CShader::EType::Quad, EBatchBreak::BufferFull);
+						}
+
+						const FQuadVertex* Vertices = List.GetQuadVertices(Record);
+						for (int Idx = 0; Idx < 4; Idx++)
+						{
+							*QuadPackedVertexBufferPtr++ = FQuadVertexPacked(Vertices[Idx]);
+						}
+						QuadIndexCount += 6;
+						break;
+					}
+
+					if (QuadVertexBufferPtr >= QuadVertexBufferLimit)
+					{
+						FlushBatch(CShader::EType::Quad, EBatchBreak::BufferFull);
+					}
+
+					std::memcpy(QuadVertexBufferPtr, List.GetQuadVertices(Record), 4 * sizeof(FQuadVertex));
+					QuadVertexBufferPtr += 4;
+					QuadIndexCount += 6;
+					break;
+				}
+
+				case CShader::EType::Line:
+				{
+					if (LineVertexBufferPtr >= LineVertexBufferLimit)
+					{
+						FlushBatch(CShader::EType::Line, EBatchBreak::BufferFull);
+					}
+
+					std::memcpy(LineVertexBufferPtr, List.GetLineVertices(Record), 2 * sizeof(FLineVertex));
+					LineVertexBufferPtr += 2;
+					LineIndexCount += 2;
+					break;
+				}
+
+				case CShader::EType::Circle:
+				{
+					if (CircleVertexBufferPtr >= CircleVertexBufferLimit)
+					{
+						FlushBatch(CShader::EType::Circle, EBatchBreak::BufferFull);
+					}
+
+					std::memcpy(CircleVertexBufferPtr, List.GetCircleVertices(Record), 4 * sizeof(FCircleVertex));
+					CircleVertexBufferPtr += 4;
+					CircleIndexCount += 6;
+					break;
+				}
+			}
 		}
 
-		QuadIndexCount += 6;
+		List.Clear();
 	}
 
-	void CRenderer::DrawQuad(const glm::vec2& Pos, const glm::vec2& Size, const CTexture& Texture,
-							 const glm::vec4& Color, const float RotationDeg)
+	uint16_t CRenderer::GetFrameIndex()
 	{
-		DrawQuad({ Pos.x, Pos.y, 0.010f }, Size, Texture, Color, RotationDeg);
+		return Data.FrameIndex;
 	}
 
-	void CRenderer::DrawQuad(const glm::vec3& Pos, const glm::vec2& Size, const CTexture& Texture,
-							 const glm::vec4& Color, float RotationDeg)
+	FQuadVertex* CRenderer::AllocateQuad(const float Depth, const int TexIndex, const bool bTranslucent)
 	{
-		if (QuadIndexCount >= MaxIndices)
+		if (CDrawRecorder::FContext* Context = CDrawRecorder::GetThreadContext(); Context != nullptr)
 		{
-			NextBatch();
+			const uint64_t Key = SortKey::Create(Context->RenderLayer, bTranslucent, Depth, CShader::EType::Quad, static_cast<uint8_t>(TexIndex));
+			Context->Counts.Quads++;
+			return Context->DrawList.AddQuad(Key);
 		}
 
-		static constexpr float TileFactor = 1.0f;
-
-		const glm::mat4 Transform = glm::translate(glm::mat4(1.0f), Pos)
-            * glm::rotate(glm::mat4(1.0f), glm::radians(RotationDeg), glm::vec3(0.0f, 0.0f, 1.0f))
-            * glm::scale(glm::mat4(1.0f), { Size.x, Size.y, 1.0f });
+		/* With a render thread the batches are only built there, every draw is recorded. */
+		DrawStats.QuadCount++;
+		if ((SubmissionMode == ESubmissionMode::Sorted) || RenderThread)
+		{
+			const uint64_t Key = SortKey::Create(RenderLayer, bTranslucent, Depth, CShader::EType::Quad, static_cast<uint8_t>(TexIndex));
+			return DrawList.AddQuad(Key);
+		}
 
-		for (std::size_t Idx = 0; Idx < 4; Idx++)
+		if (QuadVertexBufferPtr >= QuadVertexBufferLimit)
 		{
-			QuadVertexBufferPtr->Position = Transform * QuadVertexPositions[Idx];
-			QuadVertexBufferPtr->Color = Color;
-			QuadVertexBufferPtr->TexCoord = QuadTextureCoords[Idx];
-			QuadVertexBufferPtr->TexIndex = Texture.GetSlot();
-			QuadVertexBufferPtr->TileFactor = TileFactor;
-			QuadVertexBufferPtr++;
+			FlushBatch(CShader::EType::Quad, EBatchBreak::BufferFull);
 		}
 
+		FQuadVertex* Vertices = QuadVertexBufferPtr;
+		QuadVertexBufferPtr += 4;
 		QuadIndexCount += 6;
-		DrawStats.QuadCount++;
-	}
 
-	void CRenderer::DrawQuad(const glm::vec2& Pos, const glm::vec2& Size, const CTexture& Texture,
-							 const glm::vec2(&TexCoords)[4], const glm::vec4& Color, const float RotationDeg)
-	{
-		DrawQuad({ Pos.x, Pos.y, 0.010f }, Size, Texture, TexCoords, Color, RotationDeg);
+		return Vertices;
 	}
 
-	void CRenderer::DrawQuad(const glm::vec3& Pos, const glm::vec2& Size, const CTexture& Texture,
-							 const glm::vec2(&TexCoords)[4], const glm::vec4& Color, const float RotationDeg)
+	FQuadVertexPacked* CRenderer::AllocateQuadPacked()
 	{
-		if (QuadIndexCount >= MaxIndices)
+		LK_ASSERT((SubmissionMode == ESubmissionMode::Immediate) && !RenderThread, "Recorded quads are kept unpacked");
+		DrawStats.QuadCount++;
+		if (QuadPackedVertexBufferPtr >= QuadPackedVertexBufferLimit)
 		{
-			NextBatch();
+			FlushBatch(CShader::EType::Quad, EBatchBreak::BufferFull);
 		}
 
-		static constexpr float TileFactor = 1.0f;
+		FQuadVertexPacked* Vertices = QuadPackedVertexBufferPtr;
+		QuadPackedVertexBufferPtr += 4;
+		QuadIndexCount += 6;
 
-		const glm::mat4 Transform = glm::translate(glm::mat4(1.0f), Pos)
-            * glm::rotate(glm::mat4(1.0f), glm::radians(RotationDeg), glm::vec3(0.0f, 0.0f, 1.0f))
-            * glm::scale(glm::mat4(1.0f), { Size.x, Size.y, 1.0f });
+		return Vertices;
+	}
 
-		for (std::size_t Idx = 0; Idx < 4; Idx++)
+	FQuadInstance* CRenderer::AllocateQuadInstance(const float Depth, const int TexIndex, const bool bTranslucent)
+	{
+		if (CDrawRecorder::FContext* Context = CDrawRecorder::GetThreadContext(); Context != nullptr)
 		{
-			QuadVertexBufferPtr->Position = Transform * QuadVertexPositions[Idx];
-			QuadVertexBufferPtr->Color = Color;
-			QuadVertexBufferPtr->TexCoord = TexCoords[Idx];
-			QuadVertexBufferPtr->TexIndex = Texture.GetSlot();
-			QuadVertexBufferPtr->TileFactor = TileFactor;
-			QuadVertexBufferPtr++;
+			const uint64_t Key = SortKey::Create(Context->RenderLayer, bTranslucent, Depth, CShader::EType::Quad, static_cast<uint8_t>(TexIndex));
+			Context->Counts.Quads++;
+			return Context->DrawList.AddQuadInstance(Key);
 		}
 
-		QuadIndexCount += 6;
 		DrawStats.QuadCount++;
+		if ((SubmissionMode == ESubmissionMode::Sorted) || RenderThread)
+		{
+			const uint64_t Key = SortKey::Create(RenderLayer, bTranslucent, Depth, CShader::EType::Quad, static_cast<uint8_t>(TexIndex));
+			return DrawList.AddQuadInstance(Key);
+		}
+
+		if (QuadInstanceBufferPtr >= QuadInstanceBufferLimit)
+		{
+			FlushBatch(CShader::EType::Quad, EBatchBreak::BufferFull);
+		}
+
+		return QuadInstanceBufferPtr++;
 	}
 
-	void CRenderer::DrawQuad(const glm::vec2& Pos, const glm::vec2& Size, const CTexture& Texture, const FSpriteUV& UV,
-							 const glm::vec4& Color, const float RotationDeg)
+	FLineVertex* CRenderer::AllocateLine(const float Depth, const bool bTranslucent)
 	{
-		DrawQuad({ Pos.x, Pos.y, 0.010f }, Size, Texture, UV, Color, RotationDeg);
+		if (CDrawRecorder::FContext* Context = CDrawRecorder::GetThreadContext(); Context != nullptr)
+		{
+			const uint64_t Key = SortKey::Create(Context->RenderLayer, bTranslucent, Depth, CShader::EType::Line, 0);
+			Context->Counts.Lines++;
+			return Context->DrawList.AddLine(Key);
+		}
+
+		DrawStats.LineCount++;
+		if ((SubmissionMode == ESubmissionMode::Sorted) || RenderThread)
+		{
+			const uint64_t Key = SortKey::Create(RenderLayer, bTranslucent, Depth, CShader::EType::Line, 0);
+			return DrawList.AddLine(Key);
+		}
+
+		if (LineVertexBufferPtr >= LineVertexBufferLimit)
+		{
+			FlushBatch(CShader::EType::Line, EBatchBreak::BufferFull);
+		}
+
+		FLineVertex* Vertices = LineVertexBufferPtr;
+		LineVertexBufferPtr += 2;
+		LineIndexCount += 2;
+
+		return Vertices;
 	}
 
-	void CRenderer::DrawQuad(const glm::vec3& Pos, const glm::vec2& Size, const CTexture& Texture, const FSpriteUV& UV,
-							 const glm::vec4& Color, const float RotationDeg)
+	FCircleVertex* CRenderer::AllocateCircle(const float Depth, const bool bTranslucent)
 	{
-		if (QuadIndexCount >= MaxIndices)
+		if (CDrawRecorder::FContext* Context = CDrawRecorder::GetThreadContext(); Context != nullptr)
+		{
+			const uint64_t Key = SortKey::Create(Context->RenderLayer, bTranslucent, Depth, CShader::EType::Circle, 0);
+			Context->Counts.Circles++;
+			return Context->DrawList.AddCircle(Key);
+		}
+
+		DrawStats.CircleCount++;
+		if ((SubmissionMode == ESubmissionMode::Sorted) || RenderThread)
+		{
+			const uint64_t Key = SortKey::Create(RenderLayer, bTranslucent, Depth, CShader::EType::Circle, 0);
+			return DrawList.AddCircle(Key);
+		}
+
+		if (CircleVertexBufferPtr >= CircleVertexBufferLimit)
 		{
-			NextBatch();
+			FlushBatch(CShader::EType::Circle, EBatchBreak::BufferFull);
 		}
 
+		FCircleVertex* Vertices = CircleVertexBufferPtr;
+		CircleVertexBufferPtr += 4;
+		CircleIndexCount += 6;
+
+		return Vertices;
+	}
+
+	void CRenderer::SubmitQuad(const glm::vec3& Pos, const glm::vec2& Size, const float RotationDeg, const glm::vec4& Color,
+							   const glm::vec2 (&TexCoords)[4], const int TexIndex, const bool bTranslucent)
+	{
 		static constexpr float TileFactor = 1.0f;
+		const float RotationRad = glm::radians(RotationDeg);
+		if (!IsInView(Pos, GetQuadHalfExtent(Size, RotationRad)))
+		{
+			return;
+		}
 
-		const glm::mat4 Transform = glm::translate(glm::mat4(1.0f), Pos)
-            * glm::rotate(glm::mat4(1.0f), glm::radians(RotationDeg), glm::vec3(0.0f, 0.0f, 1.0f))
-            * glm::scale(glm::mat4(1.0f), { Size.x, Size.y, 1.0f });
+		const bool bBlended = (bTranslucent || (Color.a < 1.0f));
 
-		const std::array<glm::vec2, 4> TexCoords = {
-			glm::vec2(UV.U0, UV.V0),
-			glm::vec2(UV.U0, UV.V1),
-			glm::vec2(UV.U1, UV.V1),
-			glm::vec2(UV.U1, UV.V0)
+		if (Specification.QuadRenderPath == EQuadRenderPath::Instanced)
+		{
+			/* The corners are expanded on the GPU, only the bottom left and top right UV are needed. */
+			LK_ASSERT(FQuadInstance::IsTexCoordRect(TexCoords), "Instanced quads need an axis aligned UV rect inside [0, 1]");
+			FQuadInstance* Instance = AllocateQuadInstance(Pos.z, TexIndex, bBlended);
+			*Instance = FQuadInstance(Pos, Size, RotationRad, Color, TexIndex, TexCoords[0], TexCoords[2]);
+			return;
+		}
+
+		/* Rotation is around Z only, the corners are offset by the rotated half extents. */
+		const float Sin = std::sin(RotationRad);
+		const float Cos = std::cos(RotationRad);
+		const glm::vec2 AxisX = glm::vec2(Cos, Sin) * (Size.x * 0.5f);
+		const glm::vec2 AxisY = glm::vec2(-Sin, Cos) * (Size.y * 0.5f);
+		const glm::vec2 Corners[4] = {
+			glm::vec2(Pos) - AxisX - AxisY, /* Bottom Left.  */
+			glm::vec2(Pos) - AxisX + AxisY, /* Top Left.     */
+			glm::vec2(Pos) + AxisX + AxisY, /* Top Right.    */
+			glm::vec2(Pos) + AxisX - AxisY  /* Bottom Right. */
 		};
 
+		FQuadVertex Vertices[4];
 		for (std::size_t Idx = 0; Idx < 4; Idx++)
 		{
-			QuadVertexBufferPtr->Position = Transform * QuadVertexPositions[Idx];
-			QuadVertexBufferPtr->Color = Color;
-			QuadVertexBufferPtr->TexCoord = TexCoords[Idx];
-			QuadVertexBufferPtr->TexIndex = Texture.GetSlot();
-			QuadVertexBufferPtr->TileFactor = TileFactor;
-			QuadVertexBufferPtr++;
+			Vertices[Idx].Position = { Corners[Idx], Pos.z };
+			Vertices[Idx].Color = Color;
+			Vertices[Idx].TexCoord = TexCoords[Idx];
+			Vertices[Idx].TexIndex = TexIndex;
+			Vertices[Idx].TileFactor = TileFactor;
 		}
 
-		QuadIndexCount += 6;
-		DrawStats.QuadCount++;
+		SubmitQuadVertices(Vertices, Pos.z, TexIndex, bBlended);
+	}
+
+	void CRenderer::SubmitQuadVertices(const FQuadVertex (&Vertices)[4], const float Depth, const int TexIndex, const bool bTranslucent)
+	{
+		/* Recorded draws are kept unpacked and packed once they are copied to the batch. */
+		const bool bRecording = (CDrawRecorder::GetThreadContext() != nullptr);
+		if ((SubmissionMode == ESubmissionMode::Immediate) && !bRecording && !RenderThread
+			&& (Specification.QuadVertexFormat == EQuadVertexFormat::Packed))
+		{
+			FQuadVertexPacked* Packed = AllocateQuadPacked();
+			for (std::size_t Idx = 0; Idx < 4; Idx++)
+			{
+				Packed[Idx] = FQuadVertexPacked(Vertices[Idx]);
+			}
+			return;
+		}
+
+		std::memcpy(AllocateQuad(Depth, TexIndex, bTranslucent), Vertices, sizeof(Vertices));
+	}
+
+	void CRenderer::DrawQuad(const glm::vec2& Pos, const glm::vec2& Size,
+							 const glm::vec4& Color, const float RotationDeg)
+	{
+		static constexpr int TextureIndex = 0;
+		SubmitQuad({ Pos.x, Pos.y, 0.0f }, Size, RotationDeg, Color, QuadTextureCoords, TextureIndex, false);
+	}
+
+	void CRenderer::DrawQuad(const glm::vec2& Pos, const glm::vec2& Size, const CTexture& Texture,
+							 const glm::vec4& Color, const float RotationDeg)
+	{
+		DrawQuad({ Pos.x, Pos.y, 0.010f }, Size, Texture, Color, RotationDeg);
+	}
+
+	void CRenderer::DrawQuad(const glm::vec3& Pos, const glm::vec2& Size, const CTexture& Texture,
+							 const glm::vec4& Color, float RotationDeg)
+	{
+		SubmitQuad(Pos, Size, RotationDeg, Color, QuadTextureCoords, static_cast<int>(Texture.GetSlot()), Texture.IsTranslucent());
+	}
+
+	void CRenderer::DrawQuad(const glm::vec2& Pos, const glm::vec2& Size, const CTexture& Texture,
+							 const glm::vec2(&TexCoords)[4], const glm::vec4& Color, const float RotationDeg)
+	{
+		DrawQuad({ Pos.x, Pos.y, 0.010f }, Size, Texture, TexCoords, Color, RotationDeg);
+	}
+
+	void CRenderer::DrawQuad(const glm::vec3& Pos, const glm::vec2& Size, const CTexture& Texture,
+							 const glm::vec2(&TexCoords)[4], const glm::vec4& Color, const float RotationDeg)
+	{
+		SubmitQuad(Pos, Size, RotationDeg, Color, TexCoords, static_cast<int>(Texture.GetSlot()), Texture.IsTranslucent());
+	}
+
+	void CRenderer::DrawQuad(const glm::vec2& Pos, const glm::vec2& Size, const CTexture& Texture, const FSpriteUV& UV,
+							 const glm::vec4& Color, const float RotationDeg)
+	{
+		DrawQuad({ Pos.x, Pos.y, 0.010f }, Size, Texture, UV, Color, RotationDeg);
+	}
+
+	void CRenderer::DrawQuad(const glm::vec3& Pos, const glm::vec2& Size, const CTexture& Texture, const FSpriteUV& UV,
+							 const glm::vec4& Color, const float RotationDeg)
+	{
+		const glm::vec2 TexCoords[4] = {
+			{ UV.U0, UV.V0 },
+			{ UV.U0, UV.V1 },
+			{ UV.U1, UV.V1 },
+			{ UV.U1, UV.V0 }
+		};
+
+		SubmitQuad(Pos, Size, RotationDeg, Color, TexCoords, static_cast<int>(Texture.GetSlot()), Texture.IsTranslucent());
 	}
 
 	void CRenderer::DrawQuad(const glm::vec2& Pos, const glm::vec2& Size, const ETexture Texture,
@@ -559,6 +1423,247 @@ namespace platformer2d {
 		DrawQuad(Pos, Size, *GetTexture(Texture), Color, RotationDeg);
 	}
 
+	void CRenderer::DrawQuads(const std::span<const FQuadInstance> Instances)
+	{
+		const bool bInstanced = (Specification.QuadRenderPath == EQuadRenderPath::Instanced);
+		if ((SubmissionMode == ESubmissionMode::Sorted) || (CDrawRecorder::GetThreadContext() != nullptr) || RenderThread)
+		{
+			/* Every quad needs its own sort key. */
+			for (const FQuadInstance& Instance : Instances)
+			{
+				if (!IsInView(Instance.Position, GetQuadHalfExtent(Instance.Size, Instance.Rotation)))
+				{
+					continue;
+				}
+
+				const int TexIndex = static_cast<int>(Instance.TexIndex);
+				const bool bBlended = IsTextureTranslucent(Instance.TexIndex) || ((Instance.Color >> 24) < 0xFF);
+				if (bInstanced)
+				{
+					*AllocateQuadInstance(Instance.Position.z, TexIndex, bBlended) = Instance;
+				}
+				else
+				{
+					QuadKernel::GenerateVertices({ &Instance, 1 }, AllocateQuad(Instance.Position.z, TexIndex, bBlended));
+				}
+			}
+			return;
+		}
+
+		/* Visible quads are submitted in contiguous runs to keep the bulk copy. */
+		std::size_t RunStart = 0;
+		uint64_t Culled = 0;
+		for (std::size_t Idx = 0; Idx < Instances.size(); Idx++)
+		{
+			const FQuadInstance& Instance = Instances[Idx];
+			if (!Data.View.Overlaps(Instance.Position, GetQuadHalfExtent(Instance.Size, Instance.Rotation)))
+			{
+				SubmitQuadInstances(Instances.subspan(RunStart, Idx - RunStart));
+				RunStart = Idx + 1;
+				Culled++;
+			}
+		}
+		SubmitQuadInstances(Instances.subspan(RunStart));
+
+		DrawStats.SubmittedCount += (Instances.size() - Culled);
+		DrawStats.CulledCount += Culled;
+	}
+
+	void CRenderer::SubmitQuadInstances(const std::span<const FQuadInstance> Instances)
+	{
+		if (Instances.empty())
+		{
+			return;
+		}
+
+		const bool bInstanced = (Specification.QuadRenderPath == EQuadRenderPath::Instanced);
+		DrawStats.QuadCount += Instances.size();
+		std::size_t Offset = 0;
+		while (Offset < Instances.size())
+		{
+			std::size_t Count = 0;
+			if (bInstanced)
+			{
+				if (QuadInstanceBufferPtr >= QuadInstanceBufferLimit)
+				{
+					FlushBatch(CShader::EType::Quad, EBatchBreak::BufferFull);
+				}
+
+				Count = std::min<std::size_t>(Instances.size() - Offset, QuadInstanceBufferLimit - QuadInstanceBufferPtr);
+				std::memcpy(QuadInstanceBufferPtr, Instances.data() + Offset, Count * sizeof(FQuadInstance));
+				QuadInstanceBufferPtr += Count;
+			}
+			else if (Specification.QuadVertexFormat == EQuadVertexFormat::Packed)
+			{
+				if ((QuadPackedVertexBufferLimit - QuadPackedVertexBufferPtr) < 4)
+				{
+					FlushBatch(CShader::EType::Quad, EBatchBreak::BufferFull);
+				}
+
+				Count = std::min<std::size_t>(Instances.size() - Offset, (QuadPackedVertexBufferLimit - QuadPackedVertexBufferPtr) / 4);
+				QuadKernel::GenerateVertices(Instances.subspan(Offset, Count), QuadPackedVertexBufferPtr);
+				QuadPackedVertexBufferPtr += Count * 4;
+				QuadIndexCount += static_cast<uint32_t>(Count * 6);
+			}
+			else
+			{
+				if ((QuadVertexBufferLimit - QuadVertexBufferPtr) < 4)
+				{
+					FlushBatch(CShader::EType::Quad, EBatchBreak::BufferFull);
+				}
+
+				Count = std::min<std::size_t>(Instances.size() - Offset, (QuadVertexBufferLimit - QuadVertexBufferPtr) / 4);
+				QuadKernel::GenerateVertices(Instances.subspan(Offset, Count), QuadVertexBufferPtr);
+				QuadVertexBufferPtr += Count * 4;
+				QuadIndexCount += static_cast<uint32_t>(Count * 6);
+			}
+
+			Offset += Count;
+		}
+	}
+
+	void CRenderer::DrawStaticBatch(CStaticBatch& Batch)
+	{
+		LK_ASSERT(CDrawRecorder::GetThreadContext() == nullptr, "Static batches cannot be recorded");
+		if (Batch.IsEmpty())
+		{
+			return;
+		}
+
+		if (Batch.Buffers == nullptr)
+		{
+			Batch.Buffers = new FStaticBatchBuffers();
+		}
+		if (Batch.IsDirty())
+		{
+			UploadStaticBatch(Batch);
+		}
+
+		const uint64_t QuadCount = Batch.GetQuadCount();
+		const glm::vec2 Center = (Batch.GetBoundsMin() + Batch.GetBoundsMax()) * 0.50f;
+		const glm::vec2 HalfExtent = (Batch.GetBoundsMax() - Batch.GetBoundsMin()) * 0.50f;
+		if (!Data.View.Overlaps(Center, HalfExtent))
+		{
+			DrawStats.CulledCount += QuadCount;
+			return;
+		}
+		DrawStats.SubmittedCount += QuadCount;
+		DrawStats.QuadCount += QuadCount;
+		DrawStats.VertexCount += 4 * QuadCount;
+
+		SubmitCommand([Buffers = Batch.Buffers, QuadCount]()
+		{
+			DrawStaticBatchBuffers(*Buffers, QuadCount);
+		});
+	}
+
+	void CRenderer::DrawStaticBatchBuffers(const FStaticBatchBuffers& Buffers, const uint64_t QuadCount)
+	{
+		FDrawStatistics& Stats = GetRenderStats();
+		QuadShader->Bind();
+		CameraUniformBuffer->Bind();
+		Data.TextureArray->Bind(TextureArrayUnit);
+		OpenGL::State::BindVertexArray(Buffers.VAO);
+		if (Specification.QuadRenderPath == EQuadRenderPath::Instanced)
+		{
+			LK_OpenGL_Verify(glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(QuadCount)));
+			Stats.DrawCallCount++;
+		}
+		else
+		{
+			/* The shared index buffer covers MaxQuads, larger batches are drawn in ranges. */
+			for (uint64_t Offset = 0; Offset < QuadCount; Offset += MaxQuads)
+			{
+				const uint64_t Count = std::min<uint64_t>(QuadCount - Offset, MaxQuads);
+				LK_OpenGL_Verify(glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(Count * 6), GL_UNSIGNED_INT,
+														  nullptr, static_cast<GLint>(Offset * 4)));
+				Stats.DrawCallCount++;
+				Stats.IndexCount += Count * 6;
+			}
+		}
+	}
+
+	void CRenderer::UploadStaticBatch(CStaticBatch& Batch)
+	{
+		const std::span<const FQuadInstance> Quads = Batch.GetQuads();
+		if (RenderThread)
+		{
+			/* The quads are copied behind the command, the batch may change before it is executed. */
+			void* Payload = GetSubmissionQueue().Allocate([](void* Payload)
+			{
+				const FStaticBatchUpload& Upload = *static_cast<const FStaticBatchUpload*>(Payload);
+				WriteStaticBatchBuffers(*Upload.Buffers, { reinterpret_cast<const FQuadInstance*>(&Upload + 1), Upload.QuadCount });
+			}, static_cast<uint32_t>(sizeof(FStaticBatchUpload) + Quads.size_bytes()));
+
+			FStaticBatchUpload* Upload = new (Payload) FStaticBatchUpload{ .Buffers = Batch.Buffers, .QuadCount = Quads.size() };
+			std::memcpy(Upload + 1, Quads.data(), Quads.size_bytes());
+		}
+		else
+		{
+			WriteStaticBatchBuffers(*Batch.Buffers, Quads);
+		}
+
+		Batch.bDirty = false;
+	}
+
+	void CRenderer::WriteStaticBatchBuffers(FStaticBatchBuffers& Buffers, const std::span<const FQuadInstance> Quads)
+	{
+		if (Buffers.VAO == 0)
+		{
+			Buffers.VAO = OpenGL::VertexArray::Create();
+			LK_OpenGL_Verify(glGenBuffers(1, &Buffers.VBO));
+			OpenGL::State::BindBuffer(GL_ARRAY_BUFFER, Buffers.VBO);
+			OpenGL::ApplyVertexBufferLayout(GetQuadLayout());
+			if (Specification.QuadRenderPath == EQuadRenderPath::Batched)
+			{
+				OpenGL::State::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, QuadEBO);
+			}
+		}
+
+		std::size_t DataSize = 0;
+		if (Specification.QuadRenderPath == EQuadRenderPath::Instanced)
+		{
+			DataSize = Quads.size_bytes();
+			LK_OpenGL_Verify(glNamedBufferData(Buffers.VBO, DataSize, Quads.data(), GL_STATIC_DRAW));
+		}
+		else if (Specification.QuadVertexFormat == EQuadVertexFormat::Packed)
+		{
+			std::vector<FQuadVertexPacked> Vertices(Quads.size() * 4);
+			QuadKernel::GenerateVertices(Quads, Vertices.data());
+			DataSize = Vertices.size() * sizeof(FQuadVertexPacked);
+			LK_OpenGL_Verify(glNamedBufferData(Buffers.VBO, DataSize, Vertices.data(), GL_STATIC_DRAW));
+		}
+		else
+		{
+			std::vector<FQuadVertex> Vertices(Quads.size() * 4);
+			QuadKernel::GenerateVertices(Quads, Vertices.data());
+			DataSize = Vertices.size() * sizeof(FQuadVertex);
+			LK_OpenGL_Verify(glNamedBufferData(Buffers.VBO, DataSize, Vertices.data(), GL_STATIC_DRAW));
+		}
+
+		LK_TRACE_TAG("Renderer", "Uploaded static batch: {} quads ({} bytes)", Quads.size(), DataSize);
+		GetRenderStats().BytesUploaded += DataSize;
+	}
+
+	void CRenderer::ReleaseStaticBatchBuffers(FStaticBatchBuffers* Buffers)
+	{
+		/* Recorded like a draw, so the buffers outlive any draw of the batch still waiting to be executed. */
+		SubmitCommand([Buffers]()
+		{
+			if (Buffers->VBO)
+			{
+				OpenGL::State::ForgetBuffer(Buffers->VBO);
+				LK_OpenGL_Verify(glDeleteBuffers(1, &Buffers->VBO));
+			}
+			if (Buffers->VAO)
+			{
+				OpenGL::State::ForgetVertexArray(Buffers->VAO);
+				LK_OpenGL_Verify(glDeleteVertexArrays(1, &Buffers->VAO));
+			}
+			delete Buffers;
+		});
+	}
+
 	void CRenderer::DrawLine(const glm::vec2& P0, const glm::vec2& P1, const glm::vec4& Color, const uint16_t LineWidth)
 	{
 		DrawLine({ P0.x, P0.y, 0.0f }, { P1.x, P1.y, 0.0f }, Color, LineWidth);
@@ -566,18 +1671,13 @@ namespace platformer2d {
 
 	void CRenderer::DrawLine(const glm::vec3& P0, const glm::vec3& P1, const glm::vec4& Color, const uint16_t LineWidth)
 	{
-		static constexpr glm::mat4 Proj = glm::mat4(1.0f);
+		FLineVertex* Vertex = AllocateLine(glm::max(P0.z, P1.z), (Color.a < 1.0f));
 
-		LineVertexBufferPtr->Position = P0;
-		LineVertexBufferPtr->Color = Color;
-		LineVertexBufferPtr++;
+		Vertex[0].Position = P0;
+		Vertex[0].Color = Color;
 
-		LineVertexBufferPtr->Position = P1;
-		LineVertexBufferPtr->Color = Color;
-		LineVertexBufferPtr++;
-
-		LineIndexCount += 2;
-		DrawStats.LineCount++;
+		Vertex[1].Position = P1;
+		Vertex[1].Color = Color;
 	}
 
 	void CRenderer::DrawCircle(const glm::vec2& P0, const glm::vec3& Rotation, const float Radius, const glm::vec4& Color)
@@ -598,16 +1698,35 @@ namespace platformer2d {
 
 	void CRenderer::DrawCircle(const glm::mat4& Transform, const glm::vec4& Color)
 	{
-		for (int Idx = 0; Idx < CIRCLE_SEGMENTS; Idx++)
+		/* The longest axis of the transform bounds the unit circle for any rotation. */
+		const float Radius = glm::max(glm::length(glm::vec3(Transform[0])), glm::length(glm::vec3(Transform[1])));
+		if (!IsInView(glm::vec2(Transform[3]), glm::vec2(Radius)))
+		{
+			return;
+		}
+
+		/* Without a scene the on-screen radius is unknown, use the most detailed allowed outline. */
+		const int Segments = (Data.PixelsPerUnit > 0.0f)
+			? CircleTable::GetSegmentCount(Radius * Data.PixelsPerUnit, Specification.CircleSegmentsMin, Specification.CircleSegmentsMax)
+			: Specification.CircleSegmentsMax;
+		const int Stride = CircleTable::MAX_SEGMENTS / Segments;
+		const bool bTranslucent = (Color.a < 1.0f);
+
+		const glm::vec3 First = Transform * glm::vec4(CircleTable::Points[0].X, CircleTable::Points[0].Y, 0.0f, 1.0f);
+		glm::vec3 Start = First;
+		for (int Idx = Stride; Idx <= CircleTable::MAX_SEGMENTS; Idx += Stride)
 		{
-			float AngleRad = 2.0f * glm::pi<float>() * static_cast<float>(Idx) / CIRCLE_SEGMENTS;
-			const glm::vec4 StartPos = { glm::cos(AngleRad), glm::sin(AngleRad), 0.0f, 1.0f };
-			AngleRad = 2.0f * glm::pi<float>() * static_cast<float>((Idx + 1) % CIRCLE_SEGMENTS) / CIRCLE_SEGMENTS;
-			const glm::vec4 EndPos = { glm::cos(AngleRad), glm::sin(AngleRad), 0.0f, 1.0f };
+			const glm::vec3 End = (Idx < CircleTable::MAX_SEGMENTS)
+				? glm::vec3(Transform * glm::vec4(CircleTable::Points[Idx].X, CircleTable::Points[Idx].Y, 0.0f, 1.0f))
+				: First;
 
-			const glm::vec3 P0 = Transform * StartPos;
-			const glm::vec3 P1 = Transform * EndPos;
-			DrawLine(P0, P1, Color);
+			FLineVertex* Vertex = AllocateLine(glm::max(Start.z, End.z), bTranslucent);
+			Vertex[0].Position = Start;
+			Vertex[0].Color = Color;
+			Vertex[1].Position = End;
+			Vertex[1].Color = Color;
+
+			Start = End;
 		}
 	}
 
@@ -618,40 +1737,43 @@ namespace platformer2d {
 
 	void CRenderer::DrawCircleFilled(const glm::vec3& P0, const float Radius, const glm::vec4& Color, const float Thickness)
 	{
+		if (!IsInView(P0, glm::vec2(glm::abs(Radius))))
+		{
+			return;
+		}
+
 		const glm::mat4 Transform = glm::translate(glm::mat4(1.0f), P0)
 			* glm::scale(glm::mat4(1.0f), { Radius * 2.0f, Radius * 2.0f, 1.0f });
 
+		/* The edge is anti-aliased in the fragment shader and therefore always blended. */
+		FCircleVertex* Vertex = AllocateCircle(P0.z, true);
 		for (int Idx = 0; Idx < 4; Idx++)
 		{
-			CircleVertexBufferPtr->WorldPosition = Transform * QuadVertexPositions[Idx];
-			CircleVertexBufferPtr->Thickness = Thickness;
-			CircleVertexBufferPtr->LocalPosition = QuadVertexPositions[Idx] * 2.0f;
-			CircleVertexBufferPtr->Color = Color;
-			CircleVertexBufferPtr++;
-
-			CircleIndexCount += 6;
-			DrawStats.QuadCount++;
+			Vertex->WorldPosition = Transform * QuadVertexPositions[Idx];
+			Vertex->Thickness = Thickness;
+			Vertex->LocalPosition = QuadVertexPositions[Idx] * 2.0f;
+			Vertex->Color = Color;
+			Vertex++;
 		}
 	}
 
 	void CRenderer::SetLineWidth(const uint16_t LineWidth)
 	{
 		LineConfig.Width = LineWidth;
-		LK_OpenGL_Verify(glLineWidth(LineConfig.Width));
+		SubmitCommand([Width = LineConfig.Width]()
+		{
+			LK_OpenGL_Verify(glLineWidth(Width));
+		});
 	}
 
 	void CRenderer::SetDepthTest(const bool Enabled)
 	{
 		LK_TRACE_TAG("Renderer", "Depth test: {}", Enabled ? "Enabled" : "Disabled");
 		Data.GL.bDepthTest = Enabled;
-		if (Enabled)
-		{
-			LK_OpenGL_Verify(glEnable(GL_DEPTH_TEST));
-		}
-		else
+		SubmitCommand([Enabled]()
 		{
-			LK_OpenGL_Verify(glDisable(GL_DEPTH_TEST));
-		}
+			OpenGL::State::SetEnabled(GL_DEPTH_TEST, Enabled);
+		});
 	}
 
 	bool CRenderer::GetDepthTest()
@@ -663,7 +1785,10 @@ namespace platformer2d {
 	{
 		LK_TRACE_TAG("Renderer", "Depth function: {}", DepthFunc);
 		Data.GL.DepthFunc = DepthFunc;
-		LK_OpenGL_Verify(glDepthFunc(Data.GL.DepthFunc));
+		SubmitCommand([DepthFunc]()
+		{
+			OpenGL::State::DepthFunc(DepthFunc);
+		});
 	}
 
 	uint32_t CRenderer::GetDepthFunction()
@@ -671,9 +1796,14 @@ namespace platformer2d {
 		return Data.GL.DepthFunc;
 	}
 
+	bool CRenderer::HasRenderThread()
+	{
+		return (RenderThread != nullptr);
+	}
+
 	const FDrawStatistics& CRenderer::GetDrawStatistics()
 	{
-		return DrawStats;
+		return LastFrameDrawStats;
 	}
 
 	void CRenderer::ResetDrawStatistics()
@@ -684,6 +1814,12 @@ namespace platformer2d {
 	void CRenderer::SetCameraViewProjection(const glm::mat4& ViewProj)
 	{
 		CameraData.ViewProjection = ViewProj;
+		SetViewBounds(ComputeViewBounds(CameraData.ViewProjection));
+	}
+
+	const FViewBounds& CRenderer::GetViewBounds()
+	{
+		return Data.View;
 	}
 
 	std::shared_ptr<CTexture> CRenderer::GetWhiteTexture()
@@ -702,6 +1838,35 @@ namespace platformer2d {
 		return Data.Textures;
 	}
 
+	const CTextureArray& CRenderer::GetTextureArray()
+	{
+		LK_ASSERT(Data.TextureArray);
+		return *Data.TextureArray;
+	}
+
+	void CRenderer::SetTextureFilter(const ETextureFilter Filter)
+	{
+		SubmitCommand([Filter]()
+		{
+			Data.TextureArray->SetFilter(Filter);
+		});
+	}
+
+	void CRenderer::FlushTextureUploads()
+	{
+		if (!TextureLoader)
+		{
+			return;
+		}
+
+		if (RenderThread)
+		{
+			RenderThread->Call([](void*) { TextureLoader->Flush(); });
+			return;
+		}
+		TextureLoader->Flush();
+	}
+
 	std::shared_ptr<CShader> CRenderer::GetShader(const CShader::EType ShaderType)
 	{
 		switch (ShaderType)
@@ -717,14 +1882,10 @@ namespace platformer2d {
 	void CRenderer::SetBlending(const bool Enabled)
 	{
 		Data.GL.bBlending = Enabled;
-		if (Enabled)
-		{
-			LK_OpenGL_Verify(glEnable(GL_BLEND));
-		}
-		else
+		SubmitCommand([Enabled]()
 		{
-			LK_OpenGL_Verify(glDisable(GL_BLEND));
-		}
+			OpenGL::State::SetEnabled(GL_BLEND, Enabled);
+		});
 	}
 
 	void CRenderer::SetBlendFunction(const uint32_t Source, const uint32_t Destination)
@@ -732,7 +1893,10 @@ namespace platformer2d {
 		Data.GL.BlendSource = Source;
 		Data.GL.BlendDestination = Destination;
 		LK_TRACE_TAG("Renderer", "Source={} Dst={}", Data.GL.BlendSource, Data.GL.BlendDestination);
-		LK_OpenGL_Verify(glBlendFunc(Data.GL.BlendSource, Data.GL.BlendDestination));
+		SubmitCommand([Source, Destination]()
+		{
+			OpenGL::State::BlendFunc(Source, Destination);
+		});
 	}
 
 	uint32_t CRenderer::GetBlendSource()
@@ -755,4 +1919,264 @@ namespace platformer2d {
 		bDebugRender = Enabled;
 	}
 
-}
\ No newline at end of file
+	void CRenderer::SetSubmissionMode(const ESubmissionMode Mode)
+	{
+		if (Mode == SubmissionMode)
+		{
+			return;
+		}
+
+		/* Draw everything recorded with the previous mode first. */
+		Flush();
+		SubmissionMode = Mode;
+		LK_DEBUG_TAG("Renderer", "Submission mode: {}", (Mode == ESubmissionMode::Sorted) ? "Sorted" : "Immediate");
+	}
+
+	void CRenderer::SetRenderLayer(const ERenderLayer Layer)
+	{
+		if (CDrawRecorder::FContext* Context = CDrawRecorder::GetThreadContext(); Context != nullptr)
+		{
+			Context->RenderLayer = Layer;
+			return;
+		}
+
+		RenderLayer = Layer;
+	}
+
+	ERenderLayer CRenderer::GetRenderLayer()
+	{
+		if (const CDrawRecorder::FContext* Context = CDrawRecorder::GetThreadContext(); Context != nullptr)
+		{
+			return Context->RenderLayer;
+		}
+
+		return RenderLayer;
+	}
+
+	void CRenderer::BeginRecording(const uint32_t Order)
+	{
+		DrawRecorder.Begin(Order);
+	}
+
+	void CRenderer::EndRecording()
+	{
+		DrawRecorder.End();
+	}
+
+	void CRenderer::SetRenderLayerSpecification(const ERenderLayer Layer, const FRenderLayerSpecification& LayerSpecification)
+	{
+		LK_ASSERT(Layer < ERenderLayer::COUNT);
+		LK_ASSERT(!LayerSpecification.bCached || LayerSpecification.bOffscreen, "Only offscreen layers can be cached");
+		LK_ASSERT(LayerSpecification.CacheThreshold >= 0.0f);
+		LK_ASSERT(!Data.ActiveLayer.bActive || (Data.ActiveLayer.Layer != Layer), "Layer changed while it is drawn");
+
+		FRenderLayerTarget& Target = Data.Layers[static_cast<int>(Layer)];
+		Target.Specification = LayerSpecification;
+		Target.bValid = false;
+		if (!LayerSpecification.bOffscreen)
+		{
+			Target.Size = glm::uvec2(0);
+			SubmitCommand([Layer]()
+			{
+				Data.Layers[static_cast<int>(Layer)].Framebuffer.reset();
+			});
+		}
+	}
+
+	const FRenderLayerSpecification& CRenderer::GetRenderLayerSpecification(const ERenderLayer Layer)
+	{
+		LK_ASSERT(Layer < ERenderLayer::COUNT);
+		return Data.Layers[static_cast<int>(Layer)].Specification;
+	}
+
+	bool CRenderer::BeginLayer(const ERenderLayer Layer)
+	{
+		LK_ASSERT(Layer < ERenderLayer::COUNT);
+		LK_ASSERT(!Data.ActiveLayer.bActive, "BeginLayer called inside another layer");
+		LK_ASSERT(CDrawRecorder::GetThreadContext() == nullptr, "Layers can only be drawn from the main thread");
+
+		/* Everything submitted so far ends up below the layer. */
+		Flush();
+
+		auto& Active = Data.ActiveLayer;
+		Active.bActive = true;
+		Active.bDrawing = true;
+		Active.Layer = Layer;
+		Active.PreviousLayer = RenderLayer;
+		RenderLayer = Layer;
+
+		FRenderLayerTarget& Target = Data.Layers[static_cast<int>(Layer)];
+		if (!Target.Specification.bOffscreen)
+		{
+			return true;
+		}
+
+		/* A cached layer is drawn with a margin on each side, so it can follow the camera for a while. */
+		const CWindow* Window = CWindow::Get();
+		const glm::vec2 ViewportSize(Window->GetWidth(), Window->GetHeight());
+		const glm::vec2 Margin(Target.Specification.bCached ? std::ceil(Target.Specification.CacheThreshold) : 0.0f);
+		const glm::uvec2 Size(ViewportSize + (2.0f * Margin));
+		if (Target.Size != Size)
+		{
+			/* The framebuffer is created or resized when the layer is drawn. */
+			Target.Size = Size;
+			Target.bValid = false;
+		}
+
+		if (Target.Specification.bCached && Target.bValid && IsLayerCacheValid(Target, CameraData.ViewProjection, ViewportSize))
+		{
+			Active.bDrawing = false;
+			DrawStats.LayerCacheHits++;
+			return false;
+		}
+
+		/* Shrink clip space so the viewport and its margin fit the framebuffer. */
+		Active.ViewProjection = CameraData.ViewProjection;
+		Active.View = Data.View;
+		const glm::vec2 Scale = ViewportSize / glm::vec2(Size);
+		CameraData.ViewProjection = glm::scale(glm::mat4(1.0f), glm::vec3(Scale, 1.0f)) * Active.ViewProjection;
+		UploadCameraData();
+		Data.View = ComputeViewBounds(CameraData.ViewProjection);
+
+		Target.ViewProjection = Active.ViewProjection;
+
+		/* Drawn while textures are loading, the cache would keep their placeholders until the camera moves. */
+		const bool bTexturesPending = TextureLoader && (TextureLoader->GetPendingCount() > 0);
+		Target.bValid = Target.Specification.bCached && !bTexturesPending;
+
+		SubmitCommand([Layer, Size, BlendSource = Data.GL.BlendSource, BlendDestination = Data.GL.BlendDestination]()
+		{
+			FRenderLayerTarget& Target = Data.Layers[static_cast<int>(Layer)];
+			if (!Target.Framebuffer)
+			{
+				Target.Framebuffer = std::make_unique<CFramebuffer>(Size.x, Size.y);
+			}
+			else
+			{
+				Target.Framebuffer->Resize(Size.x, Size.y);
+			}
+
+			Target.Framebuffer->Bind();
+			Target.Framebuffer->Clear(glm::vec4(0.0f));
+
+			/* Alpha is accumulated as coverage, which leaves premultiplied color in the framebuffer. */
+			OpenGL::State::BlendFuncSeparate(BlendSource, BlendDestination, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+		});
+		DrawStats.LayerRedraws++;
+
+		return true;
+	}
+
+	void CRenderer::EndLayer()
+	{
+		auto& Active = Data.ActiveLayer;
+		LK_ASSERT(Active.bActive, "EndLayer called without BeginLayer");
+
+		const FRenderLayerTarget& Target = Data.Layers[static_cast<int>(Active.Layer)];
+		if (Active.bDrawing)
+		{
+			Flush();
+			if (Target.Specification.bOffscreen)
+			{
+				CameraData.ViewProjection = Active.ViewProjection;
+				UploadCameraData();
+				Data.View = Active.View;
+
+				/* The window size is read here, the window is only written to by the main thread. */
+				const CWindow* Window = CWindow::Get();
+				SubmitCommand([BlendSource = Data.GL.BlendSource, BlendDestination = Data.GL.BlendDestination,
+							   Width = Window->GetWidth(), Height = Window->GetHeight()]()
+				{
+					CFramebuffer::BindDefault(Width, Height);
+					OpenGL::State::BlendFunc(BlendSource, BlendDestination);
+				});
+			}
+		}
+
+		if (Target.Specification.bOffscreen)
+		{
+			CompositeLayer(Active.Layer);
+		}
+
+		RenderLayer = Active.PreviousLayer;
+		Active.bActive = false;
+	}
+
+	void CRenderer::InvalidateLayer(const ERenderLayer Layer)
+	{
+		LK_ASSERT(Layer < ERenderLayer::COUNT);
+		Data.Layers[static_cast<int>(Layer)].bValid = false;
+	}
+
+	void CRenderer::CompositeLayer(const ERenderLayer Layer)
+	{
+		const FRenderLayerTarget& Target = Data.Layers[static_cast<int>(Layer)];
+		LK_ASSERT(Target.Size != glm::uvec2(0), "Layer has no framebuffer");
+
+		/* The image is moved along with the camera translation since it was drawn. */
+		const CWindow* Window = CWindow::Get();
+		const glm::vec2 ViewportSize(Window->GetWidth(), Window->GetHeight());
+		const glm::vec2 Offset = glm::vec2(CameraData.ViewProjection[3]) - glm::vec2(Target.ViewProjection[3]);
+		const glm::vec2 HalfSize = glm::vec2(Target.Size) / ViewportSize;
+
+		SubmitCommand([Layer, Rect = glm::vec4(Offset, HalfSize), GL = Data.GL]()
+		{
+			const FRenderLayerTarget& Target = Data.Layers[static_cast<int>(Layer)];
+			LK_ASSERT(Target.Framebuffer);
+			CompositeShader->Set(CompositeRectUniform, Rect);
+
+			OpenGL::State::BindTextureUnit(CompositeTextureUnit, GL_TEXTURE_2D, Target.Framebuffer->GetColorAttachment());
+			OpenGL::State::BindVertexArray(CompositeVAO);
+			OpenGL::State::SetEnabled(GL_BLEND, true);
+			OpenGL::State::SetEnabled(GL_DEPTH_TEST, false);
+			OpenGL::State::BlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+			LK_OpenGL_Verify(glDrawArrays(GL_TRIANGLE_STRIP, 0, 4));
+			OpenGL::State::BlendFunc(GL.BlendSource, GL.BlendDestination);
+			OpenGL::State::SetEnabled(GL_BLEND, GL.bBlending);
+			OpenGL::State::SetEnabled(GL_DEPTH_TEST, GL.bDepthTest);
+
+			FDrawStatistics& Stats = GetRenderStats();
+			Stats.DrawCallCount++;
+			Stats.VertexCount += 4;
+		});
+	}
+
+	void FDrawStatistics::Accumulate(const FDrawStatistics& Other)
+	{
+		QuadCount += Other.QuadCount;
+		LineCount += Other.LineCount;
+		CircleCount += Other.CircleCount;
+		DrawCallCount += Other.DrawCallCount;
+		FlushCount += Other.FlushCount;
+		for (std::size_t Idx = 0; Idx < BatchBreaks.size(); Idx++)
+		{
+			BatchBreaks[Idx] += Other.BatchBreaks[Idx];
+		}
+		RecordCount += Other.RecordCount;
+		VertexCount += Other.VertexCount;
+		IndexCount += Other.IndexCount;
+		BytesUploaded += Other.BytesUploaded;
+		TextureBinds += Other.TextureBinds;
+		ShaderBinds += Other.ShaderBinds;
+		StateCallsIssued += Other.StateCallsIssued;
+		StateCallsSkipped += Other.StateCallsSkipped;
+		FenceWaits += Other.FenceWaits;
+		SubmittedCount += Other.SubmittedCount;
+		CulledCount += Other.CulledCount;
+		LayerRedraws += Other.LayerRedraws;
+		LayerCacheHits += Other.LayerCacheHits;
+		TextureBytesUploaded += Other.TextureBytesUploaded;
+		TexturesPending += Other.TexturesPending;
+		CpuTimeMs += Other.CpuTimeMs;
+		RenderThreadTimeMs += Other.RenderThreadTimeMs;
+		RenderThreadWaitMs += Other.RenderThreadWaitMs;
+		RenderCommands += Other.RenderCommands;
+		RenderCommandBytes += Other.RenderCommandBytes;
+		RenderCommandBytesReserved += Other.RenderCommandBytesReserved;
+		for (std::size_t Idx = 0; Idx < GpuTimeMs.size(); Idx++)
+		{
+			GpuTimeMs[Idx] += Other.GpuTimeMs[Idx];
+		}
+	}
+
+}
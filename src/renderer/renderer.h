@@ -1,48 +1,188 @@
 #pragma once
 
+#include <array>
+#include <limits>
+#include <span>
 #include <utility>
 
 #include <glm/glm.hpp>
 
 #include "core/core.h"
+#include "core/timer.h"
 #include "backendinfo.h"
 #include "camera.h"
 #include "color.h"
+#include "drawlist.h"
+#include "drawrecorder.h"
+#include "gputimer.h"
 #include "imguilayer.h"
+#include "rendercommandqueue.h"
 #include "shader.h"
 #include "sprite.h"
+#include "staticbatch.h"
+#include "streambuffer.h"
 #include "texture.h"
+#include "texturearray.h"
+#include "textureloader.h"
 #include "uniformbuffer.h"
+#include "vertex.h"
 
 namespace platformer2d {
 
-	struct FQuadVertex
+	enum class ESubmissionMode
 	{
-		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
-		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
-		glm::vec2 TexCoord = { 0.0f, 0.0f };
-		int TexIndex = 0;
-		float TileFactor = 1.0f;
+		Immediate, /* Vertices are written to the batch in call order. */
+		Sorted,    /* Draws are recorded and sorted by key before the batches are built. */
 	};
 
-	struct FLineVertex
+	enum class EQuadRenderPath
 	{
-		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
-		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		Batched,   /* Four transformed vertices per quad, indexed. */
+		Instanced, /* One FQuadInstance per quad, expanded in the vertex shader. */
 	};
 
-	struct FCircleVertex
+	enum class EQuadVertexFormat
 	{
-		glm::vec3 WorldPosition = { 0.0f, 0.0f, 0.0f };
-		float Thickness = 1.0f;
-		glm::vec2 LocalPosition = { 0.0f, 0.0f };
-		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		Full,   /* FQuadVertex, 44 bytes. */
+		Packed, /* FQuadVertexPacked, 24 bytes. */
 	};
 
+	/**
+	 * @brief Render target of a layer, see CRenderer::BeginLayer.
+	 */
+	struct FRenderLayerSpecification
+	{
+		bool bOffscreen = false;     /* Drawn into a framebuffer that is composited with a single fullscreen quad. */
+		bool bCached = false;        /* Offscreen only, the framebuffer is kept until the layer is invalidated or the camera moves. */
+		float CacheThreshold = 4.0f; /* Camera movement in pixels covered by shifting the cached image. */
+	};
+
+	struct FRendererSpecification
+	{
+		/* The null backend builds and sorts every batch but sends nothing to a driver. */
+		ERenderBackend Backend = ERenderBackend::OpenGL;
+
+		/* Instanced quads only hold an axis aligned UV rect inside [0, 1], no tiling or arbitrary corners. */
+		EQuadRenderPath QuadRenderPath = EQuadRenderPath::Batched;
+		EQuadVertexFormat QuadVertexFormat = EQuadVertexFormat::Full; /* Batched path only. */
+
+		/* Falls back to BufferSubData if buffer storage is not supported. */
+		EVertexUploadMode VertexUploadMode = EVertexUploadMode::PersistentMapped;
+		uint8_t FramesInFlight = 3;
+
+		/* Outline circles use a power of two segment count in this range, picked by radius on screen. */
+		uint16_t CircleSegmentsMin = 8;
+		uint16_t CircleSegmentsMax = 64;
+
+#if defined(LK_OPENGL_ERROR_CHECK)
+		EOpenGLErrorCheck ErrorCheck = EOpenGLErrorCheck::Full;
+#elif defined(LK_BUILD_DEBUG)
+		EOpenGLErrorCheck ErrorCheck = EOpenGLErrorCheck::DebugCallback;
+#else
+		EOpenGLErrorCheck ErrorCheck = EOpenGLErrorCheck::None;
+#endif
+		uint16_t ErrorCheckInterval = 60; /* Sampled only. */
+
+		/* Textures are decoded on worker threads and drawn white until their upload completes. */
+		bool bAsyncTextureLoading = true;
+		uint32_t TextureUploadBudget = 4 * 1024 * 1024; /* Bytes uploaded per frame. */
+
+		/* Linked programs are stored in SHADER_CACHE_DIR and loaded on the next launch. */
+		bool bShaderCache = true;
+
+		/* GL calls are recorded and executed on a render thread one frame behind, draws are always recorded. */
+		bool bRenderThread = false;
+	};
+
+	/**
+	 * @brief Reason a batch was submitted.
+	 */
+	enum class EBatchBreak : uint8_t
+	{
+		Flush,      /* Explicit or end of frame flush. */
+		TypeChange, /* The sorted draw list moved on to another primitive type. */
+		BufferFull, /* The batch ran out of vertex or index space. */
+		COUNT
+	};
+
+	namespace Enum
+	{
+		inline constexpr const char* ToString(const EBatchBreak Reason)
+		{
+			switch (Reason)
+			{
+				case EBatchBreak::Flush:      return "Flush";
+				case EBatchBreak::TypeChange: return "TypeChange";
+				case EBatchBreak::BufferFull: return "BufferFull";
+				default: break;
+			}
+			return nullptr;
+		}
+	}
+
+	/**
+	 * @brief Draw statistics, collected per frame.
+	 */
 	struct FDrawStatistics
 	{
 		uint64_t QuadCount = 0;
 		uint64_t LineCount = 0;
+		uint64_t CircleCount = 0;
+		uint64_t DrawCallCount = 0;     /* Issued draw calls. */
+		uint64_t FlushCount = 0;        /* Submitted batches, static batches excluded. */
+		std::array<uint64_t, static_cast<int>(EBatchBreak::COUNT)> BatchBreaks{};
+		uint64_t RecordCount = 0;       /* Sorted draw records. */
+		uint64_t VertexCount = 0;       /* Vertices drawn, four per quad instance. */
+		uint64_t IndexCount = 0;        /* Indices drawn by indexed draw calls. */
+		uint64_t BytesUploaded = 0;     /* Vertex bytes submitted to the GPU. */
+		uint64_t TextureBinds = 0;      /* Texture binds passed on to the driver. */
+		uint64_t ShaderBinds = 0;       /* Program binds passed on to the driver. */
+		uint64_t StateCallsIssued = 0;  /* State changes passed on to the driver, see OpenGL::State. */
+		uint64_t StateCallsSkipped = 0; /* Redundant state changes dropped by OpenGL::State. */
+		uint32_t FenceWaits = 0;        /* Stalls on a stream buffer region still in use by the GPU. */
+		uint64_t SubmittedCount = 0;    /* Quads and circles that passed the view test. */
+		uint64_t CulledCount = 0;       /* Quads and circles rejected by the view test. */
+		uint64_t LayerRedraws = 0;      /* Offscreen layers drawn into their framebuffer. */
+		uint64_t LayerCacheHits = 0;    /* Cached layers composited without being drawn. */
+		uint64_t TextureBytesUploaded = 0; /* Texture bytes streamed by the texture loader. */
+		uint32_t TexturesPending = 0;   /* Textures still drawn as the white placeholder. */
+		float CpuTimeMs = 0.0f;         /* Time between BeginFrame and EndFrame. */
+		float RenderThreadTimeMs = 0.0f; /* Time the render thread spent executing the frame. */
+		float RenderThreadWaitMs = 0.0f; /* Time EndFrame waited for the render thread to finish the previous frame. */
+		uint32_t RenderCommands = 0;           /* Commands recorded for the render thread. */
+		uint64_t RenderCommandBytes = 0;       /* Bytes of the recorded commands, see CRenderCommandQueue. */
+		uint64_t RenderCommandBytesReserved = 0; /* Pages held by both command queues. */
+
+		/* Read back a few frames late to not stall the GPU, see CGpuTimer. */
+		std::array<float, CGpuTimer::PASS_COUNT> GpuTimeMs{};
+
+		FORCEINLINE uint64_t GetBatchBreaks(const EBatchBreak Reason) const { return BatchBreaks[static_cast<int>(Reason)]; }
+		FORCEINLINE float GetGpuTime(const EGpuPass Pass) const { return GpuTimeMs[static_cast<int>(Pass)]; }
+
+		/**
+		 * @brief Add the counters and times of another set, used to merge recorded and rendered statistics.
+		 */
+		void Accumulate(const FDrawStatistics& Other);
+	};
+
+	/**
+	 * @brief World-space rectangle covered by the camera.
+	 * Unbounded until a scene is started.
+	 */
+	struct FViewBounds
+	{
+		glm::vec2 Min = glm::vec2(std::numeric_limits<float>::lowest());
+		glm::vec2 Max = glm::vec2(std::numeric_limits<float>::max());
+
+		/**
+		 * @brief Test an axis-aligned box against the bounds.
+		 * @param HalfExtent Half size of the box, must enclose the primitive.
+		 */
+		FORCEINLINE bool Overlaps(const glm::vec2& Center, const glm::vec2& HalfExtent) const
+		{
+			return ((Center.x + HalfExtent.x) >= Min.x) && ((Center.x - HalfExtent.x) <= Max.x)
+				&& ((Center.y + HalfExtent.y) >= Min.y) && ((Center.y - HalfExtent.y) <= Max.y);
+		}
 	};
 
 	class CRenderer
@@ -53,7 +193,7 @@ namespace platformer2d {
 		CRenderer(const CRenderer&) = delete;
 		CRenderer(CRenderer&&) = delete;
 
-		static void Initialize();
+		static void Initialize(const FRendererSpecification& InSpecification = {});
 		static void Destroy();
 
 		static void BeginFrame();
@@ -77,6 +217,21 @@ namespace platformer2d {
 		static void DrawQuad(const glm::vec3& Pos, const glm::vec2& Size, const CTexture& Texture, const FSpriteUV& UV, const glm::vec4& Color, float RotationDeg = 0.0f);
 		static void DrawQuad(const glm::vec2& Pos, const glm::vec2& Size, ETexture Texture, const glm::vec4& Color = {1.0f, 1.0f, 1.0f, 0.0f}, float RotationDeg = 0.0f);
 
+		/**
+		 * @brief Submit quads in bulk.
+		 * Instances are copied as-is on the instanced path and expanded to vertices
+		 * by the vectorized quad kernel on the batched path.
+		 * Quads outside the view bounds are skipped.
+		 */
+		static void DrawQuads(std::span<const FQuadInstance> Instances);
+
+		/**
+		 * @brief Draw a retained batch with one draw call.
+		 * The batch is uploaded first if it changed since it was last drawn.
+		 * It is drawn immediately, before any quad still waiting in the current batch.
+		 */
+		static void DrawStaticBatch(CStaticBatch& Batch);
+
 		static void DrawLine(const glm::vec2& P0, const glm::vec2& P1, const glm::vec4& Color, uint16_t LineWidth = 8);
 		static void DrawLine(const glm::vec3& P0, const glm::vec3& P1, const glm::vec4& Color, uint16_t LineWidth = 8);
 
@@ -96,14 +251,60 @@ namespace platformer2d {
 
 		static const FBackendInfo& GetBackendInfo() { return BackendInfo; }
 
+		/**
+		 * @brief Whether GL calls are executed on a render thread, see FRendererSpecification::bRenderThread.
+		 */
+		static bool HasRenderThread();
+
+		/**
+		 * @brief Run a command on the calling thread, or record it for the render thread.
+		 * Everything the command reads from the main thread has to be captured by value.
+		 */
+		template<typename TFunction>
+		static void SubmitCommand(TFunction&& Function)
+		{
+			if (!HasRenderThread())
+			{
+				Function();
+				return;
+			}
+
+			GetSubmissionQueue().Submit(std::forward<TFunction>(Function));
+		}
+
+		/**
+		 * @brief Statistics of the last completed frame.
+		 * With a render thread that is the frame before the last one ended.
+		 */
 		static const FDrawStatistics& GetDrawStatistics();
 		static void ResetDrawStatistics();
 
 		static void SetCameraViewProjection(const glm::mat4& ViewProj);
 
+		/**
+		 * @brief View used to cull quads and circles, set by BeginScene.
+		 */
+		static const FViewBounds& GetViewBounds();
+
 		static std::shared_ptr<CTexture> GetWhiteTexture();
 		static std::shared_ptr<CTexture> GetTexture(ETexture Texture);
 		static const std::unordered_map<ETexture, std::shared_ptr<CTexture>>& GetTextures();
+
+		/**
+		 * @brief Texture array holding the pixels of every texture, see CTextureArray.
+		 */
+		static const CTextureArray& GetTextureArray();
+
+		/**
+		 * @brief Set the filter of every texture.
+		 * The textures share the sampler of the texture array, there is no per texture filter or wrap.
+		 */
+		static void SetTextureFilter(ETextureFilter Filter);
+
+		/**
+		 * @brief Block until every texture has been decoded and uploaded.
+		 */
+		static void FlushTextureUploads();
 		static std::shared_ptr<CShader> GetShader(CShader::EType ShaderType);
 
 		static void SetBlending(bool Enabled);
@@ -114,25 +315,88 @@ namespace platformer2d {
 
 		static void SetDebugRender(bool Enabled);
 
+		static void SetSubmissionMode(ESubmissionMode Mode);
+		static ESubmissionMode GetSubmissionMode() { return SubmissionMode; }
+		static void SetRenderLayer(ERenderLayer Layer);
+		static ERenderLayer GetRenderLayer();
+
+		static void SetRenderLayerSpecification(ERenderLayer Layer, const FRenderLayerSpecification& LayerSpecification);
+		static const FRenderLayerSpecification& GetRenderLayerSpecification(ERenderLayer Layer);
+
+		/**
+		 * @brief Start drawing the content of a layer, main thread only.
+		 *
+		 * Anything submitted before is flushed first. An offscreen layer is drawn into its
+		 * framebuffer and composited when the layer ends, below anything drawn afterwards.
+		 * @return false if the layer is cached and still valid, nothing may be drawn until EndLayer.
+		 */
+		static bool BeginLayer(ERenderLayer Layer);
+		static void EndLayer();
+
+		/**
+		 * @brief Redraw a cached layer the next time it is begun.
+		 */
+		static void InvalidateLayer(ERenderLayer Layer);
+
+		/**
+		 * @brief Record the draws of the calling thread into its own context.
+		 *
+		 * Any thread may record between BeginRecording and EndRecording. The contexts
+		 * are merged by ascending order on the next flush, after the draws of the main thread.
+		 * Every recording thread must have called EndRecording before the flush.
+		 */
+		static void BeginRecording(uint32_t Order);
+		static void EndRecording();
+
 	private:
+		static CRenderCommandQueue& GetSubmissionQueue();
+		static FQuadVertex* AllocateQuad(float Depth, int TexIndex, bool bTranslucent);
+		static FQuadVertexPacked* AllocateQuadPacked();
+		static FQuadInstance* AllocateQuadInstance(float Depth, int TexIndex, bool bTranslucent);
+		static FLineVertex* AllocateLine(float Depth, bool bTranslucent);
+		static FCircleVertex* AllocateCircle(float Depth, bool bTranslucent);
+		static void SubmitQuadVertices(const FQuadVertex (&Vertices)[4], float Depth, int TexIndex, bool bTranslucent);
+		static void SubmitQuad(const glm::vec3& Pos, const glm::vec2& Size, float RotationDeg, const glm::vec4& Color,
+							   const glm::vec2 (&TexCoords)[4], int TexIndex, bool bTranslucent);
+		static void SubmitQuadInstances(std::span<const FQuadInstance> Instances);
+		static void UploadStaticBatch(CStaticBatch& Batch);
+		static const FVertexBufferLayout& GetQuadLayout();
+		static void UploadCameraData();
+
+		static void SubmitDrawList(CDrawList& List, bool bSort);
+		static void FlushBatch(CShader::EType BatchType, EBatchBreak Reason);
+		static void ResetBatch(CShader::EType BatchType);
+
+		/* Executed on the render thread if there is one. */
+		static void ExecuteBeginFrame(const glm::vec4& InClearColor);
+		static void ExecuteEndFrame(ImDrawData* ImGuiDrawData);
+		static void WriteStaticBatchBuffers(FStaticBatchBuffers& Buffers, std::span<const FQuadInstance> Quads);
+		static void DrawStaticBatchBuffers(const FStaticBatchBuffers& Buffers, uint64_t QuadCount);
+		static void ReleaseStaticBatchBuffers(FStaticBatchBuffers* Buffers);
+
 		static void SetupQuadRenderer();
 		static void SetupLineRenderer();
 		static void SetupCircleRenderer();
+		static void SetupCompositeRenderer();
+		static void CompositeLayer(ERenderLayer Layer);
 		static void LoadTextures();
 
 		CRenderer& operator=(const CRenderer&) = delete;
 		CRenderer& operator=(CRenderer&&) = delete;
 
+		friend class CStaticBatch;
+
 	public:
 		static constexpr int MAX_TEXTURES = 16;
+		static constexpr int MAX_ARRAY_TEXTURES = 256; /* Must match the quad shaders. */
 	private:
 		static inline bool bInitialized = false;
+		static inline FRendererSpecification Specification{};
 		static inline FBackendInfo BackendInfo;
 		static inline glm::vec4 ClearColor{ 0.20f, 0.20f, 0.20f, 1.0f };
 		static inline std::unique_ptr<CImGuiLayer> ImGuiLayer = nullptr;
 
 		static inline GLuint QuadVAO = 0;
-		static inline GLuint QuadVBO = 0;
 		static inline GLuint QuadEBO = 0;
 		static inline uint32_t QuadIndexCount = 0;
 		static constexpr glm::vec4 QuadVertexPositions[4] = {
@@ -143,34 +407,55 @@ namespace platformer2d {
 		};
 		static inline FQuadVertex* QuadVertexBufferBase = nullptr;
 		static inline FQuadVertex* QuadVertexBufferPtr = nullptr;
+		static inline FQuadVertex* QuadVertexBufferLimit = nullptr;
+		static inline FQuadVertexPacked* QuadPackedVertexBufferBase = nullptr;
+		static inline FQuadVertexPacked* QuadPackedVertexBufferPtr = nullptr;
+		static inline FQuadVertexPacked* QuadPackedVertexBufferLimit = nullptr;
+		static inline FQuadInstance* QuadInstanceBufferBase = nullptr;
+		static inline FQuadInstance* QuadInstanceBufferPtr = nullptr;
+		static inline FQuadInstance* QuadInstanceBufferLimit = nullptr;
+		static inline std::unique_ptr<CStreamBuffer> QuadVertexStream = nullptr; /* Vertices, packed vertices or instances. */
 		static inline std::shared_ptr<CShader> QuadShader = nullptr;
 
 		static inline GLuint LineVAO = 0;
-		static inline GLuint LineVBO = 0;
 		static inline GLuint LineEBO = 0;
 		static inline uint32_t LineIndexCount = 0;
 		static inline FLineVertex* LineVertexBufferBase = nullptr;
 		static inline FLineVertex* LineVertexBufferPtr = nullptr;
+		static inline FLineVertex* LineVertexBufferLimit = nullptr;
+		static inline std::unique_ptr<CStreamBuffer> LineVertexStream = nullptr;
 		static inline std::shared_ptr<CShader> LineShader = nullptr;
 		struct FLineConfig {
 			uint16_t Width = 2;
 		} static inline LineConfig;
 
 		static inline GLuint CircleVAO = 0;
-		static inline GLuint CircleVBO = 0;
 		static inline GLuint CircleEBO = 0;
 		static inline uint32_t CircleIndexCount = 0;
 		static inline FCircleVertex* CircleVertexBufferBase = nullptr;
 		static inline FCircleVertex* CircleVertexBufferPtr = nullptr;
+		static inline FCircleVertex* CircleVertexBufferLimit = nullptr;
+		static inline std::unique_ptr<CStreamBuffer> CircleVertexStream = nullptr;
 		static inline std::shared_ptr<CShader> CircleShader = nullptr;
 
+		static inline GLuint CompositeVAO = 0;
+		static inline std::shared_ptr<CShader> CompositeShader = nullptr;
+		static inline FUniformHandle CompositeRectUniform{};
+
 		struct FCameraData
 		{
 			glm::mat4 ViewProjection = glm::mat4(1.0f);
 		} static inline CameraData;
 		static inline std::unique_ptr<CUniformBuffer> CameraUniformBuffer = nullptr;
 
+		static inline std::unique_ptr<CGpuTimer> GpuTimer = nullptr;
+		static inline std::unique_ptr<CTextureLoader> TextureLoader = nullptr;
+		static inline CTimer FrameTimer;
+
 		static inline bool bDebugRender = false;
+
+		static inline ESubmissionMode SubmissionMode = ESubmissionMode::Immediate;
+		static inline ERenderLayer RenderLayer = ERenderLayer::World;
 	};
 
 }
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "renderthread.h"
+
+#include "core/window.h"
+
+namespace platformer2d {
+
+	CRenderThread::CRenderThread(CWindow* InWindow)
+		: Window(InWindow)
+	{
+		Thread = std::jthread([this](std::stop_token StopToken) { Run(StopToken); });
+		LK_DEBUG_TAG("RenderThread", "Started");
+	}
+
+	CRenderThread::~CRenderThread()
+	{
+		WaitForIdle();
+		Thread.request_stop();
+		WorkCondition.notify_all();
+		Thread.join();
+		LK_DEBUG_TAG("RenderThread", "Stopped");
+	}
+
+	void CRenderThread::Kick(CRenderCommandQueue& Queue)
+	{
+		{
+			std::unique_lock Lock(Mutex);
+			IdleCondition.wait(Lock, [this]() { return IsIdle(); });
+			PendingQueue = &Queue;
+		}
+		WorkCondition.notify_one();
+	}
+
+	void CRenderThread::Call(const FTask Task, void* Argument)
+	{
+		LK_ASSERT(!IsRenderThread(), "Call from the render thread would never return");
+		{
+			std::unique_lock Lock(Mutex);
+			IdleCondition.wait(Lock, [this]() { return IsIdle(); });
+			PendingTask = Task;
+			PendingArgument = Argument;
+		}
+		WorkCondition.notify_one();
+		WaitForIdle();
+	}
+
+	void CRenderThread::WaitForIdle()
+	{
+		std::unique_lock Lock(Mutex);
+		IdleCondition.wait(Lock, [this]() { return IsIdle(); });
+	}
+
+	bool CRenderThread::IsRenderThread() const
+	{
+		return (std::this_thread::get_id() == Thread.get_id());
+	}
+
+	bool CRenderThread::IsIdle() const
+	{
+		return (PendingQueue == nullptr) && (PendingTask == nullptr);
+	}
+
+	void CRenderThread::Run(std::stop_token StopToken)
+	{
+		if (Window)
+		{
+			Window->MakeContextCurrent();
+		}
+
+		while (true)
+		{
+			CRenderCommandQueue* Queue = nullptr;
+			FTask Task = nullptr;
+			void* Argument = nullptr;
+			{
+				/* Work submitted before the stop request is still executed. */
+				std::unique_lock Lock(Mutex);
+				if (!WorkCondition.wait(Lock, StopToken, [this]() { return !IsIdle(); }))
+				{
+					break;
+				}
+
+				Queue = PendingQueue;
+				Task = PendingTask;
+				Argument = PendingArgument;
+			}
+
+			if (Queue)
+			{
+				Queue->Execute();
+			}
+			if (Task)
+			{
+				Task(Argument);
+			}
+
+			{
+				std::scoped_lock Lock(Mutex);
+				PendingQueue = nullptr;
+				PendingTask = nullptr;
+				PendingArgument = nullptr;
+			}
+			IdleCondition.notify_all();
+		}
+
+		/* Released so the main thread can take the context back. */
+		if (Window)
+		{
+			Window->ReleaseContext();
+		}
+	}
+
+}
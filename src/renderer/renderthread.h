@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "core/core.h"
+#include "rendercommandqueue.h"
+
+namespace platformer2d {
+
+	class CWindow;
+
+	/**
+	 * @brief Thread that owns the GL context and executes recorded command queues.
+	 *
+	 * The main thread records a frame while the render thread executes the previous one,
+	 * see FRendererSpecification::bRenderThread. One queue or call is executed at a time,
+	 * submitting work waits for the previous work to finish.
+	 */
+	class CRenderThread
+	{
+	public:
+		using FTask = void(*)(void*);
+
+		/**
+		 * @param InWindow Window whose context is made current on the thread.
+		 *                 The context must not be current on any other thread.
+		 */
+		CRenderThread(CWindow* InWindow);
+		CRenderThread() = delete;
+		~CRenderThread();
+
+		/**
+		 * @brief Execute a queue on the render thread.
+		 * The queue must not be written to until the thread is idle again.
+		 */
+		void Kick(CRenderCommandQueue& Queue);
+
+		/**
+		 * @brief Run a function on the render thread and wait for it to return.
+		 */
+		void Call(FTask Task, void* Argument = nullptr);
+
+		/**
+		 * @brief Block until the kicked queue or call has been executed.
+		 */
+		void WaitForIdle();
+
+		bool IsRenderThread() const;
+
+	private:
+		void Run(std::stop_token StopToken);
+		bool IsIdle() const;
+
+		CRenderThread(const CRenderThread&) = delete;
+		CRenderThread& operator=(const CRenderThread&) = delete;
+
+	private:
+		CWindow* Window = nullptr;
+
+		std::mutex Mutex;
+		std::condition_variable_any WorkCondition;
+		std::condition_variable IdleCondition;
+		CRenderCommandQueue* PendingQueue = nullptr;
+		FTask PendingTask = nullptr;
+		void* PendingArgument = nullptr;
+
+		std::jthread Thread;
+	};
+
+}
@@ -7,6 +7,8 @@
 
 #include "core/assert.h"
 
+#include "shadercache.h"
+
 namespace platformer2d {
 
 	static_assert(std::is_same_v<uint32_t, GLuint>);
@@ -55,6 +57,12 @@ namespace platformer2d {
 
 		uint32_t Program;
 		LK_OpenGL_Verify(Program = glCreateProgram());
+		if (LoadCachedProgram(Source, Program))
+		{
+			RendererID = Program;
+			ReflectUniforms();
+			return;
+		}
 
 		const uint32_t VertexShader = CompileShader(GL_VERTEX_SHADER, Source.Vertex);
 		const uint32_t FragShader = CompileShader(GL_FRAGMENT_SHADER, Source.Fragment);
@@ -64,8 +72,10 @@ namespace platformer2d {
 		LK_OpenGL_Verify(glAttachShader(Program, FragShader));
 
 		/* Link and validate. */
+		LK_OpenGL_Verify(glProgramParameteri(Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
 		LK_OpenGL_Verify(glLinkProgram(Program));
 		LK_OpenGL_Verify(glValidateProgram(Program));
+		CShaderCache::Store(CacheKey, Program);
 
 		auto VerifyShaderProgram = [](const GLuint Shader) -> bool
 		{
@@ -87,6 +97,7 @@ namespace platformer2d {
 		LK_OpenGL_Verify(glDeleteShader(FragShader));
 
 		RendererID = Program;
+		ReflectUniforms();
 	}
 
 	CShader::CShader(const std::filesystem::path& VertexShaderPath, const std::filesystem::path& FragShaderPath)
@@ -98,18 +109,23 @@ namespace platformer2d {
 		/* Assign parent path to signal that this constructor was used. */
 		Filepath = VertexShaderPath.parent_path();
 
+		FShaderProgramSource Source{};
+		const uint16_t VertexShaderLines = ReadShaderFile(VertexShaderPath, Source.Vertex);
+		LK_VERIFY(VertexShaderLines > 0, "Failed reading vertex shader");
+		const uint16_t FragShaderLines = ReadShaderFile(FragShaderPath, Source.Fragment);
+		LK_VERIFY(FragShaderLines > 0, "Failed reading fragment shader");
+
 		uint32_t Program;
 		LK_OpenGL_Verify(Program = glCreateProgram());
+		if (LoadCachedProgram(Source, Program))
+		{
+			RendererID = Program;
+			ReflectUniforms();
+			return;
+		}
 
-		std::string VertexSource;
-		const uint16_t VertexShaderLines = ReadShaderFile(VertexShaderPath, VertexSource);
-		LK_VERIFY(VertexShaderLines > 0, "Failed reading vertex shader");
-		const uint32_t VertexShader = CompileShader(GL_VERTEX_SHADER, VertexSource);
-
-		std::string FragSource;
-		const uint16_t FragShaderLines = ReadShaderFile(FragShaderPath, FragSource);
-		LK_VERIFY(FragShaderLines > 0, "Failed reading fragment shader");
-		const uint32_t FragShader = CompileShader(GL_FRAGMENT_SHADER, FragSource);
+		const uint32_t VertexShader = CompileShader(GL_VERTEX_SHADER, Source.Vertex);
+		const uint32_t FragShader = CompileShader(GL_FRAGMENT_SHADER, Source.Fragment);
 
 		/* Attach shaders. */
 		LK_ASSERT((VertexShader != 0) && (FragShader != 0));
@@ -117,125 +133,192 @@ namespace platformer2d {
 		LK_OpenGL_Verify(glAttachShader(Program, FragShader));
 
 		/* Link and validate. */
+		LK_OpenGL_Verify(glProgramParameteri(Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
 		LK_OpenGL_Verify(glLinkProgram(Program));
 		LK_OpenGL_Verify(glValidateProgram(Program));
+		CShaderCache::Store(CacheKey, Program);
 
 		/* Delete shader resources after shader programs are created and validated. */
 		LK_OpenGL_Verify(glDeleteShader(VertexShader));
 		LK_OpenGL_Verify(glDeleteShader(FragShader));
 
 		RendererID = Program;
+		ReflectUniforms();
 	}
 
 	void CShader::Bind() const
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
+		OpenGL::State::UseProgram(RendererID);
 	}
 
 	void CShader::Unbind() const
 	{
-		LK_OpenGL_Verify(glUseProgram(0));
+		OpenGL::State::UseProgram(0);
 	}
 
-	void CShader::Get(std::string_view Uniform, glm::vec2& Value)
+	FUniformHandle CShader::GetUniform(const FUniformName& Uniform)
 	{
-		float ValueArray[2] = { 0 };
-		LK_OpenGL_Verify(glGetUniformfv(RendererID, GetUniformLocation(Uniform.data()), ValueArray));
-		Value.x = ValueArray[0];
-		Value.y = ValueArray[1];
+		if (auto Iter = Uniforms.find(Uniform.Id); Iter != Uniforms.end())
+		{
+			return Iter->second;
+		}
+
+		FUniformHandle Handle{};
+		const std::string Name(Uniform.Name);
+		LK_OpenGL_Verify(Handle.Location = glGetUniformLocation(RendererID, Name.c_str()));
+		Handle.Count = 1;
+		if (!Handle.IsValid())
+		{
+			LK_WARN_TAG("Shader", "Uniform '{}' is not in use ({})", Uniform.Name, Filepath.filename());
+		}
+
+		/* Unused names are cached as well so the warning is only logged once. */
+		Uniforms[Uniform.Id] = Handle;
+		return Handle;
 	}
 
-	void CShader::Get(std::string_view Uniform, glm::vec3& Value)
+	void CShader::Get(const FUniformHandle Uniform, glm::vec2& Value) const
 	{
-		float ValueArray[3] = { 0 };
-		LK_OpenGL_Verify(glGetUniformfv(RendererID, GetUniformLocation(Uniform.data()), ValueArray));
-		Value.x = ValueArray[0];
-		Value.y = ValueArray[1];
-		Value.z = ValueArray[2];
+		LK_ASSERT((Uniform.Type == 0) || (Uniform.Type == GL_FLOAT_VEC2), "Uniform type mismatch: {}", Uniform.Type);
+		LK_OpenGL_Verify(glGetUniformfv(RendererID, Uniform.Location, &Value.x));
 	}
 
-	void CShader::Get(std::string_view Uniform, glm::vec4& Value)
+	void CShader::Get(const FUniformHandle Uniform, glm::vec3& Value) const
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
-#if 0
-		LK_OpenGL_Verify(glGetUniformfv(RendererID, GetUniformLocation(Uniform.data()), &Value.x));
-#else
-		float ValueArray[4] = { 0 };
-		LK_OpenGL_Verify(glGetUniformfv(RendererID, GetUniformLocation(Uniform.data()), ValueArray));
-		Value.x = ValueArray[0];
-		Value.y = ValueArray[1];
-		Value.z = ValueArray[2];
-		Value.w = ValueArray[3];
-#endif
+		LK_ASSERT((Uniform.Type == 0) || (Uniform.Type == GL_FLOAT_VEC3), "Uniform type mismatch: {}", Uniform.Type);
+		LK_OpenGL_Verify(glGetUniformfv(RendererID, Uniform.Location, &Value.x));
 	}
 
-	void CShader::Set(std::string_view Uniform, const int Value)
+	void CShader::Get(const FUniformHandle Uniform, glm::vec4& Value) const
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
-		LK_OpenGL_Verify(glUniform1i(GetUniformLocation(Uniform.data()), Value));
+		LK_ASSERT((Uniform.Type == 0) || (Uniform.Type == GL_FLOAT_VEC4), "Uniform type mismatch: {}", Uniform.Type);
+		LK_OpenGL_Verify(glGetUniformfv(RendererID, Uniform.Location, &Value.x));
 	}
 
-	void CShader::Set(std::string_view Uniform, const uint32_t Value)
+	void CShader::Set(const FUniformHandle Uniform, const int Value)
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
-		LK_OpenGL_Verify(glUniform1ui(GetUniformLocation(Uniform.data()), Value));
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform1i(Uniform.Location, Value));
 	}
 
-	void CShader::Set(std::string_view Uniform, const float Value)
+	void CShader::Set(const FUniformHandle Uniform, const uint32_t Value)
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
-		LK_OpenGL_Verify(glUniform1f(GetUniformLocation(Uniform.data()), Value));
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform1ui(Uniform.Location, Value));
 	}
 
-	void CShader::Set(std::string_view Uniform, const bool Value)
+	void CShader::Set(const FUniformHandle Uniform, const float Value)
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
-		LK_OpenGL_Verify(glUniform1i(GetUniformLocation(Uniform.data()), static_cast<int>(Value)));
+		LK_ASSERT((Uniform.Type == 0) || (Uniform.Type == GL_FLOAT), "Uniform type mismatch: {}", Uniform.Type);
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform1f(Uniform.Location, Value));
 	}
 
-	void CShader::Set(std::string_view Uniform, const glm::vec2& Value)
+	void CShader::Set(const FUniformHandle Uniform, const bool Value)
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
-		LK_OpenGL_Verify(glUniform2f(GetUniformLocation(Uniform.data()), Value.x, Value.y));
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform1i(Uniform.Location, static_cast<int>(Value)));
 	}
 
-	void CShader::Set(std::string_view Uniform, const glm::vec3& Value)
+	void CShader::Set(const FUniformHandle Uniform, const glm::vec2& Value)
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
-		LK_OpenGL_Verify(glUniform3f(GetUniformLocation(Uniform.data()), Value.x, Value.y, Value.z));
+		LK_ASSERT((Uniform.Type == 0) || (Uniform.Type == GL_FLOAT_VEC2), "Uniform type mismatch: {}", Uniform.Type);
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform2f(Uniform.Location, Value.x, Value.y));
 	}
 
-	void CShader::Set(std::string_view Uniform, const glm::vec4& Value)
+	void CShader::Set(const FUniformHandle Uniform, const glm::vec3& Value)
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
-		LK_OpenGL_Verify(glUniform4f(GetUniformLocation(Uniform.data()), Value.x, Value.y, Value.z, Value.w));
+		LK_ASSERT((Uniform.Type == 0) || (Uniform.Type == GL_FLOAT_VEC3), "Uniform type mismatch: {}", Uniform.Type);
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform3f(Uniform.Location, Value.x, Value.y, Value.z));
 	}
 
-	void CShader::Set(std::string_view Uniform, const glm::mat4& Value)
+	void CShader::Set(const FUniformHandle Uniform, const glm::vec4& Value)
 	{
-		LK_OpenGL_Verify(glUseProgram(RendererID));
-		LK_OpenGL_Verify(glUniformMatrix4fv(GetUniformLocation(Uniform.data()), 1, GL_FALSE, &Value[0][0]));
+		LK_ASSERT((Uniform.Type == 0) || (Uniform.Type == GL_FLOAT_VEC4), "Uniform type mismatch: {}", Uniform.Type);
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform4f(Uniform.Location, Value.x, Value.y, Value.z, Value.w));
 	}
 
-	int CShader::GetUniformLocation(const std::string& Uniform)
+	void CShader::Set(const FUniformHandle Uniform, const glm::mat4& Value)
 	{
-		if (UniformLocationCache.find(Uniform) != UniformLocationCache.end())
-		{
-			return UniformLocationCache[Uniform];
-		}
+		LK_ASSERT((Uniform.Type == 0) || (Uniform.Type == GL_FLOAT_MAT4), "Uniform type mismatch: {}", Uniform.Type);
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniformMatrix4fv(Uniform.Location, 1, GL_FALSE, &Value[0][0]));
+	}
+
+	void CShader::Set(const FUniformHandle Uniform, const std::span<const int> Values)
+	{
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform1iv(Uniform.Location, static_cast<GLsizei>(Values.size()), Values.data()));
+	}
+
+	void CShader::Set(const FUniformHandle Uniform, const std::span<const uint32_t> Values)
+	{
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform1uiv(Uniform.Location, static_cast<GLsizei>(Values.size()), Values.data()));
+	}
+
+	void CShader::Set(const FUniformHandle Uniform, const std::span<const glm::vec4> Values)
+	{
+		LK_ASSERT((Uniform.Type == 0) || (Uniform.Type == GL_FLOAT_VEC4), "Uniform type mismatch: {}", Uniform.Type);
+		LK_ASSERT((Uniform.Type == 0) || (Values.size() <= static_cast<std::size_t>(Uniform.Count)),
+				  "{} values set on an array of {}", Values.size(), Uniform.Count);
+		OpenGL::State::UseProgram(RendererID);
+		LK_OpenGL_Verify(glUniform4fv(Uniform.Location, static_cast<GLsizei>(Values.size()), &Values.data()->x));
+	}
+
+	void CShader::ReflectUniforms()
+	{
+		Uniforms.clear();
+		GLint Count = 0;
+		LK_OpenGL_Verify(glGetProgramInterfaceiv(RendererID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &Count));
 
-		int UniformLocation;
-		LK_OpenGL_Verify(UniformLocation = glGetUniformLocation(RendererID, Uniform.c_str()));
-		if (UniformLocation != -1)
+		constexpr GLenum Properties[] = { GL_NAME_LENGTH, GL_TYPE, GL_LOCATION, GL_ARRAY_SIZE };
+		std::string Name;
+		for (GLint Idx = 0; Idx < Count; Idx++)
 		{
-			UniformLocationCache[Uniform] = UniformLocation;
+			GLint Values[std::size(Properties)] = {};
+			LK_OpenGL_Verify(glGetProgramResourceiv(RendererID, GL_UNIFORM, Idx, std::size(Properties), Properties,
+													std::size(Values), nullptr, Values));
+
+			/* Members of uniform blocks have no location. */
+			const GLint Location = Values[2];
+			if (Location < 0)
+			{
+				continue;
+			}
+
+			Name.resize(Values[0]);
+			GLsizei Length = 0;
+			LK_OpenGL_Verify(glGetProgramResourceName(RendererID, GL_UNIFORM, Idx, Values[0], &Length, Name.data()));
+			Name.resize(Length);
+			if (Name.ends_with("[0]"))
+			{
+				Name.resize(Name.size() - 3);
+			}
+
+			const FUniformHandle Handle = {
+				.Location = Location,
+				.Type = static_cast<GLenum>(Values[1]),
+				.Count = Values[3],
+			};
+			const bool bInserted = Uniforms.emplace(FUniformName(Name).Id, Handle).second;
+			LK_ASSERT(bInserted, "Uniform hash collision: {} ({})", Name, Filepath.filename());
 		}
-		else
+	}
+
+	bool CShader::LoadCachedProgram(const FShaderProgramSource& Source, const LRendererID Program)
+	{
+		if (!CShaderCache::IsEnabled())
 		{
-			LK_WARN_TAG("Shader", "Uniform '{}' is not in use ({})", Uniform, Filepath.filename());
+			return false;
 		}
 
-		return UniformLocation;
+		CacheKey = CShaderCache::GetKey(Source);
+		bCached = CShaderCache::Load(CacheKey, Program);
+		return bCached;
 	}
 
 	uint32_t CShader::CompileShader(const uint32_t ShaderType, const std::string& ShaderSource)
@@ -1,12 +1,14 @@
 #pragma once
 
 #include <filesystem>
+#include <span>
 #include <unordered_map>
 
 #include <glm/glm.hpp>
 
 #include "core/assert.h"
 #include "core/core.h"
+#include "core/hash.h"
 #include "core/log.h"
 
 #include "opengl.h"
@@ -31,6 +33,44 @@ namespace platformer2d {
 		}
 	};
 
+	/**
+	 * @brief Uniform name with its hash, computed at compile time for constexpr names.
+	 */
+	struct FUniformName
+	{
+		std::string_view Name{};
+		uint64_t Id = 0;
+
+		constexpr FUniformName(const char* InName)
+			: FUniformName(std::string_view(InName))
+		{
+		}
+
+		constexpr FUniformName(const std::string_view InName)
+			: Name(InName)
+			, Id(Hash::FNV1a(InName))
+		{
+		}
+
+		constexpr FUniformName(const std::string& InName)
+			: FUniformName(std::string_view(InName))
+		{
+		}
+	};
+
+	/**
+	 * @brief Resolved uniform of a shader, see CShader::GetUniform.
+	 * Setting an invalid handle is a no-op, like a location of -1.
+	 */
+	struct FUniformHandle
+	{
+		int Location = -1;
+		GLenum Type = 0; /* Zero if not reflected. */
+		int Count = 0;   /* Array size, 1 if not an array. */
+
+		FORCEINLINE bool IsValid() const { return (Location >= 0); }
+	};
+
 	class CShader
 	{
 	public:
@@ -47,59 +87,82 @@ namespace platformer2d {
 		FORCEINLINE LRendererID GetRendererID() const { return RendererID; }
 		const std::filesystem::path& GetFilepath() const { return Filepath; }
 
-		int GetUniformLocation(const std::string& Uniform);
+		/** @brief true if the program was linked from the shader cache instead of compiled. */
+		FORCEINLINE bool IsBinaryCached() const { return bCached; }
+
+		/**
+		 * @brief Resolve a uniform to a handle.
+		 * Active uniforms are reflected when the program is linked, so this is a single
+		 * lookup by hash. Array uniforms are reflected without the [0] suffix.
+		 * Names that are not reflected, such as single array elements, are queried
+		 * from the driver once. The handle is invalid if the uniform is not in use.
+		 */
+		FUniformHandle GetUniform(const FUniformName& Uniform);
+
+		/** @brief Active uniforms reflected at link time, keyed by FUniformName::Id. */
+		const std::unordered_map<uint64_t, FUniformHandle>& GetUniforms() const { return Uniforms; }
+
+		void Get(FUniformHandle Uniform, glm::vec2& Value) const;
+		void Get(FUniformHandle Uniform, glm::vec3& Value) const;
+		void Get(FUniformHandle Uniform, glm::vec4& Value) const;
+		void Set(FUniformHandle Uniform, int Value);
+		void Set(FUniformHandle Uniform, uint32_t Value);
+		void Set(FUniformHandle Uniform, float Value);
+		void Set(FUniformHandle Uniform, bool Value);
+		void Set(FUniformHandle Uniform, const glm::vec2& Value);
+		void Set(FUniformHandle Uniform, const glm::vec3& Value);
+		void Set(FUniformHandle Uniform, const glm::vec4& Value);
+		void Set(FUniformHandle Uniform, const glm::mat4& Value);
+		void Set(FUniformHandle Uniform, std::span<const int> Values);
+		void Set(FUniformHandle Uniform, std::span<const uint32_t> Values);
+		void Set(FUniformHandle Uniform, std::span<const glm::vec4> Values);
+
+		/* Resolved on every call, keep a handle for uniforms that are set every frame. */
+		template<typename T>
+		void Get(const FUniformName& Uniform, T& Value)
+		{
+			Get(GetUniform(Uniform), Value);
+		}
 
-		void Get(std::string_view Uniform, glm::vec2& Value);
-		void Get(std::string_view Uniform, glm::vec3& Value);
-		void Get(std::string_view Uniform, glm::vec4& Value);
-		void Set(std::string_view Uniform, int Value);
-		void Set(std::string_view Uniform, uint32_t Value);
-		void Set(std::string_view Uniform, float Value);
-		void Set(std::string_view Uniform, bool Value);
-		void Set(std::string_view Uniform, const glm::vec2& Value);
-		void Set(std::string_view Uniform, const glm::vec3& Value);
-		void Set(std::string_view Uniform, const glm::vec4& Value);
-		void Set(std::string_view Uniform, const glm::mat4& Value);
+		template<typename T>
+		void Set(const FUniformName& Uniform, const T& Value)
+		{
+			Set(GetUniform(Uniform), Value);
+		}
 
 		template<std::size_t N>
-		void Set(std::string_view Uniform, const std::array<int, N>& Value)
+		void Set(const FUniformName& Uniform, const std::array<int, N>& Value)
 		{
 			static_assert(N > 0);
-			LK_OpenGL_Verify(glUseProgram(RendererID));
-			LK_OpenGL_Verify(glUniform1iv(GetUniformLocation(Uniform.data()), N, Value.data()));
+			Set(GetUniform(Uniform), std::span<const int>(Value));
 		}
 
 		template<std::size_t N>
-		void Set(std::string_view Uniform, const std::array<uint32_t, N>& Value)
+		void Set(const FUniformName& Uniform, const std::array<uint32_t, N>& Value)
 		{
 			static_assert(N > 0);
-			LK_OpenGL_Verify(glUseProgram(RendererID));
-			LK_OpenGL_Verify(glUniform1ui(GetUniformLocation(Uniform.data()), N, Value.data()));
+			Set(GetUniform(Uniform), std::span<const uint32_t>(Value));
 		}
 
 		template<typename T>
-		void Set(std::string_view Uniform, const T* Array, const std::size_t ArrSize)
+		void Set(const FUniformName& Uniform, const T* Array, const std::size_t ArrSize)
 		{
 			static_assert(std::disjunction_v<std::is_same<T, int>,
 											 std::is_same<T, uint32_t>>);
-			LK_OpenGL_Verify(glUseProgram(RendererID));
-			if constexpr (std::is_same_v<T, int>)
-			{
-				LK_OpenGL_Verify(glUniform1iv(GetUniformLocation(Uniform.data()), ArrSize, Array));
-			}
-			else if constexpr (std::is_same_v<T, uint32_t>)
-			{
-				LK_OpenGL_Verify(glUniform1ui(GetUniformLocation(Uniform.data()), ArrSize, Array));
-			}
+			Set(GetUniform(Uniform), std::span<const T>(Array, ArrSize));
 		}
 
 	private:
 		uint32_t CompileShader(uint32_t ShaderType, const std::string& ShaderSource);
 		bool ParseShader(const std::filesystem::path& Filepath, FShaderProgramSource& Source);
+		bool LoadCachedProgram(const FShaderProgramSource& Source, LRendererID Program);
+		void ReflectUniforms();
 
 	private:
 		LRendererID RendererID;
-		std::unordered_map<std::string, int> UniformLocationCache{};
+		std::unordered_map<uint64_t, FUniformHandle> Uniforms{};
 		std::filesystem::path Filepath;
+		uint64_t CacheKey = 0;
+		bool bCached = false;
 	};
 }
\ No newline at end of file
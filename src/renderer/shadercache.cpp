@@ -0,0 +1,182 @@
+#include "shadercache.h"
+
+#include <format>
+#include <fstream>
+#include <vector>
+
+#include "core/hash.h"
+#include "opengl.h"
+#include "shader.h"
+
+namespace platformer2d {
+
+	namespace
+	{
+		constexpr uint32_t CacheMagic = 0x43534B4C; /* 'LKSC' */
+		constexpr uint32_t CacheVersion = 1;
+
+		struct FCacheHeader
+		{
+			uint32_t Magic = CacheMagic;
+			uint32_t Version = CacheVersion;
+			uint64_t Key = 0;
+			uint32_t BinaryFormat = 0;
+			uint32_t BinaryLength = 0;
+		};
+		static_assert(sizeof(FCacheHeader) == 24);
+	}
+
+	void CShaderCache::Initialize(const FBackendInfo& BackendInfo, const std::filesystem::path& InDirectory)
+	{
+		Directory = InDirectory;
+		Statistics = {};
+		if (BackendInfo.ProgramBinaryFormats <= 0)
+		{
+			LK_WARN_TAG("ShaderCache", "No program binary formats, shaders are compiled on every launch");
+			bEnabled = false;
+			return;
+		}
+
+		/* The binaries are only valid for the exact driver that created them. */
+		DriverHash = Hash::FNV1a(BackendInfo.Vendor);
+		DriverHash = Hash::FNV1a(BackendInfo.Renderer, DriverHash);
+		DriverHash = Hash::FNV1a(BackendInfo.VersionString, DriverHash);
+
+		std::error_code Error;
+		std::filesystem::create_directories(Directory, Error);
+		if (Error)
+		{
+			LK_WARN_TAG("ShaderCache", "Failed to create {}: {}", Directory, Error.message());
+			bEnabled = false;
+			return;
+		}
+
+		bEnabled = true;
+		LK_INFO_TAG("ShaderCache", "Enabled ({}, {} binary formats)", Directory, BackendInfo.ProgramBinaryFormats);
+	}
+
+	void CShaderCache::Destroy()
+	{
+		if (bEnabled)
+		{
+			LK_DEBUG_TAG("ShaderCache", "Hits: {} Misses: {} Rejected: {}", Statistics.Hits, Statistics.Misses, Statistics.Rejected);
+		}
+		bEnabled = false;
+	}
+
+	uint64_t CShaderCache::GetKey(const FShaderProgramSource& Source)
+	{
+		/* The separator keeps moving a line between the stages from producing the same key. */
+		uint64_t Key = Hash::FNV1a(Source.Vertex, DriverHash);
+		Key = Hash::FNV1a(std::string_view("\0", 1), Key);
+		Key = Hash::FNV1a(Source.Fragment, Key);
+		return Key;
+	}
+
+	std::filesystem::path CShaderCache::GetPath(const uint64_t Key)
+	{
+		return Directory / std::format("{:016x}.bin", Key);
+	}
+
+	bool CShaderCache::Load(const uint64_t Key, const LRendererID Program)
+	{
+		if (!bEnabled)
+		{
+			return false;
+		}
+
+		const std::filesystem::path Path = GetPath(Key);
+		std::ifstream File(Path, std::ios::binary);
+		if (!File)
+		{
+			Statistics.Misses++;
+			return false;
+		}
+
+		/* The header is checked before anything is allocated, a corrupt or foreign file must not size the read. */
+		std::error_code Error;
+		const uintmax_t FileSize = std::filesystem::file_size(Path, Error);
+
+		FCacheHeader Header;
+		std::vector<char> Binary;
+		bool bValid = !Error && (FileSize > sizeof(Header))
+			&& File.read(reinterpret_cast<char*>(&Header), sizeof(Header))
+			&& (Header.Magic == CacheMagic) && (Header.Version == CacheVersion) && (Header.Key == Key)
+			&& (Header.BinaryLength > 0) && (Header.BinaryLength == (FileSize - sizeof(Header)));
+		if (bValid)
+		{
+			Binary.resize(Header.BinaryLength);
+			bValid = static_cast<bool>(File.read(Binary.data(), Binary.size()));
+		}
+		File.close();
+
+		GLint LinkStatus = GL_FALSE;
+		if (bValid)
+		{
+			LK_OpenGL_Verify(glProgramBinary(Program, Header.BinaryFormat, Binary.data(), static_cast<GLsizei>(Binary.size())));
+			LK_OpenGL_Verify(glGetProgramiv(Program, GL_LINK_STATUS, &LinkStatus));
+		}
+
+		if (LinkStatus != GL_TRUE)
+		{
+			LK_WARN_TAG("ShaderCache", "Rejected {}, compiling from source", Path.filename());
+			std::filesystem::remove(Path, Error);
+			Statistics.Rejected++;
+			Statistics.Misses++;
+			return false;
+		}
+
+		LK_TRACE_TAG("ShaderCache", "Loaded {} ({} bytes)", Path.filename(), Binary.size());
+		Statistics.Hits++;
+		return true;
+	}
+
+	void CShaderCache::Store(const uint64_t Key, const LRendererID Program)
+	{
+		if (!bEnabled)
+		{
+			return;
+		}
+
+		GLint Length = 0;
+		LK_OpenGL_Verify(glGetProgramiv(Program, GL_PROGRAM_BINARY_LENGTH, &Length));
+		if (Length <= 0)
+		{
+			LK_WARN_TAG("ShaderCache", "Program {} has no binary", Program);
+			return;
+		}
+
+		FCacheHeader Header = { .Key = Key };
+		std::vector<char> Binary(Length);
+		GLsizei Written = 0;
+		GLenum BinaryFormat = 0;
+		LK_OpenGL_Verify(glGetProgramBinary(Program, Length, &Written, &BinaryFormat, Binary.data()));
+		Header.BinaryFormat = BinaryFormat;
+		Header.BinaryLength = static_cast<uint32_t>(Written);
+
+		/* Written to a temporary file first, a partial binary is never picked up by the next launch. */
+		const std::filesystem::path Path = GetPath(Key);
+		std::filesystem::path Temporary = Path;
+		Temporary += ".tmp";
+		{
+			std::ofstream File(Temporary, std::ios::binary | std::ios::trunc);
+			File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+			File.write(Binary.data(), Written);
+			if (!File)
+			{
+				LK_WARN_TAG("ShaderCache", "Failed to write {}", Temporary);
+				return;
+			}
+		}
+
+		std::error_code Error;
+		std::filesystem::rename(Temporary, Path, Error);
+		if (Error)
+		{
+			LK_WARN_TAG("ShaderCache", "Failed to store {}: {}", Path.filename(), Error.message());
+			return;
+		}
+		LK_TRACE_TAG("ShaderCache", "Stored {} ({} bytes)", Path.filename(), Written);
+	}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <filesystem>
+
+#include "core/core.h"
+#include "backendinfo.h"
+
+namespace platformer2d {
+
+	struct FShaderProgramSource;
+
+	struct FShaderCacheStatistics
+	{
+		uint32_t Hits = 0;     /* Programs loaded from a binary. */
+		uint32_t Misses = 0;   /* Programs compiled from source. */
+		uint32_t Rejected = 0; /* Binaries that were found but refused by the driver or truncated. */
+	};
+
+	/**
+	 * @brief On-disk cache of linked program binaries.
+	 *
+	 * A binary is keyed by a hash of the program sources and of the driver that
+	 * produced it, so a changed shader or a driver update never finds a stale entry.
+	 * A rejected binary is deleted and the program is compiled from source instead.
+	 * Disabled until initialized, and if the driver has no program binary formats.
+	 */
+	class CShaderCache
+	{
+	public:
+		static void Initialize(const FBackendInfo& BackendInfo, const std::filesystem::path& InDirectory = SHADER_CACHE_DIR);
+		static void Destroy();
+
+		FORCEINLINE static bool IsEnabled() { return bEnabled; }
+
+		static uint64_t GetKey(const FShaderProgramSource& Source);
+		static std::filesystem::path GetPath(uint64_t Key);
+
+		/**
+		 * @brief Load a cached binary into an empty program.
+		 * @return true if the program was linked from the binary.
+		 */
+		static bool Load(uint64_t Key, LRendererID Program);
+
+		/**
+		 * @brief Store the binary of a linked program.
+		 * The program must have been linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set.
+		 */
+		static void Store(uint64_t Key, LRendererID Program);
+
+		FORCEINLINE static const FShaderCacheStatistics& GetStatistics() { return Statistics; }
+
+	private:
+		static inline bool bEnabled = false;
+		static inline uint64_t DriverHash = 0;
+		static inline std::filesystem::path Directory{};
+		static inline FShaderCacheStatistics Statistics{};
+	};
+
+}
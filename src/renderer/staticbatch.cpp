@@ -0,0 +1,43 @@
+#include "staticbatch.h"
+
+#include "renderer.h"
+
+namespace platformer2d {
+
+	CStaticBatch::~CStaticBatch()
+	{
+		if (Buffers)
+		{
+			CRenderer::ReleaseStaticBatchBuffers(Buffers);
+		}
+	}
+
+	void CStaticBatch::Clear()
+	{
+		Quads.clear();
+		BoundsMin = { 0.0f, 0.0f };
+		BoundsMax = { 0.0f, 0.0f };
+		bDirty = true;
+	}
+
+	void CStaticBatch::AddQuad(const FQuadInstance& Quad)
+	{
+		/* The half diagonal encloses the quad at any rotation. */
+		const glm::vec2 Center(Quad.Position);
+		const glm::vec2 HalfExtent(glm::length(glm::abs(Quad.Size) * 0.50f));
+		if (Quads.empty())
+		{
+			BoundsMin = Center - HalfExtent;
+			BoundsMax = Center + HalfExtent;
+		}
+		else
+		{
+			BoundsMin = glm::min(BoundsMin, Center - HalfExtent);
+			BoundsMax = glm::max(BoundsMax, Center + HalfExtent);
+		}
+
+		Quads.push_back(Quad);
+		bDirty = true;
+	}
+
+}
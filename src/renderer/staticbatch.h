@@ -0,0 +1,72 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/core.h"
+#include "opengl.h"
+#include "vertex.h"
+
+namespace platformer2d {
+
+	/**
+	 * @brief GPU buffers of a static batch.
+	 * Created and deleted by the renderer on the thread that owns the GL context.
+	 */
+	struct FStaticBatchBuffers
+	{
+		GLuint VAO = 0;
+		GLuint VBO = 0;
+	};
+
+	/**
+	 * @brief Retained quads for geometry that rarely changes.
+	 *
+	 * The quads are uploaded to a static buffer the first time the batch is drawn
+	 * after a change and redrawn from that buffer every frame until the batch is
+	 * rebuilt. Static batches are drawn as soon as they are submitted, so they are
+	 * meant for opaque geometry that does not depend on draw order.
+	 */
+	class CStaticBatch
+	{
+	public:
+		CStaticBatch() = default;
+		~CStaticBatch();
+		CStaticBatch(const CStaticBatch&) = delete;
+		CStaticBatch(CStaticBatch&&) = delete;
+
+		/**
+		 * @brief Remove every quad, the GPU buffer is kept and reused on the next upload.
+		 */
+		void Clear();
+		void AddQuad(const FQuadInstance& Quad);
+
+		FORCEINLINE bool IsEmpty() const { return Quads.empty(); }
+		FORCEINLINE bool IsDirty() const { return bDirty; }
+		FORCEINLINE std::size_t GetQuadCount() const { return Quads.size(); }
+		FORCEINLINE std::span<const FQuadInstance> GetQuads() const { return Quads; }
+
+		/**
+		 * @brief World-space bounds enclosing every quad of the batch.
+		 */
+		FORCEINLINE const glm::vec2& GetBoundsMin() const { return BoundsMin; }
+		FORCEINLINE const glm::vec2& GetBoundsMax() const { return BoundsMax; }
+
+		CStaticBatch& operator=(const CStaticBatch&) = delete;
+		CStaticBatch& operator=(CStaticBatch&&) = delete;
+
+	private:
+		std::vector<FQuadInstance> Quads;
+		glm::vec2 BoundsMin = { 0.0f, 0.0f };
+		glm::vec2 BoundsMax = { 0.0f, 0.0f };
+		bool bDirty = true;
+
+		/* Managed by the renderer, outlives the batch until the render thread is done with it. */
+		FStaticBatchBuffers* Buffers = nullptr;
+
+		friend class CRenderer;
+	};
+
+}
@@ -0,0 +1,138 @@
+#include "streambuffer.h"
+
+namespace platformer2d {
+
+	namespace
+	{
+		constexpr GLbitfield PersistentMapFlags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		constexpr GLuint64 FenceTimeout = 1'000'000; /* 1 ms */
+	}
+
+	CStreamBuffer::CStreamBuffer(const std::size_t InRegionSize, const EVertexUploadMode InMode, const uint8_t InRegionCount)
+		: Mode(InMode)
+		, RegionSize(InRegionSize)
+		, RegionCount((InMode == EVertexUploadMode::PersistentMapped) ? InRegionCount : 1)
+	{
+		LK_ASSERT((RegionSize > 0) && (RegionCount > 0));
+		LK_OpenGL_Verify(glCreateBuffers(1, &ID));
+
+		if (Mode == EVertexUploadMode::PersistentMapped)
+		{
+			const std::size_t BufferSize = RegionSize * RegionCount;
+			LK_OpenGL_Verify(glNamedBufferStorage(ID, BufferSize, nullptr, PersistentMapFlags));
+			LK_OpenGL_Verify(Memory = static_cast<uint8_t*>(glMapNamedBufferRange(ID, 0, BufferSize, PersistentMapFlags)));
+			LK_VERIFY(Memory, "Failed to map stream buffer {}", ID);
+			Fences.resize(RegionCount, nullptr);
+		}
+		else
+		{
+			LK_OpenGL_Verify(glNamedBufferData(ID, RegionSize, nullptr, GL_DYNAMIC_DRAW));
+			Memory = new uint8_t[RegionSize];
+		}
+
+		BatchBase = Memory;
+		RegionEnd = Memory + RegionSize;
+		LK_TRACE_TAG("StreamBuffer", "ID={} RegionSize={} Regions={}", ID, RegionSize, RegionCount);
+	}
+
+	CStreamBuffer::~CStreamBuffer()
+	{
+		if (Mode == EVertexUploadMode::PersistentMapped)
+		{
+			for (GLsync& Fence : Fences)
+			{
+				if (Fence)
+				{
+					LK_OpenGL_Verify(glDeleteSync(Fence));
+					Fence = nullptr;
+				}
+			}
+
+			LK_OpenGL_Verify(glUnmapNamedBuffer(ID));
+		}
+		else
+		{
+			delete[] Memory;
+		}
+
+		OpenGL::State::ForgetBuffer(ID);
+		LK_OpenGL_Verify(glDeleteBuffers(1, &ID));
+	}
+
+	std::size_t CStreamBuffer::Submit(const std::size_t Size)
+	{
+		LK_ASSERT(Size <= GetBatchCapacity(), "Batch overflow ({} > {})", Size, GetBatchCapacity());
+		if (Mode == EVertexUploadMode::BufferSubData)
+		{
+			LK_OpenGL_Verify(glNamedBufferSubData(ID, 0, Size, Memory));
+			return 0;
+		}
+
+		/* The mapping is coherent, the data is already visible to the GPU. */
+		const std::size_t Offset = static_cast<std::size_t>(BatchBase - Memory);
+		BatchBase += Size;
+		if (BatchBase >= RegionEnd)
+		{
+			NextRegion();
+		}
+
+		return Offset;
+	}
+
+	void CStreamBuffer::Reserve(const std::size_t Size)
+	{
+		LK_ASSERT(Size <= RegionSize, "Reserve exceeds region size ({} > {})", Size, RegionSize);
+		if ((Mode == EVertexUploadMode::PersistentMapped) && (GetBatchCapacity() < Size))
+		{
+			NextRegion();
+		}
+	}
+
+	void CStreamBuffer::EndFrame()
+	{
+		if (Mode == EVertexUploadMode::BufferSubData)
+		{
+			return;
+		}
+
+		/* Nothing to fence if the region was left untouched. */
+		if (BatchBase != (RegionEnd - RegionSize))
+		{
+			NextRegion();
+		}
+	}
+
+	uint32_t CStreamBuffer::ConsumeFenceWaits()
+	{
+		const uint32_t Waits = FenceWaits;
+		FenceWaits = 0;
+		return Waits;
+	}
+
+	void CStreamBuffer::NextRegion()
+	{
+		LK_OpenGL_Verify(Fences[RegionIndex] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+		RegionIndex = (RegionIndex + 1) % RegionCount;
+
+		if (GLsync& Fence = Fences[RegionIndex]; Fence != nullptr)
+		{
+			GLenum Result = glClientWaitSync(Fence, 0, 0);
+			if (Result == GL_TIMEOUT_EXPIRED)
+			{
+				FenceWaits++;
+				do
+				{
+					Result = glClientWaitSync(Fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceTimeout);
+				} while (Result == GL_TIMEOUT_EXPIRED);
+			}
+			LK_ASSERT(Result != GL_WAIT_FAILED, "Fence wait failed");
+
+			LK_OpenGL_Verify(glDeleteSync(Fence));
+			Fence = nullptr;
+		}
+
+		BatchBase = Memory + (RegionIndex * RegionSize);
+		RegionEnd = BatchBase + RegionSize;
+	}
+
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <vector>
+
+#include "core/core.h"
+#include "opengl.h"
+
+namespace platformer2d {
+
+	enum class EVertexUploadMode
+	{
+		BufferSubData,    /* Written to CPU staging memory, copied with glBufferSubData on flush. */
+		PersistentMapped, /* Written directly to persistently mapped GPU memory. */
+	};
+
+	/**
+	 * @brief Vertex buffer for geometry that is rewritten every frame.
+	 *
+	 * When persistently mapped, the buffer is split into one region per frame in flight.
+	 * Every region is guarded by a fence and is not written to again until the GPU
+	 * has consumed it.
+	 */
+	class CStreamBuffer
+	{
+	public:
+		CStreamBuffer(std::size_t InRegionSize, EVertexUploadMode InMode, uint8_t InRegionCount = 3);
+		CStreamBuffer() = delete;
+		~CStreamBuffer();
+
+		/**
+		 * @brief Start of the current batch.
+		 */
+		FORCEINLINE uint8_t* GetBatchBase() const { return BatchBase; }
+
+		/**
+		 * @brief Bytes available to the current batch.
+		 */
+		FORCEINLINE std::size_t GetBatchCapacity() const { return static_cast<std::size_t>(RegionEnd - BatchBase); }
+
+		/**
+		 * @brief Move on to the next region if the batch has less than Size bytes left.
+		 */
+		void Reserve(std::size_t Size);
+
+		/**
+		 * @brief Submit the bytes written at the batch base.
+		 * @return Byte offset in the buffer to source the batch from.
+		 */
+		std::size_t Submit(std::size_t Size);
+
+		/**
+		 * @brief Fence the region used by the frame and move on to the next one.
+		 */
+		void EndFrame();
+
+		/**
+		 * @brief Number of times the CPU had to wait on the GPU since the last call.
+		 */
+		uint32_t ConsumeFenceWaits();
+
+		FORCEINLINE LRendererID GetID() const { return ID; }
+		FORCEINLINE EVertexUploadMode GetMode() const { return Mode; }
+
+	private:
+		void NextRegion();
+
+		CStreamBuffer(const CStreamBuffer&) = delete;
+		CStreamBuffer& operator=(const CStreamBuffer&) = delete;
+
+	private:
+		LRendererID ID = 0;
+		EVertexUploadMode Mode;
+
+		std::size_t RegionSize = 0;
+		uint8_t RegionCount = 1;
+		uint8_t RegionIndex = 0;
+
+		/* Mapped GPU memory or CPU staging memory. */
+		uint8_t* Memory = nullptr;
+		uint8_t* BatchBase = nullptr;
+		uint8_t* RegionEnd = nullptr;
+
+		std::vector<GLsync> Fences;
+		uint32_t FenceWaits = 0;
+	};
+
+}
@@ -1,8 +1,11 @@
 #include "texture.h"
 
+#include <algorithm>
+
 #include <stb/stb_image.h>
 
 #include "core/log.h"
+#include "cookedtexture.h"
 #include "texturearray.h"
 
 namespace platformer2d {
@@ -10,15 +13,37 @@ namespace platformer2d {
 	namespace
 	{
 		std::size_t CreatedTextures = 0;
+
+		GLenum GetCookedInternalFormat(const ECookedTextureFormat Format)
+		{
+			switch (Format)
+			{
+				case ECookedTextureFormat::RGBA8: return GL_RGBA8;
+				case ECookedTextureFormat::BC1:   return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+				case ECookedTextureFormat::BC3:   return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+			}
+
+			LK_VERIFY(false, "Invalid cooked texture format: {}", static_cast<int>(Format));
+			return GL_NONE;
+		}
 	}
 
 	CTexture::CTexture(const FTextureSpecification& Specification)
-		: Path(Specification.Path)
+		: bArrayBacked(Specification.bArrayBacked)
+		, Path(Specification.Path)
 		, DebugName(Specification.DebugName)
 	{
 		LK_ASSERT((Specification.Width > 0) && (Specification.Height > 0) && !Specification.Path.empty());
-		LK_OpenGL_Verify(glCreateTextures(GL_TEXTURE_2D, 1, &ID));
-		LK_OpenGL_Verify(glBindTexture(GL_TEXTURE_2D, ID));
+		if (Specification.Path.ends_with(CookedTexture::EXTENSION))
+		{
+			CreateCooked(Specification);
+			return;
+		}
+		if (Specification.bAsync)
+		{
+			CreatePending(Specification);
+			return;
+		}
 
 		Format = OpenGL::GetImageFormat(Specification.Format);
 		InternalFormat = OpenGL::GetImageInternalFormat(Specification.Format);
@@ -30,7 +55,8 @@ namespace platformer2d {
 		int ReadWidth, ReadHeight, ReadChannels;
 
 		void* Data = nullptr;
-		if (stbi_is_hdr(Specification.Path.c_str()))
+		const bool bHDR = stbi_is_hdr(Specification.Path.c_str());
+		if (bHDR)
 		{
 			LK_TRACE_TAG("Texture", "[{}] HDR texture", Path.filename());
 			Data = stbi_loadf(Specification.Path.c_str(), &ReadWidth, &ReadHeight, &ReadChannels, 4);
@@ -55,6 +81,38 @@ namespace platformer2d {
 		LK_TRACE_TAG("Texture", "[{}] Image size: {} bytes (Channels: {})", Specification.Path, ImageSize, Channels);
 		ImageBuffer = FBuffer(Data, ImageSize);
 
+		/* Needed by the renderer to sort the texture as translucent. */
+		if (Data && !bHDR && (ReadChannels == 4))
+		{
+			const uint8_t* Pixels = static_cast<const uint8_t*>(Data);
+			const std::size_t PixelCount = static_cast<std::size_t>(ReadWidth) * ReadHeight;
+			for (std::size_t Idx = 0; Idx < PixelCount; Idx++)
+			{
+				if (Pixels[Idx * 4 + 3] < 255)
+				{
+					bTranslucent = true;
+					break;
+				}
+			}
+		}
+
+		/* The pixels are uploaded to the array from the image buffer, see CTextureArray::AddTexture. */
+		if (bArrayBacked)
+		{
+			LK_ASSERT(Specification.Format == EImageFormat::RGBA8, "Array backed textures only support RGBA8");
+			stbi_image_free(Data);
+			if (DebugName.empty())
+			{
+				DebugName = std::format("{}", Path.filename());
+			}
+			Slot = CreatedTextures++;
+			LK_TRACE_TAG("Texture", "Index: {} ({}, array backed)", Slot, Path.filename());
+			return;
+		}
+
+		LK_OpenGL_Verify(glCreateTextures(GL_TEXTURE_2D, 1, &ID));
+		OpenGL::State::BindTexture(GL_TEXTURE_2D, ID);
+
 		if (Data)
 		{
 			LK_OpenGL_Verify(glTexImage2D(
@@ -102,7 +160,7 @@ namespace platformer2d {
 	{
 		LK_ASSERT((InWidth > 0) && (InHeight > 0));
 		LK_OpenGL_Verify(glGenTextures(1, &ID));
-		LK_OpenGL_Verify(glBindTexture(GL_TEXTURE_2D, ID));
+		OpenGL::State::BindTexture(GL_TEXTURE_2D, ID);
 
 		/**
 		 * @todo Pass texture wrap/filter args from constructor.
@@ -140,20 +198,153 @@ namespace platformer2d {
 		LK_TRACE_TAG("Texture", "Index: {}", Slot);
 	}
 
+	void CTexture::CreatePending(const FTextureSpecification& Specification)
+	{
+		LK_ASSERT(Specification.Format == EImageFormat::RGBA8, "Asynchronous loading only supports RGBA8");
+		int ReadWidth, ReadHeight, ReadChannels;
+		const bool bValid = stbi_info(Specification.Path.c_str(), &ReadWidth, &ReadHeight, &ReadChannels);
+		LK_VERIFY(bValid, "Failed to read texture header: {}", Specification.Path);
+		LK_VERIFY(!stbi_is_hdr(Specification.Path.c_str()), "Asynchronous loading does not support HDR: {}", Specification.Path);
+
+		Width = ReadWidth;
+		Height = ReadHeight;
+		Channels = ReadChannels;
+		Mips = Specification.Mips;
+		Format = OpenGL::GetImageFormat(Specification.Format);
+		InternalFormat = OpenGL::GetImageInternalFormat(Specification.Format);
+		DataType = OpenGL::GetFormatDataType(Specification.Format);
+
+		/* The region of an array backed texture is cleared by CTextureArray::AddTexture. */
+		if (!bArrayBacked)
+		{
+			LK_OpenGL_Verify(glCreateTextures(GL_TEXTURE_2D, 1, &ID));
+			LK_OpenGL_Verify(glTextureStorage2D(ID, Mips, InternalFormat, Width, Height));
+
+			/* White until the pixels arrive, same as ETexture::White. */
+			static constexpr uint8_t Placeholder[4] = { 255, 255, 255, 255 };
+			LK_OpenGL_Verify(glClearTexImage(ID, 0, GL_RGBA, GL_UNSIGNED_BYTE, Placeholder));
+
+			OpenGL::State::BindTexture(GL_TEXTURE_2D, ID);
+			OpenGL::SetTextureWrap(Specification.SamplerWrap);
+			OpenGL::SetTextureFilter(Specification.SamplerFilter, (Mips > 1));
+		}
+
+		bPending = true;
+		bFlipVertical = Specification.bFlipVertical;
+		if (DebugName.empty())
+		{
+			DebugName = std::format("{}", Path.filename());
+		}
+		Slot = CreatedTextures++;
+		LK_TRACE_TAG("Texture", "Index: {} ({}, pending {}x{})", Slot, Path.filename(), Width, Height);
+	}
+
+	void CTexture::CreateCooked(const FTextureSpecification& Specification)
+	{
+		Cooked = std::make_unique<CCookedTexture>();
+		LK_VERIFY(Cooked->Open(Specification.Path), "Failed to open cooked texture: {}", Specification.Path);
+		const FCookedTextureHeader& Header = Cooked->GetHeader();
+		if (Cooked->HasFlag(CookedTexture_FlipVertical) != Specification.bFlipVertical)
+		{
+			LK_WARN_TAG("Texture", "[{}] Cooked with a different vertical flip than specified", Path.filename());
+		}
+
+		Width = Header.Width;
+		Height = Header.Height;
+		Channels = 4;
+		Mips = static_cast<uint8_t>(std::clamp<uint32_t>(Specification.Mips, 1, Header.MipCount));
+		Format = GL_RGBA;
+		InternalFormat = GetCookedInternalFormat(Header.Format);
+		DataType = GL_UNSIGNED_BYTE;
+		bTranslucent = Cooked->HasFlag(CookedTexture_Translucent);
+
+		/* Only mip 0 is used, it is uploaded from the mapping by CTextureArray::AddTexture. */
+		if (bArrayBacked)
+		{
+			LK_VERIFY(Header.Format == ECookedTextureFormat::RGBA8, "Array backed textures only support RGBA8, {} is {}",
+					  Path.filename(), Enum::ToString(Header.Format));
+			Mips = 1;
+			if (DebugName.empty())
+			{
+				DebugName = std::format("{}", Path.filename());
+			}
+			Slot = CreatedTextures++;
+			LK_TRACE_TAG("Texture", "Index: {} ({}, cooked {}x{}, array backed)", Slot, Path.filename(), Width, Height);
+			return;
+		}
+
+		LK_OpenGL_Verify(glCreateTextures(GL_TEXTURE_2D, 1, &ID));
+		LK_OpenGL_Verify(glTextureStorage2D(ID, Mips, InternalFormat, Width, Height));
+
+		/* The mip chain is precomputed, every level is sourced directly from the mapped file. */
+		for (uint32_t Level = 0; Level < Mips; Level++)
+		{
+			const FCookedTextureMip& Mip = Cooked->GetMips()[Level];
+			const std::span<const std::byte> MipData = Cooked->GetMipData(Level);
+			if (Header.Format == ECookedTextureFormat::RGBA8)
+			{
+				LK_OpenGL_Verify(glTextureSubImage2D(ID, Level, 0, 0, Mip.Width, Mip.Height,
+													 GL_RGBA, GL_UNSIGNED_BYTE, MipData.data()));
+			}
+			else
+			{
+				LK_OpenGL_Verify(glCompressedTextureSubImage2D(ID, Level, 0, 0, Mip.Width, Mip.Height, InternalFormat,
+															   static_cast<GLsizei>(MipData.size()), MipData.data()));
+			}
+		}
+
+		OpenGL::State::BindTexture(GL_TEXTURE_2D, ID);
+		OpenGL::SetTextureWrap(Specification.SamplerWrap);
+		OpenGL::SetTextureFilter(Specification.SamplerFilter, (Mips > 1));
+		Cooked.reset();
+
+		if (DebugName.empty())
+		{
+			DebugName = std::format("{}", Path.filename());
+		}
+		Slot = CreatedTextures++;
+		LK_TRACE_TAG("Texture", "Index: {} ({}, cooked {} {}x{}, {} mips)", Slot, Path.filename(),
+					 Enum::ToString(Header.Format), Width, Height, Mips);
+	}
+
+	void CTexture::OnLoaded(const bool bInTranslucent)
+	{
+		LK_ASSERT(bPending);
+		if (ID && (Mips > 1))
+		{
+			LK_OpenGL_Verify(glGenerateTextureMipmap(ID));
+		}
+
+		/* Published last, a texture that is no longer pending has its final translucency. */
+		bTranslucent.store(bInTranslucent, std::memory_order_relaxed);
+		bPending.store(false, std::memory_order_release);
+	}
+
+	CTexture::~CTexture() = default;
+
+	void CTexture::ReleasePixels()
+	{
+		ImageBuffer.Release();
+		Cooked.reset();
+	}
+
 	void CTexture::Bind(const uint32_t Slot) const
 	{
-		LK_OpenGL_Verify(glBindTextureUnit(Slot, ID));
+		LK_ASSERT(!bArrayBacked, "{} is array backed", Path.filename());
+		OpenGL::State::BindTextureUnit(Slot, GL_TEXTURE_2D, ID);
 	}
 
 	void CTexture::Unbind(const uint32_t Slot) const
 	{
-		LK_OpenGL_Verify(glBindTextureUnit(Slot, 0));
+		OpenGL::State::BindTextureUnit(Slot, GL_TEXTURE_2D, 0);
 	}
 
 	void CTexture::Invalidate()
 	{
+		LK_ASSERT(!bArrayBacked, "{} is array backed", Path.filename());
 		if (ID)
 		{
+			OpenGL::State::ForgetTexture(ID);
 			LK_OpenGL_Verify(glDeleteTextures(1, &ID));
 			ID = 0;
 		}
@@ -187,6 +378,7 @@ namespace platformer2d {
 	void CTexture::SetWrap(const ETextureWrap InWrap) const
 	{
 		LK_DEBUG_TAG("Texture", "Set wrap: {} ({}) (Index {})", Enum::ToString(InWrap), Path.filename(), Slot);
+		LK_ASSERT(!bArrayBacked, "{} is array backed, it uses the sampler of the array", Path.filename());
 		Bind(Slot);
 		OpenGL::SetTextureWrap(ID, InWrap);
 		Unbind(Slot);
@@ -195,6 +387,7 @@ namespace platformer2d {
 	void CTexture::SetFilter(const ETextureFilter InFilter) const
 	{
 		LK_DEBUG_TAG("Texture", "Set filter: {} ({}) (Index {})", Enum::ToString(InFilter), Path.filename(), Slot);
+		LK_ASSERT(!bArrayBacked, "{} is array backed, it uses the sampler of the array", Path.filename());
 		Bind(Slot);
 		OpenGL::SetTextureFilter(ID, InFilter, (Mips > 1));
 		Unbind(Slot);
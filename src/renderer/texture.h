@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <filesystem>
+#include <memory>
 
 #include "core/core.h"
 #include "core/assert.h"
@@ -22,14 +24,17 @@ namespace platformer2d {
 		Cloud,
 	};
 
+	class CCookedTexture;
+
 	class CTexture
 	{
 	public:
 		CTexture(const FTextureSpecification& Specification);
 		CTexture(uint32_t InWidth, uint32_t InHeight, void* InData = nullptr);
 		CTexture() = delete;
-		~CTexture() = default;
+		~CTexture();
 
+		/* Not for array backed textures, they have no GL texture of their own. */
 		void Bind(uint32_t Slot = 0) const;
 		void Unbind(uint32_t Slot = 0) const;
 
@@ -40,8 +45,25 @@ namespace platformer2d {
 		uint32_t GetHeight() const { return Height; }
 		uint8_t GetChannels() const { return Channels; }
 		uint8_t GetMips() const { return Mips; }
+		bool IsTranslucent() const { return bTranslucent.load(std::memory_order_acquire); }
+
+		/**
+		 * @brief Whether the pixels are still being loaded.
+		 * A pending texture has its final size but is white until the upload completes.
+		 */
+		bool IsPending() const { return bPending.load(std::memory_order_acquire); }
+
+		/**
+		 * @brief Whether the pixels live in a region of a CTextureArray, see FTextureSpecification::bArrayBacked.
+		 * The ID of an array backed texture is 0.
+		 */
+		bool IsArrayBacked() const { return bArrayBacked; }
 		const std::filesystem::path& GetFilePath() const { return Path; }
 
+		/**
+		 * @brief Sampler state of the texture.
+		 * Array backed textures share the sampler of the array, see CRenderer::SetTextureFilter.
+		 */
 		void SetWrap(ETextureWrap InWrap) const;
 		void SetFilter(ETextureFilter InFilter) const;
 
@@ -51,15 +73,27 @@ namespace platformer2d {
 		[[nodiscard]] const FBuffer& GetImageBuffer() const { return ImageBuffer; }
 		[[nodiscard]] const std::string& GetDebugName() const { return DebugName; }
 
+	private:
+		void CreatePending(const FTextureSpecification& Specification);
+		void CreateCooked(const FTextureSpecification& Specification);
+		void OnLoaded(bool bInTranslucent);
+		void ReleasePixels();
+
 	private:
 		LRendererID ID{};
 		FBuffer ImageBuffer;
+		std::unique_ptr<CCookedTexture> Cooked{}; /* Mapping of an array backed cooked texture, until uploaded. */
 		std::size_t Slot;
 
 		uint32_t Width = 1;
 		uint32_t Height = 1;
 		uint8_t Channels = 0;
 		uint8_t Mips = 1;
+		/* Written by the thread that uploads the pixels, read while recording draws. */
+		std::atomic<bool> bTranslucent = false; /* Any texel with alpha below 1. */
+		std::atomic<bool> bPending = false;
+		bool bFlipVertical = true; /* Kept for the loader while pending. */
+		bool bArrayBacked = false;
 		std::filesystem::path Path{};
 		std::string DebugName{};
 
@@ -68,6 +102,9 @@ namespace platformer2d {
 		GLenum DataType{};
 
 		static_assert(std::is_same_v<LRendererID, GLuint>, "LRendererID type mismatch");
+
+		friend class CTextureLoader;
+		friend class CTextureArray;
 	};
 
 	namespace Enum
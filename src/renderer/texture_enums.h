@@ -72,7 +72,7 @@ namespace platformer2d {
 
 	struct FTextureSpecification
 	{
-		std::string Path{};
+		std::string Path{}; /* A cooked texture (.lktex) is memory mapped instead of decoded. */
 		std::string Name{};
 		uint32_t Width = 1;
 		uint32_t Height = 1;
@@ -88,6 +88,12 @@ namespace platformer2d {
 		bool bStorage = false;
 		bool bStoreLocally = false;
 
+		/* Only the header is read, the pixels are decoded and uploaded later by CTextureLoader. RGBA8 only. */
+		bool bAsync = false;
+
+		/* No GL texture is created, the pixels are kept until added to a CTextureArray. RGBA8 only. */
+		bool bArrayBacked = false;
+
 		std::string DebugName{};
 	};
 
@@ -1,94 +1,170 @@
 #include "texturearray.h"
 
-#include <stb/stb_image.h>
+#include <algorithm>
+#include <numeric>
 
+#include "cookedtexture.h"
 #include "texture.h"
 
 namespace platformer2d {
 
+	namespace
+	{
+		struct FShelf
+		{
+			uint32_t Layer = 0;
+			uint32_t Y = 0;
+			uint32_t Height = 0;
+			uint32_t UsedWidth = 0;
+		};
+	}
+
 	CTextureArray::CTextureArray(const FTextureArraySpecification& Specification)
 		: Width(Specification.Width)
 		, Height(Specification.Height)
 		, Layers(Specification.Layers)
+		, DebugName(Specification.DebugName)
 	{
-		LK_ASSERT((Specification.Width > 0) && (Specification.Height > 0));
+		LK_ASSERT((Specification.Width > 0) && (Specification.Height > 0) && (Specification.Layers > 0));
+		InternalFormat = OpenGL::GetImageInternalFormat(Specification.ImageFormat);
 		LK_OpenGL_Verify(glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &RendererID));
-		const GLuint InternalFormatGL = OpenGL::GetImageInternalFormat(Specification.ImageFormat);
-		LK_OpenGL_Verify(glTextureStorage3D(RendererID, 1, InternalFormatGL, Width, Height, Layers));
+		LK_OpenGL_Verify(glTextureStorage3D(RendererID, 1, InternalFormat, Width, Height, Layers));
 
-		if (Specification.Mips > 1)
-		{
-			LK_OpenGL_Verify(glGenerateTextureMipmap(RendererID));
-			LK_OpenGL_Verify(glTextureParameteri(RendererID, GL_TEXTURE_MAX_LEVEL, 10));
-		}
+		/* The unused part of a layer is never sampled but is cleared to keep it deterministic. */
+		LK_OpenGL_Verify(glClearTexImage(RendererID, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
 
 		LK_OpenGL_Verify(glTextureParameteri(RendererID, GL_TEXTURE_MIN_FILTER, GL_NEAREST)); 
 		LK_OpenGL_Verify(glTextureParameteri(RendererID, GL_TEXTURE_MAG_FILTER, GL_NEAREST));
-		LK_OpenGL_Verify(glTextureParameteri(RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT));
-		LK_OpenGL_Verify(glTextureParameteri(RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT));
+		LK_OpenGL_Verify(glTextureParameteri(RendererID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
+		LK_OpenGL_Verify(glTextureParameteri(RendererID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE));
+
+		/* Views need names that were never bound, hence glGenTextures. */
+		LayerViews.resize(Layers);
+		LK_OpenGL_Verify(glGenTextures(static_cast<GLsizei>(Layers), LayerViews.data()));
+		for (uint32_t Layer = 0; Layer < Layers; Layer++)
+		{
+			LK_OpenGL_Verify(glTextureView(LayerViews[Layer], GL_TEXTURE_2D, RendererID, InternalFormat, 0, 1, Layer, 1));
+			LK_OpenGL_Verify(glTextureParameteri(LayerViews[Layer], GL_TEXTURE_MIN_FILTER, GL_NEAREST));
+			LK_OpenGL_Verify(glTextureParameteri(LayerViews[Layer], GL_TEXTURE_MAG_FILTER, GL_NEAREST));
+		}
 	}
 
 	CTextureArray::~CTextureArray()
 	{
+		for (const LRendererID View : LayerViews)
+		{
+			OpenGL::State::ForgetTexture(View);
+		}
+		if (!LayerViews.empty())
+		{
+			LK_OpenGL_Verify(glDeleteTextures(static_cast<GLsizei>(LayerViews.size()), LayerViews.data()));
+		}
+
 		if (RendererID)
 		{
 			LK_TRACE_TAG("TextureArray", "Releasing resources (ID {})", RendererID);
+			OpenGL::State::ForgetTexture(RendererID);
 			LK_OpenGL_Verify(glDeleteTextures(1, &RendererID));
 		}
 	}
 
 	void CTextureArray::Bind(const uint32_t Slot) const
 	{
-		LK_OpenGL_Verify(glBindTextureUnit(Slot, RendererID));
+		OpenGL::State::BindTextureUnit(Slot, GL_TEXTURE_2D_ARRAY, RendererID);
 	}
 
 	void CTextureArray::Unbind(const uint32_t Slot) const
 	{
-		LK_OpenGL_Verify(glBindTextureUnit(Slot, 0));
+		OpenGL::State::BindTextureUnit(Slot, GL_TEXTURE_2D_ARRAY, 0);
 	}
 
-	bool CTextureArray::AddTexture(const std::shared_ptr<CTexture> Texture)
+	std::vector<FTextureRegion> CTextureArray::Pack(const std::span<const glm::uvec2> Sizes, const glm::uvec2& LayerSize)
+	{
+		std::vector<std::size_t> Order(Sizes.size());
+		std::iota(Order.begin(), Order.end(), 0);
+		std::ranges::stable_sort(Order, [&Sizes](const std::size_t Lhs, const std::size_t Rhs)
+		{
+			return Sizes[Lhs].y > Sizes[Rhs].y;
+		});
+
+		std::vector<FTextureRegion> Regions(Sizes.size());
+		std::vector<FShelf> Shelves;
+		std::vector<uint32_t> LayerHeights; /* Height taken by the shelves of each layer. */
+		for (const std::size_t Idx : Order)
+		{
+			const glm::uvec2& Size = Sizes[Idx];
+			LK_VERIFY((Size.x <= LayerSize.x) && (Size.y <= LayerSize.y), "A {}x{} texture does not fit the {}x{} layers",
+					  Size.x, Size.y, LayerSize.x, LayerSize.y);
+
+			auto Shelf = std::ranges::find_if(Shelves, [&](const FShelf& Candidate)
+			{
+				return (Candidate.Height >= Size.y) && ((Candidate.UsedWidth + Size.x) <= LayerSize.x);
+			});
+			if (Shelf == Shelves.end())
+			{
+				auto Layer = std::ranges::find_if(LayerHeights, [&](const uint32_t Used) { return (Used + Size.y) <= LayerSize.y; });
+				if (Layer == LayerHeights.end())
+				{
+					Layer = LayerHeights.insert(LayerHeights.end(), 0);
+				}
+
+				Shelves.push_back({ .Layer = static_cast<uint32_t>(Layer - LayerHeights.begin()), .Y = *Layer, .Height = Size.y });
+				*Layer += Size.y;
+				Shelf = Shelves.end() - 1;
+			}
+
+			Regions[Idx] = { .Layer = Shelf->Layer, .Offset = { Shelf->UsedWidth, Shelf->Y }, .Size = Size };
+			Shelf->UsedWidth += Size.x;
+		}
+
+		return Regions;
+	}
+
+	int CTextureArray::AddTexture(const std::shared_ptr<CTexture> Texture, const FTextureRegion& Region)
 	{
 		LK_ASSERT(Texture);
 		if (!Texture)
 		{
-			return false;
+			return -1;
 		}
-		if (Textures.size() >= MAX_TEXTURES)
+		LK_ASSERT(Texture->IsArrayBacked(), "{} has a texture of its own", Texture->GetFilePath().filename());
+		LK_ASSERT((Region.Size == glm::uvec2(Texture->GetWidth(), Texture->GetHeight())) && (Region.Layer < Layers)
+				  && ((Region.Offset.x + Region.Size.x) <= Width) && ((Region.Offset.y + Region.Size.y) <= Height),
+				  "Invalid region for {}", Texture->GetFilePath().filename());
+
+		const int Index = static_cast<int>(Textures.size());
+		const GLint Layer = static_cast<GLint>(Region.Layer);
+
+		/* The pixels are uploaded to the region by CTextureLoader, until then it is white. */
+		if (Texture->IsPending())
+		{
+			static constexpr uint8_t Placeholder[4] = { 255, 255, 255, 255 };
+			LK_OpenGL_Verify(glClearTexSubImage(RendererID, 0, Region.Offset.x, Region.Offset.y, Layer, Region.Size.x, Region.Size.y, 1,
+												GL_RGBA, GL_UNSIGNED_BYTE, Placeholder));
+			LK_DEBUG_TAG("TextureArray", "Add: {} (index {}, layer {}, pending)", Texture->GetFilePath().filename(), Index, Layer);
+		}
+		else
 		{
-			LK_ERROR_TAG("TextureArray", "Reached max capacity: {}", Textures.size());
-			return false;
+			/* A cooked texture is sourced from its mapping, anything else from the decoded pixels. */
+			const void* Pixels = Texture->Cooked ? static_cast<const void*>(Texture->Cooked->GetMipData(0).data())
+												 : Texture->ImageBuffer.Data;
+			LK_ASSERT(Pixels, "{} has no pixels to upload", Texture->GetFilePath().filename());
+			LK_OpenGL_Verify(glTextureSubImage3D(RendererID, 0, Region.Offset.x, Region.Offset.y, Layer, Region.Size.x, Region.Size.y, 1,
+												 GL_RGBA, GL_UNSIGNED_BYTE, Pixels));
+			Texture->ReleasePixels();
+			LK_DEBUG_TAG("TextureArray", "Add: {} (index {}, layer {})", Texture->GetFilePath().filename(), Index, Layer);
 		}
 
-		/* Assume 2D texture. */
-		FBuffer ImageBuffer = Texture->GetImageBuffer();
-		LK_VERIFY(ImageBuffer.Data, "Missing image data");
-
-		constexpr GLint XOffset = 0;
-		constexpr GLint YOffset = 0;
-		const GLint ZOffset = static_cast<GLint>(Textures.size());
-		constexpr int Depth = 1;
-		constexpr GLenum Format = GL_RGBA;
-		constexpr GLenum DataType = GL_UNSIGNED_BYTE;
-
-		LK_OpenGL_Verify(glTextureSubImage3D(
-			RendererID,
-			0, /* Level */
-			XOffset, /* X Offset */
-			YOffset, /* Y Offset */
-			ZOffset, /* Z Offset */
-			Width,
-			Height,
-			Depth,
-			Format, /* Format */
-			DataType, /* Type */
-			ImageBuffer.Data
-		));
-
-		LK_DEBUG_TAG("TextureArray", "Add: {} (index {})", Texture->GetFilePath().filename(), Textures.size());
 		Textures.push_back(Texture);
+		Regions.push_back(Region);
 
-		return true;
+		return Index;
+	}
+
+	void CTextureArray::SetFilter(const ETextureFilter Filter) const
+	{
+		LK_DEBUG_TAG("TextureArray", "Set filter: {} ({})", Enum::ToString(Filter), DebugName);
+		OpenGL::SetTextureFilter(RendererID, Filter, false);
 	}
 
-}
\ No newline at end of file
+}
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <filesystem>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
 
 #include "core/core.h"
 #include "core/assert.h"
@@ -15,13 +19,32 @@ namespace platformer2d {
 	struct FTextureArraySpecification
 	{
 		EImageFormat ImageFormat = EImageFormat::RGBA;
-		uint8_t Layers = 2;
+		uint16_t Layers = 2;
 		uint32_t Width = 1;
 		uint32_t Height = 1;
-		uint8_t Mips = 4;
 		std::string DebugName{};
 	};
 
+	/**
+	 * @brief Placement of a texture in a texture array, in texels.
+	 */
+	struct FTextureRegion
+	{
+		uint32_t Layer = 0;
+		glm::uvec2 Offset = glm::uvec2(0);
+		glm::uvec2 Size = glm::uvec2(0);
+	};
+
+	/**
+	 * @brief 2D texture array.
+	 *
+	 * Textures are placed in regions of the layers, several small textures share
+	 * a layer, see Pack. The pixels of a texture are uploaded straight into its
+	 * region, array backed textures have no GL texture of their own.
+	 * Every texture is sampled with the wrap and filter of the array, clamped to
+	 * the edge of its region by the quad shaders. There is a single mip level,
+	 * smaller levels of a shared layer would blend neighbouring regions.
+	 */
 	class CTextureArray
 	{
 	public:
@@ -32,22 +55,47 @@ namespace platformer2d {
 		void Bind(uint32_t Slot = 0) const;
 		void Unbind(uint32_t Slot = 0) const;
 
-		bool AddTexture(std::shared_ptr<CTexture> Texture);
+		/**
+		 * @brief Place textures of the given sizes on layers of LayerSize.
+		 * Shelves are filled tallest texture first, a new layer is only started
+		 * when a texture does not fit the free space of the others.
+		 * @return Region of every size, in the same order.
+		 */
+		static std::vector<FTextureRegion> Pack(std::span<const glm::uvec2> Sizes, const glm::uvec2& LayerSize);
+
+		/**
+		 * @brief Upload a texture to its region and release the pixels the texture kept for it.
+		 * A pending texture only reserves the region, see CTextureLoader.
+		 * @return Index of the texture in the array, -1 on failure.
+		 */
+		int AddTexture(std::shared_ptr<CTexture> Texture, const FTextureRegion& Region);
+
+		void SetFilter(ETextureFilter Filter) const;
 
 		LRendererID GetRendererID() const { return RendererID; }
 		uint32_t GetWidth() const { return Width; }
 		uint32_t GetHeight() const { return Height; }
+		uint32_t GetLayers() const { return Layers; }
+		uint32_t GetTextureCount() const { return static_cast<uint32_t>(Textures.size()); }
 		const std::filesystem::path& GetFilePath() const { return Path; }
 
-	public:
-		static constexpr int MAX_TEXTURES = 10;
+		const FTextureRegion& GetRegion(const uint32_t Index) const { return Regions.at(Index); }
+
+		/**
+		 * @brief 2D view of a layer sharing the storage of the array, for ImGui previews.
+		 */
+		LRendererID GetLayerView(const uint32_t Layer) const { return LayerViews.at(Layer); }
+
 	private:
 		LRendererID RendererID;
 		std::vector<std::shared_ptr<CTexture>> Textures{};
+		std::vector<FTextureRegion> Regions{};
+		std::vector<LRendererID> LayerViews{};
 
 		uint32_t Width = 1;
 		uint32_t Height = 1;
 		uint32_t Layers = 0;
+		GLenum InternalFormat{};
 		std::filesystem::path Path{};
 		std::string DebugName{};
 	};
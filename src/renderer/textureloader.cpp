@@ -0,0 +1,260 @@
+#include "textureloader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include <stb/stb_image.h>
+
+#include "core/log.h"
+#include "opengl.h"
+#include "texture.h"
+#include "texturearray.h"
+
+namespace platformer2d {
+
+	namespace
+	{
+		constexpr uint32_t BytesPerPixel = 4; /* RGBA8 */
+
+		struct FImageDeleter
+		{
+			void operator()(uint8_t* Pixels) const { stbi_image_free(Pixels); }
+		};
+	}
+
+	struct CTextureLoader::FJob
+	{
+		std::shared_ptr<CTexture> Texture = nullptr;
+		std::string Path{};
+		bool bFlipVertical = true;
+		LRendererID ArrayID = 0;
+		int Layer = -1;
+		glm::uvec2 Offset = glm::uvec2(0); /* Of the region in the array. */
+
+		/* Set by the worker. */
+		std::unique_ptr<uint8_t, FImageDeleter> Pixels = nullptr;
+		bool bTranslucent = false;
+
+		uint32_t NextRow = 0;
+	};
+
+	CTextureLoader::CTextureLoader(const std::size_t InFrameBudget, const EVertexUploadMode UploadMode,
+								   const uint8_t FramesInFlight, const uint8_t WorkerCount)
+		: FrameBudget(InFrameBudget)
+	{
+		LK_VERIFY((FrameBudget > 0) && (WorkerCount > 0));
+		Staging = std::make_unique<CStreamBuffer>(FrameBudget, UploadMode, FramesInFlight);
+
+		Workers.reserve(WorkerCount);
+		for (uint8_t Idx = 0; Idx < WorkerCount; Idx++)
+		{
+			Workers.emplace_back([this](std::stop_token StopToken) { Decode(StopToken); });
+		}
+		LK_TRACE_TAG("TextureLoader", "Budget={} Workers={}", FrameBudget, WorkerCount);
+	}
+
+	CTextureLoader::~CTextureLoader()
+	{
+		for (std::jthread& Worker : Workers)
+		{
+			Worker.request_stop();
+		}
+		DecodeCondition.notify_all();
+		Workers.clear();
+
+		if (PendingCount > 0)
+		{
+			LK_WARN_TAG("TextureLoader", "Destroyed with {} pending textures", PendingCount.load());
+		}
+	}
+
+	void CTextureLoader::Load(std::shared_ptr<CTexture> Texture, const CTextureArray* Array, const int Index)
+	{
+		LK_ASSERT(Texture && Texture->IsPending(), "Only pending textures can be loaded");
+		LK_ASSERT(!Array || (Index >= 0), "Invalid texture array index: {}", Index);
+		LK_ASSERT(Array || !Texture->IsArrayBacked(), "{} is array backed but has no array", Texture->GetFilePath().filename());
+		LK_ASSERT(static_cast<std::size_t>(Texture->GetWidth()) * BytesPerPixel <= FrameBudget,
+				  "A row of {} does not fit the frame budget", Texture->GetFilePath().filename());
+
+		auto Job = std::make_unique<FJob>();
+		Job->Path = Texture->GetFilePath().string();
+		Job->bFlipVertical = Texture->bFlipVertical;
+		Job->Texture = std::move(Texture);
+		if (Array)
+		{
+			const FTextureRegion& Region = Array->GetRegion(Index);
+			Job->ArrayID = Array->GetRendererID();
+			Job->Layer = static_cast<int>(Region.Layer);
+			Job->Offset = Region.Offset;
+		}
+		PendingCount++;
+
+		{
+			std::scoped_lock Lock(Mutex);
+			DecodeQueue.push_back(std::move(Job));
+		}
+		DecodeCondition.notify_one();
+	}
+
+	uint64_t CTextureLoader::Update()
+	{
+		AcquireDecoded();
+		return Upload(FrameBudget);
+	}
+
+	void CTextureLoader::Flush()
+	{
+		while (PendingCount > 0)
+		{
+			if (Uploads.empty())
+			{
+				std::unique_lock Lock(Mutex);
+				DecodedCondition.wait(Lock, [this]() { return !Decoded.empty(); });
+			}
+
+			AcquireDecoded();
+			Upload(std::numeric_limits<std::size_t>::max());
+		}
+	}
+
+	void CTextureLoader::EndFrame()
+	{
+		Staging->EndFrame();
+	}
+
+	uint32_t CTextureLoader::ConsumeFenceWaits()
+	{
+		return Staging->ConsumeFenceWaits();
+	}
+
+	void CTextureLoader::Decode(std::stop_token StopToken)
+	{
+		while (!StopToken.stop_requested())
+		{
+			std::unique_ptr<FJob> Job;
+			{
+				std::unique_lock Lock(Mutex);
+				if (!DecodeCondition.wait(Lock, StopToken, [this]() { return !DecodeQueue.empty(); }))
+				{
+					return;
+				}
+
+				Job = std::move(DecodeQueue.front());
+				DecodeQueue.pop_front();
+			}
+
+			/* The flip flag of stb_image is global unless set per thread. */
+			stbi_set_flip_vertically_on_load_thread(Job->bFlipVertical);
+			int ReadWidth, ReadHeight, ReadChannels;
+			Job->Pixels.reset(stbi_load(Job->Path.c_str(), &ReadWidth, &ReadHeight, &ReadChannels, BytesPerPixel));
+			if (!Job->Pixels)
+			{
+				LK_ERROR_TAG("TextureLoader", "Failed to decode {}: {}", Job->Path, stbi_failure_reason());
+			}
+			else if ((static_cast<uint32_t>(ReadWidth) != Job->Texture->GetWidth())
+					 || (static_cast<uint32_t>(ReadHeight) != Job->Texture->GetHeight()))
+			{
+				LK_ERROR_TAG("TextureLoader", "{} changed size since it was created", Job->Path);
+				Job->Pixels.reset();
+			}
+			else if (ReadChannels == 4)
+			{
+				const uint8_t* Pixels = Job->Pixels.get();
+				const std::size_t PixelCount = static_cast<std::size_t>(ReadWidth) * ReadHeight;
+				for (std::size_t Idx = 0; Idx < PixelCount; Idx++)
+				{
+					if (Pixels[Idx * BytesPerPixel + 3] < 255)
+					{
+						Job->bTranslucent = true;
+						break;
+					}
+				}
+			}
+
+			{
+				std::scoped_lock Lock(Mutex);
+				Decoded.push_back(std::move(Job));
+			}
+			DecodedCondition.notify_all();
+		}
+	}
+
+	void CTextureLoader::AcquireDecoded()
+	{
+		std::scoped_lock Lock(Mutex);
+		for (std::unique_ptr<FJob>& Job : Decoded)
+		{
+			Uploads.push_back(std::move(Job));
+		}
+		Decoded.clear();
+	}
+
+	uint64_t CTextureLoader::Upload(const std::size_t Budget)
+	{
+		if (Uploads.empty())
+		{
+			return 0;
+		}
+
+		uint64_t Uploaded = 0;
+		OpenGL::State::BindBuffer(GL_PIXEL_UNPACK_BUFFER, Staging->GetID());
+		while (!Uploads.empty())
+		{
+			FJob& Job = *Uploads.front();
+			CTexture& Texture = *Job.Texture;
+			const uint32_t Width = Texture.GetWidth();
+			const uint32_t Height = Texture.GetHeight();
+			const std::size_t RowSize = static_cast<std::size_t>(Width) * BytesPerPixel;
+
+			/* A failed decode leaves the placeholder in place. */
+			while (Job.Pixels && (Job.NextRow < Height))
+			{
+				const std::size_t Remaining = (Budget > Uploaded) ? (Budget - Uploaded) : 0;
+				uint32_t Rows = static_cast<uint32_t>(std::min<std::size_t>(Remaining, FrameBudget) / RowSize);
+				if ((Rows == 0) && (Uploaded == 0))
+				{
+					Rows = 1;
+				}
+				if (Rows == 0)
+				{
+					break;
+				}
+				Rows = std::min(Rows, Height - Job.NextRow);
+
+				const std::size_t Size = Rows * RowSize;
+				Staging->Reserve(Size);
+				std::memcpy(Staging->GetBatchBase(), Job.Pixels.get() + (Job.NextRow * RowSize), Size);
+				const void* Offset = reinterpret_cast<const void*>(Staging->Submit(Size));
+
+				if (!Texture.IsArrayBacked())
+				{
+					LK_OpenGL_Verify(glTextureSubImage2D(Texture.GetID(), 0, 0, Job.NextRow, Width, Rows,
+														 GL_RGBA, GL_UNSIGNED_BYTE, Offset));
+				}
+				if (Job.ArrayID != 0)
+				{
+					LK_OpenGL_Verify(glTextureSubImage3D(Job.ArrayID, 0, Job.Offset.x, Job.Offset.y + Job.NextRow, Job.Layer,
+														 Width, Rows, 1, GL_RGBA, GL_UNSIGNED_BYTE, Offset));
+				}
+
+				Job.NextRow += Rows;
+				Uploaded += Size;
+			}
+
+			if (Job.Pixels && (Job.NextRow < Height))
+			{
+				break;
+			}
+
+			Texture.OnLoaded(Job.bTranslucent);
+			LK_DEBUG_TAG("TextureLoader", "Loaded {} ({}x{})", Texture.GetFilePath().filename(), Width, Height);
+			Uploads.pop_front();
+			PendingCount--;
+		}
+		OpenGL::State::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+		return Uploaded;
+	}
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "core/core.h"
+#include "streambuffer.h"
+
+namespace platformer2d {
+
+	class CTexture;
+	class CTextureArray;
+
+	/**
+	 * @brief Decodes pending textures on worker threads and uploads them over several frames.
+	 *
+	 * Decoded rows are copied into a pixel unpack staging buffer and uploaded with
+	 * glTextureSubImage, at most FrameBudget bytes per frame. A texture stays white
+	 * (see CTexture::IsPending) until its last row has been uploaded.
+	 * Everything but the decoding runs on the thread that owns the GL context.
+	 */
+	class CTextureLoader
+	{
+	public:
+		CTextureLoader(std::size_t InFrameBudget, EVertexUploadMode UploadMode, uint8_t FramesInFlight, uint8_t WorkerCount = 2);
+		CTextureLoader() = delete;
+		~CTextureLoader();
+
+		/**
+		 * @brief Queue a pending texture for decoding.
+		 * @param Array Texture array the pixels are uploaded to, required for array backed textures.
+		 * @param Index Index of the texture in the array, see CTextureArray::AddTexture.
+		 */
+		void Load(std::shared_ptr<CTexture> Texture, const CTextureArray* Array = nullptr, int Index = -1);
+
+		/**
+		 * @brief Upload decoded rows within the frame budget.
+		 * At least one row is uploaded if any is ready, so the budget never stalls a texture.
+		 * @return Bytes uploaded.
+		 */
+		uint64_t Update();
+
+		/**
+		 * @brief Wait for every queued texture and upload it, ignoring the budget.
+		 */
+		void Flush();
+
+		/**
+		 * @brief Fence the staging region used by the frame.
+		 */
+		void EndFrame();
+
+		FORCEINLINE uint32_t GetPendingCount() const { return PendingCount; }
+		FORCEINLINE std::size_t GetFrameBudget() const { return FrameBudget; }
+		uint32_t ConsumeFenceWaits();
+
+	private:
+		struct FJob;
+
+		void Decode(std::stop_token StopToken);
+		void AcquireDecoded();
+		uint64_t Upload(std::size_t Budget);
+
+		CTextureLoader(const CTextureLoader&) = delete;
+		CTextureLoader& operator=(const CTextureLoader&) = delete;
+
+	private:
+		std::size_t FrameBudget = 0;
+		std::unique_ptr<CStreamBuffer> Staging = nullptr;
+
+		/* Thread that owns the GL context only. */
+		std::deque<std::unique_ptr<FJob>> Uploads;
+		std::atomic<uint32_t> PendingCount = 0; /* Also read while recording, see CRenderer::BeginLayer. */
+
+		std::mutex Mutex;
+		std::condition_variable_any DecodeCondition;
+		std::condition_variable_any DecodedCondition;
+		std::deque<std::unique_ptr<FJob>> DecodeQueue;
+		std::vector<std::unique_ptr<FJob>> Decoded;
+
+		/* Last member, the workers are joined before anything above is destroyed. */
+		std::vector<std::jthread> Workers;
+	};
+
+}
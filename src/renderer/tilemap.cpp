@@ -0,0 +1,192 @@
+#include "tilemap.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "renderer.h"
+
+namespace platformer2d {
+
+	FSpriteUV FTileAtlas::GetUV(const LTile Tile) const
+	{
+		LK_ASSERT((Tile != CTilemap::EMPTY) && (Tile <= GetTileCount()), "Invalid tile: {}", Tile);
+		const uint32_t Cell = Tile - 1;
+		const glm::vec2 TilePos(Cell % Columns, Cell / Columns);
+		return CSprite::CalculateUV(TilePos, glm::vec2(1.0f), glm::vec2(Columns, Rows));
+	}
+
+	CTilemap::CTilemap(const uint32_t InWidth, const uint32_t InHeight, const FTileAtlas& InAtlas,
+					   const float InTileSize, const glm::vec2& InOrigin)
+		: Width(InWidth)
+		, Height(InHeight)
+		, ChunkCountX((InWidth + CHUNK_SIZE - 1) / CHUNK_SIZE)
+		, ChunkCountY((InHeight + CHUNK_SIZE - 1) / CHUNK_SIZE)
+		, TileSize(InTileSize)
+		, Origin(InOrigin)
+		, Atlas(InAtlas)
+	{
+		LK_VERIFY((Width > 0) && (Height > 0), "Invalid tilemap size: {}x{}", Width, Height);
+		LK_VERIFY(TileSize > 0.0f);
+		LK_VERIFY((Atlas.Columns > 0) && (Atlas.Rows > 0) && (Atlas.GetTileCount() < std::numeric_limits<LTile>::max()),
+				  "Invalid tile atlas: {}x{}", Atlas.Columns, Atlas.Rows);
+
+		Chunks.resize(static_cast<std::size_t>(ChunkCountX) * ChunkCountY);
+		for (std::unique_ptr<FChunk>& Chunk : Chunks)
+		{
+			Chunk = std::make_unique<FChunk>();
+		}
+		LK_DEBUG_TAG("Tilemap", "Created {}x{} tiles in {}x{} chunks", Width, Height, ChunkCountX, ChunkCountY);
+	}
+
+	void CTilemap::SetTile(const uint32_t X, const uint32_t Y, const LTile Tile)
+	{
+		LK_ASSERT(Contains(X, Y), "Tile ({}, {}) outside of the map", X, Y);
+		LK_ASSERT(Tile <= Atlas.GetTileCount(), "Invalid tile: {}", Tile);
+		FChunk& Chunk = GetChunk(X, Y);
+		LTile& Cell = Chunk.Tiles[GetTileIndex(X, Y)];
+		if (Cell == Tile)
+		{
+			return;
+		}
+
+		if (Cell == EMPTY)
+		{
+			Chunk.TileCount++;
+		}
+		else if (Tile == EMPTY)
+		{
+			Chunk.TileCount--;
+		}
+		Cell = Tile;
+		Chunk.bDirty = true;
+	}
+
+	LTile CTilemap::GetTile(const uint32_t X, const uint32_t Y) const
+	{
+		LK_ASSERT(Contains(X, Y), "Tile ({}, {}) outside of the map", X, Y);
+		return GetChunk(X, Y).Tiles[GetTileIndex(X, Y)];
+	}
+
+	void CTilemap::Fill(const uint32_t X, const uint32_t Y, const uint32_t InWidth, const uint32_t InHeight, const LTile Tile)
+	{
+		const uint32_t MaxX = std::min(Width, X + InWidth);
+		const uint32_t MaxY = std::min(Height, Y + InHeight);
+		for (uint32_t TileY = Y; TileY < MaxY; TileY++)
+		{
+			for (uint32_t TileX = X; TileX < MaxX; TileX++)
+			{
+				SetTile(TileX, TileY, Tile);
+			}
+		}
+	}
+
+	void CTilemap::Clear()
+	{
+		for (std::unique_ptr<FChunk>& Chunk : Chunks)
+		{
+			if (Chunk->TileCount > 0)
+			{
+				Chunk->Tiles.fill(EMPTY);
+				Chunk->TileCount = 0;
+				Chunk->bDirty = true;
+			}
+		}
+	}
+
+	uint32_t CTilemap::Draw()
+	{
+		/* Only the chunks in the view are visited, the rest of the map costs nothing. */
+		const FViewBounds& View = CRenderer::GetViewBounds();
+		const float ChunkWorldSize = TileSize * CHUNK_SIZE;
+		const glm::vec2 Min = glm::floor((View.Min - Origin) / ChunkWorldSize);
+		const glm::vec2 Max = glm::floor((View.Max - Origin) / ChunkWorldSize);
+		if ((Max.x < 0.0f) || (Max.y < 0.0f) || (Min.x >= ChunkCountX) || (Min.y >= ChunkCountY))
+		{
+			return 0;
+		}
+
+		const uint32_t FirstX = static_cast<uint32_t>(std::max(Min.x, 0.0f));
+		const uint32_t FirstY = static_cast<uint32_t>(std::max(Min.y, 0.0f));
+		const uint32_t LastX = static_cast<uint32_t>(std::min(Max.x, static_cast<float>(ChunkCountX - 1)));
+		const uint32_t LastY = static_cast<uint32_t>(std::min(Max.y, static_cast<float>(ChunkCountY - 1)));
+
+		uint32_t Drawn = 0;
+		for (uint32_t ChunkY = FirstY; ChunkY <= LastY; ChunkY++)
+		{
+			for (uint32_t ChunkX = FirstX; ChunkX <= LastX; ChunkX++)
+			{
+				FChunk& Chunk = *Chunks[ChunkY * ChunkCountX + ChunkX];
+				if (Chunk.bDirty)
+				{
+					RebuildChunk(ChunkX, ChunkY);
+				}
+				if (Chunk.TileCount == 0)
+				{
+					continue;
+				}
+
+				CRenderer::DrawStaticBatch(Chunk.Batch);
+				Drawn++;
+			}
+		}
+
+		return Drawn;
+	}
+
+	glm::ivec2 CTilemap::WorldToTile(const glm::vec2& WorldPos) const
+	{
+		return glm::ivec2(glm::floor((WorldPos - Origin) / TileSize));
+	}
+
+	glm::vec2 CTilemap::TileToWorld(const uint32_t X, const uint32_t Y) const
+	{
+		return Origin + (glm::vec2(X, Y) + 0.50f) * TileSize;
+	}
+
+	void CTilemap::RebuildChunk(const uint32_t ChunkX, const uint32_t ChunkY)
+	{
+		FChunk& Chunk = *Chunks[ChunkY * ChunkCountX + ChunkX];
+		Chunk.Batch.Clear();
+		Chunk.bDirty = false;
+		if (Chunk.TileCount == 0)
+		{
+			return;
+		}
+
+		const uint32_t TexIndex = static_cast<uint32_t>(CRenderer::GetTexture(Atlas.Texture)->GetSlot());
+		const uint32_t BaseX = ChunkX * CHUNK_SIZE;
+		const uint32_t BaseY = ChunkY * CHUNK_SIZE;
+		for (uint32_t LocalY = 0; LocalY < CHUNK_SIZE; LocalY++)
+		{
+			for (uint32_t LocalX = 0; LocalX < CHUNK_SIZE; LocalX++)
+			{
+				const LTile Tile = Chunk.Tiles[LocalY * CHUNK_SIZE + LocalX];
+				if (Tile == EMPTY)
+				{
+					continue;
+				}
+
+				const FSpriteUV UV = Atlas.GetUV(Tile);
+				Chunk.Batch.AddQuad(FQuadInstance(
+					glm::vec3(TileToWorld(BaseX + LocalX, BaseY + LocalY), Depth),
+					glm::vec2(TileSize),
+					0.0f,
+					glm::vec4(1.0f),
+					TexIndex,
+					{ UV.U0, UV.V0 },
+					{ UV.U1, UV.V1 }
+				));
+			}
+		}
+		LK_TRACE_TAG("Tilemap", "Rebuilt chunk ({}, {}): {} tiles", ChunkX, ChunkY, Chunk.TileCount);
+	}
+
+	void CTilemap::MarkAllDirty()
+	{
+		for (std::unique_ptr<FChunk>& Chunk : Chunks)
+		{
+			Chunk->bDirty = true;
+		}
+	}
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/core.h"
+#include "sprite.h"
+#include "staticbatch.h"
+#include "texture.h"
+
+namespace platformer2d {
+
+	/** Tile index into the atlas, offset by one so that zero is an empty cell. */
+	using LTile = uint16_t;
+
+	/**
+	 * @brief Sprite sheet of equally sized tiles laid out in a grid.
+	 * Tiles are numbered row by row, starting at 1 in the cell at UV (0, 0).
+	 */
+	struct FTileAtlas
+	{
+		ETexture Texture = ETexture::White;
+		uint16_t Columns = 1;
+		uint16_t Rows = 1;
+
+		FORCEINLINE uint32_t GetTileCount() const { return static_cast<uint32_t>(Columns) * Rows; }
+		FSpriteUV GetUV(LTile Tile) const;
+	};
+
+	/**
+	 * @brief Grid of tiles stored and drawn in fixed-size chunks.
+	 *
+	 * Every chunk keeps its tiles in a flat index array and its quads in a static
+	 * batch that is only rebuilt after one of its tiles changed. Drawing visits the
+	 * chunks overlapping the view, so a level costs one draw call per visible chunk
+	 * regardless of its total size.
+	 */
+	class CTilemap
+	{
+	public:
+		static constexpr uint32_t CHUNK_SIZE = 32;
+		static constexpr LTile EMPTY = 0;
+
+		/**
+		 * @param InOrigin World position of the bottom left corner of tile (0, 0).
+		 */
+		CTilemap(uint32_t InWidth, uint32_t InHeight, const FTileAtlas& InAtlas,
+				 float InTileSize = 1.0f, const glm::vec2& InOrigin = { 0.0f, 0.0f });
+		CTilemap() = delete;
+		~CTilemap() = default;
+
+		void SetTile(uint32_t X, uint32_t Y, LTile Tile);
+		LTile GetTile(uint32_t X, uint32_t Y) const;
+
+		/**
+		 * @brief Set every tile of a rectangle, clipped to the map.
+		 */
+		void Fill(uint32_t X, uint32_t Y, uint32_t InWidth, uint32_t InHeight, LTile Tile);
+		void Clear();
+
+		/**
+		 * @brief Draw the chunks overlapping the view of the renderer.
+		 * Chunks edited since they were last drawn are rebuilt first.
+		 * @return Number of chunks drawn.
+		 */
+		uint32_t Draw();
+
+		/**
+		 * @brief Tile containing a world position, can be outside of the map.
+		 */
+		glm::ivec2 WorldToTile(const glm::vec2& WorldPos) const;
+		glm::vec2 TileToWorld(uint32_t X, uint32_t Y) const;
+
+		FORCEINLINE bool Contains(const int X, const int Y) const
+		{
+			return (X >= 0) && (Y >= 0) && (static_cast<uint32_t>(X) < Width) && (static_cast<uint32_t>(Y) < Height);
+		}
+
+		FORCEINLINE uint32_t GetWidth() const { return Width; }
+		FORCEINLINE uint32_t GetHeight() const { return Height; }
+		FORCEINLINE float GetTileSize() const { return TileSize; }
+		FORCEINLINE const glm::vec2& GetOrigin() const { return Origin; }
+		FORCEINLINE const FTileAtlas& GetAtlas() const { return Atlas; }
+		FORCEINLINE float GetDepth() const { return Depth; }
+		FORCEINLINE void SetDepth(const float InDepth) { Depth = InDepth; MarkAllDirty(); }
+		FORCEINLINE uint32_t GetChunkCountX() const { return ChunkCountX; }
+		FORCEINLINE uint32_t GetChunkCountY() const { return ChunkCountY; }
+
+	private:
+		struct FChunk
+		{
+			std::array<LTile, CHUNK_SIZE * CHUNK_SIZE> Tiles{};
+			uint16_t TileCount = 0; /* Non-empty tiles. */
+			bool bDirty = false;
+			CStaticBatch Batch;
+		};
+
+		FORCEINLINE FChunk& GetChunk(const uint32_t X, const uint32_t Y)
+		{
+			return *Chunks[(Y / CHUNK_SIZE) * ChunkCountX + (X / CHUNK_SIZE)];
+		}
+		FORCEINLINE const FChunk& GetChunk(const uint32_t X, const uint32_t Y) const
+		{
+			return *Chunks[(Y / CHUNK_SIZE) * ChunkCountX + (X / CHUNK_SIZE)];
+		}
+		FORCEINLINE static std::size_t GetTileIndex(const uint32_t X, const uint32_t Y)
+		{
+			return (Y % CHUNK_SIZE) * CHUNK_SIZE + (X % CHUNK_SIZE);
+		}
+
+		void RebuildChunk(uint32_t ChunkX, uint32_t ChunkY);
+		void MarkAllDirty();
+
+	private:
+		uint32_t Width = 0;
+		uint32_t Height = 0;
+		uint32_t ChunkCountX = 0;
+		uint32_t ChunkCountY = 0;
+		float TileSize = 1.0f;
+		float Depth = 0.0f;
+		glm::vec2 Origin = { 0.0f, 0.0f };
+		FTileAtlas Atlas{};
+
+		/* Static batches cannot be moved, so the chunks are allocated individually. */
+		std::vector<std::unique_ptr<FChunk>> Chunks;
+	};
+
+}
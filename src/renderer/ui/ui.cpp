@@ -420,15 +420,70 @@ namespace platformer2d::UI {
 
 		if (bSetBlendFunc)
 		{
-			LK_OpenGL_Verify(glBlendFunc(
+			CRenderer::SetBlendFunction(
 				SourceBlendFuncs[SelectedSourceBlendFunc].first,
 				DestBlendFuncs[SelectedDestBlendFunc].first
-			));
+			);
 		}
 
 		return bSetBlendFunc;
 	}
 
+	void DrawStatistics()
+	{
+		const FDrawStatistics& Stats = CRenderer::GetDrawStatistics();
+		static constexpr ImGuiTableFlags TableFlags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg;
+		if (!ImGui::BeginTable("##DrawStatistics", 2, TableFlags))
+		{
+			return;
+		}
+
+		auto Row = [](const char* Label, const char* Format, auto... Args)
+		{
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+			ImGui::TextUnformatted(Label);
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text(Format, Args...);
+		};
+
+		Row("CPU frame", "%.3f ms", Stats.CpuTimeMs);
+		if (CRenderer::HasRenderThread())
+		{
+			Row("Render thread", "%.3f ms (waited %.3f ms)", Stats.RenderThreadTimeMs, Stats.RenderThreadWaitMs);
+			Row("Render commands", "%u (%.1f KiB, %.1f KiB reserved)", Stats.RenderCommands,
+				Stats.RenderCommandBytes / 1024.0f, Stats.RenderCommandBytesReserved / 1024.0f);
+		}
+		for (int Idx = 0; Idx < CGpuTimer::PASS_COUNT; Idx++)
+		{
+			const EGpuPass Pass = static_cast<EGpuPass>(Idx);
+			Row(std::format("GPU {}", Enum::ToString(Pass)).c_str(), "%.3f ms", Stats.GetGpuTime(Pass));
+		}
+		Row("Quads", "%llu", Stats.QuadCount);
+		Row("Lines", "%llu", Stats.LineCount);
+		Row("Circles", "%llu", Stats.CircleCount);
+		Row("Culled", "%llu / %llu", Stats.CulledCount, Stats.CulledCount + Stats.SubmittedCount);
+		Row("Draw calls", "%llu", Stats.DrawCallCount);
+		Row("Flushes", "%llu", Stats.FlushCount);
+		for (int Idx = 0; Idx < static_cast<int>(EBatchBreak::COUNT); Idx++)
+		{
+			const EBatchBreak Reason = static_cast<EBatchBreak>(Idx);
+			Row(std::format("  {}", Enum::ToString(Reason)).c_str(), "%llu", Stats.GetBatchBreaks(Reason));
+		}
+		Row("Records", "%llu", Stats.RecordCount);
+		Row("Vertices", "%llu", Stats.VertexCount);
+		Row("Indices", "%llu", Stats.IndexCount);
+		Row("Uploaded", "%llu bytes", Stats.BytesUploaded);
+		Row("Shader binds", "%llu", Stats.ShaderBinds);
+		Row("Texture binds", "%llu", Stats.TextureBinds);
+		Row("State calls", "%llu (%llu skipped)", Stats.StateCallsIssued, Stats.StateCallsSkipped);
+		Row("Fence waits", "%u", Stats.FenceWaits);
+		Row("Layer redraws", "%llu (%llu cached)", Stats.LayerRedraws, Stats.LayerCacheHits);
+		Row("Texture uploads", "%llu bytes (%u pending)", Stats.TextureBytesUploaded, Stats.TexturesPending);
+
+		ImGui::EndTable();
+	}
+
 	void DrawGizmo(const int Operation, CActor& Actor, const glm::mat4& ViewMatrix, const glm::mat4& ProjectionMatrix, const glm::vec3& CameraPos)
 	{
 		static_assert(std::is_same_v<std::decay_t<decltype(Operation)>, std::underlying_type_t<ImGuizmo::OPERATION>>);
@@ -28,6 +28,11 @@ namespace platformer2d::UI {
 	 */
 	bool BlendFunction();
 
+	/**
+	 * @brief Table of the draw statistics of the last frame.
+	 */
+	void DrawStatistics();
+
 	void DrawGizmo(int Operation, CActor& Actor, const glm::mat4& ViewMatrix,
 				   const glm::mat4& ProjectionMatrix, const glm::vec3& CameraPos = glm::vec3(0.0f, 0.0f, 0.0f));
 
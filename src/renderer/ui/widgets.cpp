@@ -36,7 +36,11 @@ namespace platformer2d::UI::Draw {
 
 		/* Scale */
 		ImGui::TableNextRow();
-		Changed |= UI::Draw::Vec2Control("Scale", TC.Scale, 0.10f, 0.010f, 0.010f);
+		if (UI::Draw::Vec2Control("Scale", TC.Scale, 0.10f, 0.010f, 0.010f))
+		{
+			Changed = true;
+			CActor::OnActorModified.Broadcast(Actor.GetHandle());
+		}
 #if 0
 		glm::vec2 Scale = TC.Scale;
 		constexpr float LabelColumnWidth = 100.0f;
@@ -9,29 +9,28 @@ namespace platformer2d {
 	{
 		LK_OpenGL_Verify(glCreateBuffers(1, &ID));
 		LK_OpenGL_Verify(glNamedBufferData(ID, Size, nullptr, GL_DYNAMIC_DRAW)); 
-		LK_OpenGL_Verify(glBindBufferBase(GL_UNIFORM_BUFFER, 0, ID));
+		OpenGL::State::BindBufferBase(GL_UNIFORM_BUFFER, 0, ID);
 	}
 
 	CUniformBuffer::~CUniformBuffer()
 	{
+		OpenGL::State::ForgetBuffer(ID);
 		LK_OpenGL_Verify(glDeleteBuffers(1, &ID));
 	}
 
 	void CUniformBuffer::Bind() const
 	{
-		LK_OpenGL_Verify(glBindBuffer(GL_UNIFORM_BUFFER, ID));
+		OpenGL::State::BindBuffer(GL_UNIFORM_BUFFER, ID);
 	}
 
 	void CUniformBuffer::Unbind() const
 	{
-		LK_OpenGL_Verify(glBindBuffer(GL_UNIFORM_BUFFER, 0));
+		OpenGL::State::BindBuffer(GL_UNIFORM_BUFFER, 0);
 	}
 
 	void CUniformBuffer::SetData(const void* Data, const uint64_t Size, const uint64_t Offset) const
 	{
-		LK_OpenGL_Verify(glBindBuffer(GL_UNIFORM_BUFFER, ID));
 		LK_OpenGL_Verify(glNamedBufferSubData(ID, Offset, Size, Data));
-		LK_OpenGL_Verify(glBindBuffer(GL_UNIFORM_BUFFER, 0));
 	}
 
 	void CUniformBuffer::SetBinding(const std::shared_ptr<CShader> Shader, std::string_view UBName, const uint32_t BlockIndex)
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+namespace platformer2d {
+
+	struct FQuadVertex
+	{
+		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
+		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+		glm::vec2 TexCoord = { 0.0f, 0.0f };
+		int TexIndex = 0;
+		float TileFactor = 1.0f;
+	};
+
+	/**
+	 * @brief Compact quad vertex, 24 bytes instead of 44.
+	 */
+	struct FQuadVertexPacked
+	{
+		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
+		uint32_t Color = 0xFFFFFFFF;   /* RGBA8 UNORM. */
+		uint32_t TexCoord = 0;         /* UNORM16x2. */
+		uint32_t TexIndexTile = 0;     /* [TileFactor:16 (half)][Reserved:8][TexIndex:8] */
+
+		FQuadVertexPacked() = default;
+		explicit FQuadVertexPacked(const FQuadVertex& Vertex)
+			: Position(Vertex.Position)
+			, Color(glm::packUnorm4x8(Vertex.Color))
+			, TexCoord(glm::packUnorm2x16(Vertex.TexCoord))
+			, TexIndexTile(PackTexIndex(static_cast<uint32_t>(Vertex.TexIndex), Vertex.TileFactor))
+		{
+		}
+
+		static uint32_t PackTexIndex(const uint32_t TexIndex, const float TileFactor)
+		{
+			return (TexIndex & 0xFF) | (static_cast<uint32_t>(glm::packHalf1x16(TileFactor)) << 16);
+		}
+	};
+	static_assert(sizeof(FQuadVertexPacked) == 24, "FQuadVertexPacked size mismatch");
+
+	/**
+	 * @brief Per-instance quad data, expanded to the four corners in the vertex shader.
+	 */
+	struct FQuadInstance
+	{
+		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
+		float Rotation = 0.0f;                              /* Radians. */
+		glm::vec2 Size = { 1.0f, 1.0f };
+		uint32_t TexCoords[2] = { 0x00000000, 0xFFFFFFFF }; /* UNORM16x2: (U0, V0) and (U1, V1). */
+		uint32_t Color = 0xFFFFFFFF;                        /* RGBA8 UNORM. */
+		uint32_t TexIndex = 0;
+
+		FQuadInstance() = default;
+		FQuadInstance(const glm::vec3& InPosition, const glm::vec2& InSize, const float InRotation,
+					  const glm::vec4& InColor, const uint32_t InTexIndex,
+					  const glm::vec2& UV0 = { 0.0f, 0.0f }, const glm::vec2& UV1 = { 1.0f, 1.0f })
+			: Position(InPosition)
+			, Rotation(InRotation)
+			, Size(InSize)
+			, TexCoords{ glm::packUnorm2x16(UV0), glm::packUnorm2x16(UV1) }
+			, Color(glm::packUnorm4x8(InColor))
+			, TexIndex(InTexIndex)
+		{
+		}
+
+		/**
+		 * @brief Check that the corners (bottom left, top left, top right, bottom right) form
+		 *        an axis aligned UV rect inside [0, 1], the only texture coordinates an instance can hold.
+		 */
+		static bool IsTexCoordRect(const glm::vec2 (&UV)[4])
+		{
+			const bool bRect = (UV[1] == glm::vec2(UV[0].x, UV[2].y)) && (UV[3] == glm::vec2(UV[2].x, UV[0].y));
+			const bool bInRange = glm::all(glm::greaterThanEqual(glm::min(UV[0], UV[2]), glm::vec2(0.0f)))
+				&& glm::all(glm::lessThanEqual(glm::max(UV[0], UV[2]), glm::vec2(1.0f)));
+			return bRect && bInRange;
+		}
+	};
+	static_assert(sizeof(FQuadInstance) == 40, "FQuadInstance size mismatch");
+
+	struct FLineVertex
+	{
+		glm::vec3 Position = { 0.0f, 0.0f, 0.0f };
+		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	};
+
+	struct FCircleVertex
+	{
+		glm::vec3 WorldPosition = { 0.0f, 0.0f, 0.0f };
+		float Thickness = 1.0f;
+		glm::vec2 LocalPosition = { 0.0f, 0.0f };
+		glm::vec4 Color = { 1.0f, 1.0f, 1.0f, 1.0f };
+	};
+
+}
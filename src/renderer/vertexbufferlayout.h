@@ -25,6 +25,10 @@ namespace platformer2d {
 		Mat3, 
 		Mat4,
 		Bool,
+		UByte4,  /* 4x uint8_t, read as vec4 when normalized. */
+		UShort2, /* 2x uint16_t, read as vec2 when normalized. */
+		UShort4, /* 4x uint16_t, read as vec4 when normalized. */
+		UInt,
 	};
 
 	namespace Enum
@@ -45,6 +49,10 @@ namespace platformer2d {
 				case EShaderDataType::Float4:	return "Float4";
 				case EShaderDataType::Mat3:		return "Mat3";
 				case EShaderDataType::Mat4:		return "Mat4";
+				case EShaderDataType::UByte4:	return "UByte4";
+				case EShaderDataType::UShort2:	return "UShort2";
+				case EShaderDataType::UShort4:	return "UShort4";
+				case EShaderDataType::UInt:		return "UInt";
 			}
 			return "Unknown";
 		}
@@ -75,6 +83,10 @@ namespace platformer2d {
 			case EShaderDataType::Float4:   return 4 * 4;
 			case EShaderDataType::Mat3:     return 4 * 3 * 3;
 			case EShaderDataType::Mat4:     return 4 * 4 * 4;
+			case EShaderDataType::UByte4:   return 1 * 4;
+			case EShaderDataType::UShort2:  return 2 * 2;
+			case EShaderDataType::UShort4:  return 2 * 4;
+			case EShaderDataType::UInt:     return 4;
 		}
 		return 0;
 	}
@@ -87,15 +99,18 @@ namespace platformer2d {
 		size_t Offset = 0;
 		unsigned char Normalized{};
 		unsigned int Count = 0;
+		uint32_t Divisor = 0; /* Advance once per N instances, 0 advances per vertex. */
 
 		FVertexBufferElement() = default;
-		FVertexBufferElement(const std::string& InName, const EShaderDataType InShaderDataType, const bool InNormalized = false)
+		FVertexBufferElement(const std::string& InName, const EShaderDataType InShaderDataType,
+							 const bool InNormalized = false, const uint32_t InDivisor = 0)
 			: Type(InShaderDataType)
 			, Name(InName)
 			, Size(GetShaderDataTypeSize(InShaderDataType))
 			, Offset(0)
 			, Normalized(InNormalized)
 			, Count(0)
+			, Divisor(InDivisor)
 		{
 		}
 
@@ -114,6 +129,10 @@ namespace platformer2d {
 				case EShaderDataType::Int3:    return 3;
 				case EShaderDataType::Int4:    return 4;
 				case EShaderDataType::Bool:    return 1;
+				case EShaderDataType::UByte4:  return 4;
+				case EShaderDataType::UShort2: return 2;
+				case EShaderDataType::UShort4: return 4;
+				case EShaderDataType::UInt:    return 1;
 			}
 
 			LK_ASSERT(false, "GetComponentCount failed");
@@ -48,10 +48,11 @@ namespace platformer2d {
 		{
 			Body->Tick(DeltaTime);
 
-			const glm::vec2 BodyPos = Body->GetPosition();
+			/* Rendered between the last two physics steps. */
+			const glm::vec2 BodyPos = Body->GetInterpolatedPosition();
 			TransformComp.Translation.x = BodyPos.x;
 			TransformComp.Translation.y = BodyPos.y;
-			TransformComp.SetRotation2D(Body->GetRotation());
+			TransformComp.SetRotation2D(Body->GetInterpolatedRotation());
 		}
 	}
 
@@ -75,6 +76,7 @@ namespace platformer2d {
 		TransformComp.Translation.x = NewPos.x;
 		TransformComp.Translation.y = NewPos.y;
 		Body->SetPosition(NewPos);
+		OnActorModified.Broadcast(Handle);
 	}
 
 	float CActor::GetRotation() const
@@ -86,6 +88,7 @@ namespace platformer2d {
 	{
 		Body->SetRotation(AngleRad);
 		TransformComp.SetRotation2D(AngleRad);
+		OnActorModified.Broadcast(Handle);
 	}
 
 	bool CActor::IsMoving() const
@@ -112,6 +115,7 @@ namespace platformer2d {
 	void CActor::SetColor(const glm::vec4& InColor)
 	{
 		Color = InColor;
+		OnActorModified.Broadcast(Handle);
 	}
 
 	bool CActor::Serialize(YAML::Emitter& Out) const
@@ -17,6 +17,7 @@ namespace platformer2d {
 	public:
 		LK_DECLARE_EVENT(FOnActorCreated, CActor, LUUID, std::weak_ptr<CActor>);
 		LK_DECLARE_MULTICAST_DELEGATE(FOnActorMarkedForDeletion, LUUID);
+		LK_DECLARE_MULTICAST_DELEGATE(FOnActorModified, LUUID);
 	public:
 		CActor(const FActorSpecification& Spec = FActorSpecification());
 		CActor(LUUID InHandle, const FBodySpecification& BodySpec, ETexture InTexture = ETexture::White, const glm::vec4& InColor = FColor::White);
@@ -33,6 +34,7 @@ namespace platformer2d {
 			return Actor;
 		}
 
+		virtual void FixedTick(float FixedDeltaTime) {}
 		virtual void Tick(float DeltaTime);
 		inline LUUID GetHandle() const { return Handle; }
 
@@ -72,6 +74,9 @@ namespace platformer2d {
 	public:
 		static inline FOnActorCreated OnActorCreated;
 		static inline FOnActorMarkedForDeletion OnActorMarkedForDeletion;
+
+		/** Broadcast when the transform or color of an actor is changed outside of physics. */
+		static inline FOnActorModified OnActorModified;
 	protected:
 		FTransformComponent TransformComp{};
 		std::unique_ptr<CBody> Body;
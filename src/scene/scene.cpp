@@ -60,6 +60,14 @@ namespace platformer2d {
 		Actors.clear();
 	}
 
+	void CScene::FixedTick(const float FixedDeltaTime)
+	{
+		for (const auto& Actor : Actors)
+		{
+			Actor->FixedTick(FixedDeltaTime);
+		}
+	}
+
 	void CScene::Tick(const float DeltaTime)
 	{
 		for (const auto& Actor : Actors)
@@ -20,6 +20,7 @@ namespace platformer2d {
 		CScene() = delete;
 		~CScene();
 
+		void FixedTick(float FixedDeltaTime);
 		void Tick(float DeltaTime);
 
 		std::shared_ptr<CActor> FindActor(LUUID Handle);
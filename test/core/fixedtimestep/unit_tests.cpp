@@ -0,0 +1,66 @@
+#include <catch2/catch_approx.hpp>
+
+#include "core/fixedtimestep.h"
+
+#include "test.h"
+
+using namespace platformer2d;
+
+TEST_CASE("Frame time is split into fixed steps", "[core]")
+{
+	CFixedTimestep Timestep(60);
+	REQUIRE(Timestep.GetTickRate() == 60);
+	REQUIRE(Timestep.GetStepTime() == Catch::Approx(1.0f / 60.0f));
+
+	/* Less than a step is carried over to the next frame. */
+	REQUIRE(Timestep.Advance(0.010f) == 0);
+	REQUIRE(Timestep.Advance(0.010f) == 1);
+	REQUIRE(Timestep.Advance(2.50f / 60.0f) == 2);
+
+	/* A 144 Hz frame rate against a 120 Hz tick rate takes 120 steps per second. */
+	CFixedTimestep Fast(120);
+	uint32_t Steps = 0;
+	for (int Frame = 0; Frame < 144; Frame++)
+	{
+		Steps += Fast.Advance(1.0f / 144.0f);
+	}
+	REQUIRE(((Steps == 119) || (Steps == 120)));
+	REQUIRE(Fast.GetDroppedTime() == 0.0f);
+}
+
+TEST_CASE("Steps per frame are clamped", "[core]")
+{
+	CFixedTimestep Timestep(60, 4);
+	REQUIRE(Timestep.GetMaxStepsPerFrame() == 4);
+
+	/* A one second stall takes four steps and drops the rest instead of catching up. */
+	REQUIRE(Timestep.Advance(1.0f) == 4);
+	REQUIRE(Timestep.GetDroppedTime() == Catch::Approx(56.0f / 60.0f).margin(1.0f / 60.0f));
+	REQUIRE(Timestep.GetAlpha() < 1.0f);
+	REQUIRE(Timestep.Advance(1.0f / 60.0f) <= 2);
+
+	Timestep.Reset();
+	REQUIRE(Timestep.GetDroppedTime() == 0.0f);
+	REQUIRE(Timestep.GetAlpha() == 0.0f);
+}
+
+TEST_CASE("Interpolation alpha stays within a step", "[core]")
+{
+	CFixedTimestep Timestep(60);
+	REQUIRE(Timestep.GetAlpha() == 0.0f);
+
+	Timestep.Advance(0.50f / 60.0f);
+	REQUIRE(Timestep.GetAlpha() == Catch::Approx(0.50f).margin(1e-4f));
+
+	for (int Frame = 0; Frame < 1000; Frame++)
+	{
+		Timestep.Advance(0.0073f * static_cast<float>(Frame % 7));
+		REQUIRE(Timestep.GetAlpha() >= 0.0f);
+		REQUIRE(Timestep.GetAlpha() < 1.0f);
+	}
+
+	/* Negative frame times are ignored. */
+	const float Alpha = Timestep.GetAlpha();
+	REQUIRE(Timestep.Advance(-1.0f) == 0);
+	REQUIRE(Timestep.GetAlpha() == Alpha);
+}
@@ -0,0 +1,24 @@
+#include <stdio.h>
+
+#include "test.h"
+
+#ifndef LK_TEST_SUITE
+#error "LK_TEST_SUITE missing"
+#endif
+
+using namespace platformer2d;
+using namespace platformer2d::test;
+
+int main(int Argc, char* Argv[])
+{
+	spdlog::set_level(spdlog::level::debug);
+
+	{
+		CTest Test(Argc, Argv);
+		Test.Run();
+		Test.Destroy();
+	}
+
+	LK_INFO_TAG("Main", "Exit: {}", errno);
+	return 0;
+}
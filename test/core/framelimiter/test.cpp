@@ -0,0 +1,33 @@
+#include "test.h"
+
+#include <spdlog/spdlog.h>
+
+namespace platformer2d::test {
+
+	namespace
+	{
+		constexpr bool NO_TEST_INIT = false;
+	}
+
+	CTest::CTest(const int Argc, char* Argv[])
+		: CTestBase(Argc, Argv, NO_TEST_INIT)
+	{
+		/* Pure logic, no window or renderer. */
+		CLog::Initialize();
+		LK_INFO("{}", LK_TEST_NAME);
+	}
+
+	void CTest::Run()
+	{
+		bRunning = true;
+		const int CatchResult = Catch::Session().run(Args.Argc, Args.Argv);
+		LK_DEBUG("Catch result: {}", CatchResult);
+		bRunning = false;
+	}
+
+	void CTest::Destroy()
+	{
+		LK_DEBUG_TAG("Test", "Destroy");
+	}
+
+}
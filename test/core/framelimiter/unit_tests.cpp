@@ -0,0 +1,79 @@
+#include <chrono>
+#include <thread>
+
+#include "core/framelimiter.h"
+
+#include "test.h"
+
+using namespace platformer2d;
+using namespace std::chrono_literals;
+
+namespace
+{
+	using FClock = std::chrono::steady_clock;
+}
+
+TEST_CASE("Unlimited frame rate does not wait", "[core]")
+{
+	CFrameLimiter FrameLimiter;
+	REQUIRE(FrameLimiter.GetFrameRate() == 0);
+
+	const FClock::time_point Start = FClock::now();
+	for (int Frame = 0; Frame < 1000; Frame++)
+	{
+		FrameLimiter.Wait();
+	}
+	REQUIRE((FClock::now() - Start) < 10ms);
+}
+
+TEST_CASE("Frames are paced to deadlines", "[core]")
+{
+	constexpr int Frames = 20;
+	constexpr auto FrameTime = 10ms;
+
+	const FClock::time_point Start = FClock::now();
+	CFrameLimiter FrameLimiter(100);
+	REQUIRE(FrameLimiter.GetFrameRate() == 100);
+
+	for (int Frame = 1; Frame <= Frames; Frame++)
+	{
+		/* Half a frame of work, the wait only covers the rest of it. */
+		std::this_thread::sleep_for(FrameTime / 2);
+		FrameLimiter.Wait();
+		REQUIRE((FClock::now() - Start) >= (Frame * FrameTime));
+	}
+
+	/* Pacing from the end of each wait instead of the deadline would take 300 ms. */
+	REQUIRE((FClock::now() - Start) < (Frames * FrameTime + 60ms));
+}
+
+TEST_CASE("A stall restarts the cadence", "[core]")
+{
+	constexpr auto FrameTime = 10ms;
+	CFrameLimiter FrameLimiter(100);
+	FrameLimiter.Wait();
+
+	/* Five frames late, the missed frames are not caught up on. */
+	std::this_thread::sleep_for(5 * FrameTime);
+	const FClock::time_point Stalled = FClock::now();
+	FrameLimiter.Wait();
+	REQUIRE((FClock::now() - Stalled) < FrameTime);
+
+	for (int Frame = 1; Frame <= 3; Frame++)
+	{
+		FrameLimiter.Wait();
+		REQUIRE((FClock::now() - Stalled) >= (Frame * FrameTime));
+	}
+
+	/* Reset starts the next frame now. */
+	std::this_thread::sleep_for(FrameTime / 2);
+	const FClock::time_point Reset = FClock::now();
+	FrameLimiter.Reset();
+	FrameLimiter.Wait();
+	REQUIRE((FClock::now() - Reset) >= FrameTime);
+
+	FrameLimiter.SetFrameRate(0);
+	const FClock::time_point Unlimited = FClock::now();
+	FrameLimiter.Wait();
+	REQUIRE((FClock::now() - Unlimited) < FrameTime);
+}
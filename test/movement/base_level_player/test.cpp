@@ -176,6 +176,7 @@ namespace platformer2d::test {
 			static bool bRendererDrawQuad = false;
 			ImGui::Checkbox("Renderer: Draw Quad", &bRendererDrawQuad);
 
+			Player.FixedTick(DeltaTime);
 			Player.Tick(DeltaTime);
 			/* -- ~Player-- */
 
@@ -14,6 +14,7 @@
 #include "core/window.h"
 #include "core/timer.h"
 #include "renderer/renderer.h"
+#include "renderer/ui/ui.h"
 #include "renderer/debugrenderer.h"
 #include "renderer/vertexbufferlayout.h"
 
@@ -249,6 +250,7 @@ namespace platformer2d::test {
 			}
 			ImGui::SameLine(0, 14.0f);
 			if (ImGui::Button("World Step")) CPhysicsWorld::Update(DeltaTime);
+			CPhysicsWorld::DrawDebug();
 			ImGui::SameLine(0, 20.0f);
 			const b2Vec2 G = b2World_GetGravity(WorldID);
 			ImGui::Text("Gravity: (%.1f, %.1f)", G.x, G.y);
@@ -265,6 +267,7 @@ namespace platformer2d::test {
 			ImGui::TableSetColumnIndex(0);
 
 			/* -- Player -- */
+			Player.FixedTick(DeltaTime);
 			Player.Tick(DeltaTime);
 			ImGui::PushItemWidth(200.0f);
 			ImGui::SeparatorText("Player");
@@ -414,6 +417,14 @@ namespace platformer2d::test {
 			CTest::UI_BlendFunction();
 			ImGui::End();
 		}
+		if (bShowDrawStats)
+		{
+			if (ImGui::Begin("Draw Statistics", &bShowDrawStats))
+			{
+				UI::DrawStatistics();
+			}
+			ImGui::End();
+		}
 	}
 
 	void UI_CircleDrawMenu(const CPlayer& Player)
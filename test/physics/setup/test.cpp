@@ -14,6 +14,7 @@
 #include "core/window.h"
 #include "core/timer.h"
 #include "renderer/renderer.h"
+#include "renderer/ui/ui.h"
 #include "renderer/vertexbufferlayout.h"
 
 #include "game/player.h"
@@ -210,12 +211,9 @@ namespace platformer2d::test {
 			static bool bRendererDrawCircle = false;
 			ImGui::Checkbox("Draw Circle", &bRendererDrawCircle);
 
-			const FDrawStatistics& DrawStats = CRenderer::GetDrawStatistics();
 			if (ImGui::TreeNodeEx("Draw Statistics", ImGuiTreeNodeFlags_SpanLabelWidth))
 			{
-				ImGui::Text("Quads: %d", DrawStats.QuadCount);
-				ImGui::Text("Lines: %d", DrawStats.LineCount);
-
+				UI::DrawStatistics();
 				ImGui::TreePop();
 			}
 
@@ -282,6 +280,7 @@ namespace platformer2d::test {
 			ImGui::Text("Player Texture: %d", PlayerTexture.GetSlot());
 			ImGui::PopID();
 
+			Player.FixedTick(DeltaTime);
 			Player.Tick(DeltaTime);
 			/* -- ~Player-- */
 
@@ -394,6 +393,14 @@ namespace platformer2d::test {
 				CTest::UI_BlendFunction();
 				ImGui::End();
 			}
+			if (bShowDrawStats)
+			{
+				if (ImGui::Begin("Draw Statistics", &bShowDrawStats))
+				{
+					UI::DrawStatistics();
+				}
+				ImGui::End();
+			}
 
 			static float Radius = 0.15f;
 			static float FillRadius = 0.15f;
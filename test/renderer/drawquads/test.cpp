@@ -0,0 +1,33 @@
+#include "test.h"
+
+#include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
+
+#include "core/assert.h"
+#include "core/window.h"
+#include "renderer/renderer.h"
+
+namespace platformer2d::test {
+
+	CTest::CTest(const int Argc, char* Argv[])
+		: CTestBase(Argc, Argv)
+	{
+		/* The batched path runs the quad kernel on every bulk submission. */
+		CRenderer::Initialize({ .QuadRenderPath = EQuadRenderPath::Batched });
+	}
+
+	void CTest::Run()
+	{
+		bRunning = true;
+		const int CatchResult = Catch::Session().run(Args.Argc, Args.Argv);
+		LK_DEBUG("Catch result: {}", CatchResult);
+		bRunning = false;
+	}
+
+	void CTest::Destroy()
+	{
+		LK_DEBUG_TAG("Test", "Destroy");
+		CRenderer::Destroy();
+	}
+
+}
@@ -0,0 +1,464 @@
+#include <cmath>
+#include <fstream>
+#include <numbers>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/core.h"
+#include "renderer/circletable.h"
+#include "renderer/quadkernel.h"
+#include "renderer/renderer.h"
+#include "renderer/shader.h"
+#include "renderer/shadercache.h"
+#include "renderer/staticbatch.h"
+#include "renderer/vertexbufferlayout.h"
+
+#include "test.h"
+
+using namespace platformer2d;
+
+namespace
+{
+	constexpr std::size_t QuadCount = 8192;
+
+	/* Odd count to exercise the tail of the vectorized loop. */
+	std::vector<FQuadInstance> CreateInstances(const std::size_t Count)
+	{
+		std::mt19937 Engine(1337);
+		std::uniform_real_distribution<float> Position(-20.0f, 20.0f);
+		std::uniform_real_distribution<float> Size(0.10f, 4.0f);
+		std::uniform_real_distribution<float> Rotation(-10.0f, 10.0f);
+
+		std::vector<FQuadInstance> Instances;
+		Instances.reserve(Count);
+		for (std::size_t Idx = 0; Idx < Count; Idx++)
+		{
+			Instances.emplace_back(
+				glm::vec3(Position(Engine), Position(Engine), 0.50f),
+				glm::vec2(Size(Engine), Size(Engine)),
+				Rotation(Engine),
+				glm::vec4(1.0f, 0.50f, 0.25f, 1.0f),
+				static_cast<uint32_t>(Idx % 8),
+				glm::vec2(0.25f, 0.50f),
+				glm::vec2(0.75f, 1.0f)
+			);
+		}
+
+		return Instances;
+	}
+
+	/* Source of one stage of a .shader file, between its #lk_shader line and the next. */
+	std::string ReadShaderStage(const char* Filepath, const std::string& Stage)
+	{
+		std::ifstream File(Filepath);
+		std::stringstream Source;
+		bool bInStage = false;
+		std::string Line;
+		while (std::getline(File, Line))
+		{
+			if (Line.starts_with("#lk_shader"))
+			{
+				bInStage = Line.contains(Stage);
+				continue;
+			}
+			if (bInStage)
+			{
+				Source << Line << '\n';
+			}
+		}
+
+		return Source.str();
+	}
+}
+
+TEST_CASE("Quad kernel matches scalar reference", "[renderer]")
+{
+	using Catch::Matchers::WithinAbs;
+	const std::vector<FQuadInstance> Instances = CreateInstances(1027);
+	std::vector<FQuadVertex> Vertices(Instances.size() * 4);
+	std::vector<FQuadVertex> Reference(Instances.size() * 4);
+
+	QuadKernel::GenerateVertices(Instances, Vertices.data());
+	QuadKernel::GenerateVerticesScalar(Instances, Reference.data());
+	LK_INFO("Quad kernel: {} ({} quads per iteration)", QuadKernel::GetInstructionSet(), QuadKernel::GetWidth());
+
+	for (std::size_t Idx = 0; Idx < Vertices.size(); Idx++)
+	{
+		REQUIRE_THAT(Vertices[Idx].Position.x, WithinAbs(Reference[Idx].Position.x, 1e-4));
+		REQUIRE_THAT(Vertices[Idx].Position.y, WithinAbs(Reference[Idx].Position.y, 1e-4));
+		REQUIRE(Vertices[Idx].Position.z == Reference[Idx].Position.z);
+		REQUIRE(Vertices[Idx].Color == Reference[Idx].Color);
+		REQUIRE(Vertices[Idx].TexCoord == Reference[Idx].TexCoord);
+		REQUIRE(Vertices[Idx].TexIndex == Reference[Idx].TexIndex);
+	}
+}
+
+TEST_CASE("Packed quad vertices match packed full vertices", "[renderer]")
+{
+	const std::vector<FQuadInstance> Instances = CreateInstances(61);
+	std::vector<FQuadVertex> Vertices(Instances.size() * 4);
+	std::vector<FQuadVertexPacked> PackedVertices(Instances.size() * 4);
+
+	QuadKernel::GenerateVertices(Instances, Vertices.data());
+	QuadKernel::GenerateVertices(Instances, PackedVertices.data());
+
+	for (std::size_t Idx = 0; Idx < Vertices.size(); Idx++)
+	{
+		const FQuadVertexPacked Packed(Vertices[Idx]);
+		REQUIRE(PackedVertices[Idx].Position == Packed.Position);
+		REQUIRE(PackedVertices[Idx].Color == Packed.Color);
+		REQUIRE(PackedVertices[Idx].TexCoord == Packed.TexCoord);
+		REQUIRE(PackedVertices[Idx].TexIndexTile == Packed.TexIndexTile);
+	}
+}
+
+TEST_CASE("Quad kernel corner order", "[renderer]")
+{
+	const FQuadInstance Instance(glm::vec3(1.0f, 2.0f, 0.0f), glm::vec2(2.0f, 4.0f), 0.0f, glm::vec4(1.0f), 0);
+	FQuadVertex Vertices[4];
+	QuadKernel::GenerateVertices({ &Instance, 1 }, Vertices);
+
+	REQUIRE(glm::vec2(Vertices[0].Position) == glm::vec2(0.0f, 0.0f));
+	REQUIRE(glm::vec2(Vertices[1].Position) == glm::vec2(0.0f, 4.0f));
+	REQUIRE(glm::vec2(Vertices[2].Position) == glm::vec2(2.0f, 4.0f));
+	REQUIRE(glm::vec2(Vertices[3].Position) == glm::vec2(2.0f, 0.0f));
+}
+
+TEST_CASE("Instanced quad expansion matches batched vertices", "[renderer]")
+{
+	using namespace OpenGL;
+	using Catch::Matchers::WithinAbs;
+
+	/* Mirrored and partial UV rects as well, each instance should cover the same corners and UVs as its batched vertices. */
+	std::vector<FQuadInstance> Instances = CreateInstances(61);
+	Instances.emplace_back(glm::vec3(3.0f, -2.0f, 0.25f), glm::vec2(1.0f, 3.0f), 1.25f, glm::vec4(1.0f), 2,
+						   glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f));
+	std::vector<FQuadVertex> Batched(Instances.size() * 4);
+	QuadKernel::GenerateVerticesScalar(Instances, Batched.data());
+
+	/* Run the vertex stage of the instanced shader alone and capture the corners with transform feedback. */
+	const std::string VertexSource = ReadShaderStage(SHADERS_DIR "/quad_instanced.shader", "vertex");
+	REQUIRE_FALSE(VertexSource.empty());
+	const char* Source = VertexSource.c_str();
+	const GLuint VertexShader = glCreateShader(GL_VERTEX_SHADER);
+	LK_OpenGL_Verify(glShaderSource(VertexShader, 1, &Source, nullptr));
+	LK_OpenGL_Verify(glCompileShader(VertexShader));
+
+	const GLuint Program = glCreateProgram();
+	LK_OpenGL_Verify(glAttachShader(Program, VertexShader));
+	const char* Varyings[] = { "gl_Position", "v_texcoord" };
+	LK_OpenGL_Verify(glTransformFeedbackVaryings(Program, 2, Varyings, GL_INTERLEAVED_ATTRIBS));
+	LK_OpenGL_Verify(glLinkProgram(Program));
+	GLint LinkStatus = GL_FALSE;
+	LK_OpenGL_Verify(glGetProgramiv(Program, GL_LINK_STATUS, &LinkStatus));
+	REQUIRE(LinkStatus == GL_TRUE);
+
+	/* Identity camera, the captured position is the world position. */
+	const glm::mat4 ViewProjection(1.0f);
+	GLuint Buffers[3] = {};
+	LK_OpenGL_Verify(glCreateBuffers(3, Buffers));
+	const auto [CameraBuffer, InstanceBuffer, CaptureBuffer] = Buffers;
+	LK_OpenGL_Verify(glNamedBufferData(CameraBuffer, sizeof(ViewProjection), &ViewProjection, GL_STATIC_DRAW));
+	LK_OpenGL_Verify(glNamedBufferData(InstanceBuffer, Instances.size() * sizeof(FQuadInstance), Instances.data(), GL_STATIC_DRAW));
+
+	struct FCapturedVertex
+	{
+		glm::vec4 Position;
+		glm::vec2 TexCoord;
+	};
+	std::vector<FCapturedVertex> Captured(Instances.size() * 4);
+	LK_OpenGL_Verify(glNamedBufferData(CaptureBuffer, Captured.size() * sizeof(FCapturedVertex), nullptr, GL_STATIC_READ));
+
+	const FVertexBufferLayout InstanceLayout = {
+		{ "transform", EShaderDataType::Float4,  false, 1 },
+		{ "size",      EShaderDataType::Float2,  false, 1 },
+		{ "texcoords", EShaderDataType::UShort4, true,  1 },
+		{ "color",     EShaderDataType::UByte4,  true,  1 },
+		{ "texindex",  EShaderDataType::UInt,    false, 1 },
+	};
+	const GLuint VAO = VertexArray::Create();
+	State::BindBuffer(GL_ARRAY_BUFFER, InstanceBuffer);
+	ApplyVertexBufferLayout(InstanceLayout);
+
+	State::UseProgram(Program);
+	State::BindBufferBase(GL_UNIFORM_BUFFER, 0, CameraBuffer);
+	LK_OpenGL_Verify(glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, CaptureBuffer));
+	State::SetEnabled(GL_RASTERIZER_DISCARD, true);
+	LK_OpenGL_Verify(glBeginTransformFeedback(GL_POINTS));
+	LK_OpenGL_Verify(glDrawArraysInstanced(GL_POINTS, 0, 4, static_cast<GLsizei>(Instances.size())));
+	LK_OpenGL_Verify(glEndTransformFeedback());
+	State::SetEnabled(GL_RASTERIZER_DISCARD, false);
+	LK_OpenGL_Verify(glGetNamedBufferSubData(CaptureBuffer, 0, Captured.size() * sizeof(FCapturedVertex), Captured.data()));
+
+	/* The strip is drawn BL, BR, TL, TR, the batched vertices are BL, TL, TR, BR. */
+	constexpr int StripCorner[4] = { 0, 2, 3, 1 };
+	for (std::size_t Quad = 0; Quad < Instances.size(); Quad++)
+	{
+		for (int Corner = 0; Corner < 4; Corner++)
+		{
+			const FQuadVertex& Expected = Batched[(Quad * 4) + Corner];
+			const FCapturedVertex& Vertex = Captured[(Quad * 4) + StripCorner[Corner]];
+			REQUIRE_THAT(Vertex.Position.x, WithinAbs(Expected.Position.x, 1e-3));
+			REQUIRE_THAT(Vertex.Position.y, WithinAbs(Expected.Position.y, 1e-3));
+			REQUIRE_THAT(Vertex.Position.z, WithinAbs(Expected.Position.z, 1e-6));
+			REQUIRE_THAT(Vertex.TexCoord.x, WithinAbs(Expected.TexCoord.x, 1e-5));
+			REQUIRE_THAT(Vertex.TexCoord.y, WithinAbs(Expected.TexCoord.y, 1e-5));
+		}
+	}
+
+	State::UseProgram(0);
+	State::BindVertexArray(0);
+	State::ForgetProgram(Program);
+	State::ForgetVertexArray(VAO);
+	State::ForgetBuffer(CameraBuffer);
+	State::ForgetBuffer(InstanceBuffer);
+	State::ForgetBuffer(CaptureBuffer);
+	LK_OpenGL_Verify(glDeleteProgram(Program));
+	LK_OpenGL_Verify(glDeleteShader(VertexShader));
+	LK_OpenGL_Verify(glDeleteVertexArrays(1, &VAO));
+	LK_OpenGL_Verify(glDeleteBuffers(3, Buffers));
+}
+
+TEST_CASE("Instanced quads hold a UV rect inside [0, 1]", "[renderer]")
+{
+	const glm::vec2 Full[4] = { { 0.0f, 0.0f }, { 0.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f } };
+	const glm::vec2 Mirrored[4] = { { 1.0f, 0.25f }, { 1.0f, 0.75f }, { 0.0f, 0.75f }, { 0.0f, 0.25f } };
+	const glm::vec2 Tiled[4] = { { 0.0f, 0.0f }, { 0.0f, 4.0f }, { 4.0f, 4.0f }, { 4.0f, 0.0f } };
+	const glm::vec2 Skewed[4] = { { 0.0f, 0.0f }, { 0.25f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f } };
+	REQUIRE(FQuadInstance::IsTexCoordRect(Full));
+	REQUIRE(FQuadInstance::IsTexCoordRect(Mirrored));
+	REQUIRE_FALSE(FQuadInstance::IsTexCoordRect(Tiled));
+	REQUIRE_FALSE(FQuadInstance::IsTexCoordRect(Skewed));
+}
+
+TEST_CASE("View bounds from view projection", "[renderer]")
+{
+	using Catch::Matchers::WithinAbs;
+	const glm::mat4 Projection = glm::ortho(-4.0f, 4.0f, -2.0f, 2.0f, -1.0f, 1.0f);
+	const glm::mat4 View = glm::translate(glm::mat4(1.0f), glm::vec3(-10.0f, -5.0f, 0.0f));
+	CRenderer::SetCameraViewProjection(Projection * View);
+
+	const FViewBounds& Bounds = CRenderer::GetViewBounds();
+	REQUIRE_THAT(Bounds.Min.x, WithinAbs(6.0f, 1e-4));
+	REQUIRE_THAT(Bounds.Min.y, WithinAbs(3.0f, 1e-4));
+	REQUIRE_THAT(Bounds.Max.x, WithinAbs(14.0f, 1e-4));
+	REQUIRE_THAT(Bounds.Max.y, WithinAbs(7.0f, 1e-4));
+
+	REQUIRE(Bounds.Overlaps({ 10.0f, 5.0f }, { 0.50f, 0.50f }));
+	REQUIRE(Bounds.Overlaps({ 5.75f, 5.0f }, { 0.50f, 0.50f }));   /* Partially inside. */
+	REQUIRE_FALSE(Bounds.Overlaps({ 5.0f, 5.0f }, { 0.50f, 0.50f }));
+	REQUIRE_FALSE(Bounds.Overlaps({ 10.0f, 8.0f }, { 0.50f, 0.50f }));
+	REQUIRE(FViewBounds{}.Overlaps({ 1e30f, -1e30f }, { 0.0f, 0.0f })); /* Unbounded. */
+}
+
+TEST_CASE("Circle table", "[renderer]")
+{
+	using Catch::Matchers::WithinAbs;
+	for (int Idx = 0; Idx < CircleTable::MAX_SEGMENTS; Idx++)
+	{
+		const float Angle = 2.0f * std::numbers::pi_v<float> * static_cast<float>(Idx) / CircleTable::MAX_SEGMENTS;
+		REQUIRE_THAT(CircleTable::Points[Idx].X, WithinAbs(std::cos(Angle), 1e-6));
+		REQUIRE_THAT(CircleTable::Points[Idx].Y, WithinAbs(std::sin(Angle), 1e-6));
+	}
+
+	/* Larger circles on screen get more segments, always a power of two within the range. */
+	REQUIRE(CircleTable::GetSegmentCount(1.0f, 8, 64) == 8);
+	REQUIRE(CircleTable::GetSegmentCount(10.0f, 8, 64) == 16);
+	REQUIRE(CircleTable::GetSegmentCount(40.0f, 8, 64) == 64);
+	REQUIRE(CircleTable::GetSegmentCount(40.0f, 8, 128) == 64);
+	REQUIRE(CircleTable::GetSegmentCount(1000.0f, 8, 128) == 128);
+}
+
+TEST_CASE("Static batch is uploaded once", "[renderer]")
+{
+	using Catch::Matchers::WithinAbs;
+	CStaticBatch Batch;
+	REQUIRE(Batch.IsEmpty());
+
+	Batch.AddQuad(FQuadInstance(glm::vec3(1.0f, 2.0f, 0.0f), glm::vec2(2.0f, 2.0f), 0.0f, glm::vec4(1.0f), 0));
+	Batch.AddQuad(FQuadInstance(glm::vec3(-3.0f, 0.0f, 0.0f), glm::vec2(2.0f, 2.0f), 0.50f, glm::vec4(1.0f), 0));
+	REQUIRE(Batch.GetQuadCount() == 2);
+	REQUIRE(Batch.IsDirty());
+
+	/* Bounds use the half diagonal of every quad. */
+	const float HalfDiagonal = std::sqrt(2.0f);
+	REQUIRE_THAT(Batch.GetBoundsMin().x, WithinAbs(-3.0f - HalfDiagonal, 1e-5));
+	REQUIRE_THAT(Batch.GetBoundsMin().y, WithinAbs(0.0f - HalfDiagonal, 1e-5));
+	REQUIRE_THAT(Batch.GetBoundsMax().x, WithinAbs(1.0f + HalfDiagonal, 1e-5));
+	REQUIRE_THAT(Batch.GetBoundsMax().y, WithinAbs(2.0f + HalfDiagonal, 1e-5));
+
+	CRenderer::SetCameraViewProjection(glm::ortho(-8.0f, 8.0f, -8.0f, 8.0f, -1.0f, 1.0f));
+	CRenderer::DrawStaticBatch(Batch);
+	REQUIRE_FALSE(Batch.IsDirty());
+
+	Batch.Clear();
+	REQUIRE(Batch.IsEmpty());
+	REQUIRE(Batch.IsDirty());
+}
+
+TEST_CASE("Draw statistics of the last frame", "[renderer]")
+{
+	CRenderer::BeginFrame();
+	CRenderer::SetCameraViewProjection(glm::ortho(-8.0f, 8.0f, -8.0f, 8.0f, -1.0f, 1.0f));
+	for (int Idx = 0; Idx < 3; Idx++)
+	{
+		CRenderer::DrawQuad(glm::vec2(Idx, 0.0f), glm::vec2(1.0f), FColor::White);
+	}
+	CRenderer::DrawLine(glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 1.0f), FColor::White);
+	CRenderer::DrawQuad(glm::vec2(100.0f, 0.0f), glm::vec2(1.0f), FColor::White); /* Culled. */
+	CRenderer::EndFrame();
+
+	/* The statistics are swapped in at the start of the next frame. */
+	CRenderer::BeginFrame();
+	const FDrawStatistics Stats = CRenderer::GetDrawStatistics();
+	CRenderer::EndFrame();
+
+	REQUIRE(Stats.QuadCount == 3);
+	REQUIRE(Stats.LineCount == 1);
+	REQUIRE(Stats.CulledCount == 1);
+	REQUIRE(Stats.FlushCount == 2);
+	REQUIRE(Stats.GetBatchBreaks(EBatchBreak::Flush) == 2);
+	REQUIRE(Stats.GetBatchBreaks(EBatchBreak::BufferFull) == 0);
+	REQUIRE(Stats.DrawCallCount >= Stats.FlushCount);
+	REQUIRE(Stats.VertexCount == (3 * 4) + 2);
+	REQUIRE(Stats.IndexCount == (3 * 6) + 2);
+	REQUIRE(Stats.CpuTimeMs > 0.0f);
+}
+
+TEST_CASE("GL state cache skips redundant calls", "[renderer]")
+{
+	using namespace OpenGL;
+	State::Invalidate();
+	State::ResetCounters();
+
+	const std::shared_ptr<CShader> Shader = CRenderer::GetShader(CShader::EType::Quad);
+	Shader->Bind();
+	Shader->Bind();
+	REQUIRE(State::GetCounters().GetIssued(State::ECall::Program) == 1);
+	REQUIRE(State::GetCounters().GetSkipped(State::ECall::Program) == 1);
+
+	State::SetEnabled(GL_BLEND, true);
+	State::SetEnabled(GL_BLEND, true);
+	State::SetEnabled(GL_BLEND, false);
+	REQUIRE(State::GetCounters().GetIssued(State::ECall::Capability) == 2);
+	REQUIRE(State::GetCounters().GetSkipped(State::ECall::Capability) == 1);
+
+	/* A forgotten object is bound again even if its name is reused. */
+	State::ForgetProgram(Shader->GetRendererID());
+	Shader->Bind();
+	REQUIRE(State::GetCounters().GetIssued(State::ECall::Program) == 2);
+	REQUIRE(State::GetCounters().GetIssued() == 4);
+	REQUIRE(State::GetCounters().GetSkipped() == 2);
+
+	CRenderer::SetBlending(true);
+}
+
+TEST_CASE("Sampled GL error checks", "[renderer]")
+{
+	using namespace OpenGL;
+	const EOpenGLErrorCheck Policy = GetErrorCheck();
+
+	SetErrorCheck(EOpenGLErrorCheck::Sampled, 4);
+	int CheckedFrames = 0;
+	for (int Frame = 0; Frame < 16; Frame++)
+	{
+		BeginErrorCheckFrame();
+		CheckedFrames += Internal::bCheckErrors ? 1 : 0;
+	}
+	REQUIRE(CheckedFrames == 4);
+
+	SetErrorCheck(EOpenGLErrorCheck::DebugCallback);
+	BeginErrorCheckFrame();
+	REQUIRE_FALSE(Internal::bCheckErrors);
+
+	SetErrorCheck(Policy);
+}
+
+TEST_CASE("Program binary cache", "[renderer]")
+{
+	if (!CShaderCache::IsEnabled())
+	{
+		WARN("The driver has no program binary formats");
+		return;
+	}
+
+	/* The renderer shaders are compiled or loaded at startup, a second program is always a hit. */
+	const FShaderCacheStatistics Before = CShaderCache::GetStatistics();
+	const CShader Shader(SHADERS_DIR "/line.shader");
+	REQUIRE(Shader.IsBinaryCached());
+	REQUIRE(CShaderCache::GetStatistics().Hits == (Before.Hits + 1));
+	REQUIRE(CShaderCache::GetStatistics().Rejected == Before.Rejected);
+
+	GLint LinkStatus = GL_FALSE;
+	LK_OpenGL_Verify(glGetProgramiv(Shader.GetRendererID(), GL_LINK_STATUS, &LinkStatus));
+	REQUIRE(LinkStatus == GL_TRUE);
+}
+
+TEST_CASE("Active uniforms are reflected at link time", "[renderer]")
+{
+	CShader Shader(SHADERS_DIR "/quad.shader");
+	const std::size_t Reflected = Shader.GetUniforms().size();
+
+	const FUniformHandle Textures = Shader.GetUniform("u_textures");
+	REQUIRE(Textures.IsValid());
+	REQUIRE(Textures.Type == GL_SAMPLER_2D_ARRAY);
+
+	/* Arrays are reflected without the [0] suffix. */
+	const FUniformHandle TexRegion = Shader.GetUniform("u_texregion");
+	REQUIRE(TexRegion.IsValid());
+	REQUIRE(TexRegion.Type == GL_FLOAT_VEC4);
+	REQUIRE(TexRegion.Count <= CRenderer::MAX_ARRAY_TEXTURES);
+	REQUIRE(Shader.GetUniforms().size() == Reflected);
+
+	/* Uniform block members are set through the block. */
+	REQUIRE(!Shader.GetUniforms().contains(FUniformName("u_viewproj").Id));
+
+	const std::vector<glm::vec4> Regions(4, glm::vec4(8.0f, 0.0f, 16.0f, 32.0f));
+	Shader.Set(TexRegion, std::span<const glm::vec4>(Regions));
+	glm::vec4 Value(0.0f);
+	Shader.Get(Shader.GetUniform("u_texregion[3]"), Value);
+	REQUIRE(Value == glm::vec4(8.0f, 0.0f, 16.0f, 32.0f));
+}
+
+TEST_CASE("Quad submission throughput", "[renderer][!benchmark]")
+{
+	/* Keep every quad in view so nothing is culled. */
+	CRenderer::SetCameraViewProjection(glm::ortho(-32.0f, 32.0f, -32.0f, 32.0f, -1.0f, 1.0f));
+	const std::vector<FQuadInstance> Instances = CreateInstances(QuadCount);
+	std::vector<FQuadVertex> Vertices(Instances.size() * 4);
+	const CTexture& Texture = *CRenderer::GetTexture(ETexture::White);
+
+	BENCHMARK("Kernel (scalar)")
+	{
+		QuadKernel::GenerateVerticesScalar(Instances, Vertices.data());
+		return Vertices[0].Position.x;
+	};
+
+	BENCHMARK("Kernel (vectorized)")
+	{
+		QuadKernel::GenerateVertices(Instances, Vertices.data());
+		return Vertices[0].Position.x;
+	};
+
+	BENCHMARK("DrawQuad (per call)")
+	{
+		for (const FQuadInstance& Instance : Instances)
+		{
+			CRenderer::DrawQuad(Instance.Position, Instance.Size, Texture, FColor::White, glm::degrees(Instance.Rotation));
+		}
+		CRenderer::Flush();
+	};
+
+	BENCHMARK("DrawQuads (bulk)")
+	{
+		CRenderer::DrawQuads(Instances);
+		CRenderer::Flush();
+	};
+}
@@ -0,0 +1,423 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <vector>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/core.h"
+#include "renderer/cookedtexture.h"
+#include "renderer/renderer.h"
+#include "renderer/shader.h"
+#include "renderer/shadercache.h"
+#include "renderer/textureloader.h"
+#include "renderer/tilemap.h"
+
+#include "test.h"
+
+using namespace platformer2d;
+
+namespace
+{
+	constexpr std::size_t QuadCount = 8192;
+
+	std::vector<FQuadInstance> CreateInstances(const std::size_t Count)
+	{
+		std::mt19937 Engine(1337);
+		std::uniform_real_distribution<float> Position(-20.0f, 20.0f);
+		std::uniform_real_distribution<float> Size(0.10f, 4.0f);
+
+		std::vector<FQuadInstance> Instances;
+		Instances.reserve(Count);
+		for (std::size_t Idx = 0; Idx < Count; Idx++)
+		{
+			Instances.emplace_back(
+				glm::vec3(Position(Engine), Position(Engine), 0.50f),
+				glm::vec2(Size(Engine), Size(Engine)),
+				0.0f,
+				glm::vec4(1.0f),
+				static_cast<uint32_t>(Idx % 8)
+			);
+		}
+
+		return Instances;
+	}
+
+	/* Statistics of one frame, swapped in at the start of the next. */
+	template<typename TFunction>
+	FDrawStatistics RenderFrame(TFunction&& Function)
+	{
+		CRenderer::BeginFrame();
+		CRenderer::SetCameraViewProjection(glm::ortho(-32.0f, 32.0f, -32.0f, 32.0f, -1.0f, 1.0f));
+		Function();
+		CRenderer::EndFrame();
+
+		CRenderer::BeginFrame();
+		const FDrawStatistics Stats = CRenderer::GetDrawStatistics();
+		CRenderer::EndFrame();
+		return Stats;
+	}
+}
+
+TEST_CASE("Null backend", "[renderer]")
+{
+	const FBackendInfo& BackendInfo = CRenderer::GetBackendInfo();
+	REQUIRE(BackendInfo.Backend == ERenderBackend::Null);
+	REQUIRE(BackendInfo.Version.Major == 4);
+	REQUIRE(BackendInfo.Version.Minor == 5);
+	REQUIRE(CRenderer::GetTextures().size() > 0);
+}
+
+TEST_CASE("Batches are built without a context", "[renderer]")
+{
+	const FDrawStatistics Stats = RenderFrame([]()
+	{
+		for (int Idx = 0; Idx < 3; Idx++)
+		{
+			CRenderer::DrawQuad(glm::vec2(Idx, 0.0f), glm::vec2(1.0f), FColor::White);
+		}
+		CRenderer::DrawLine(glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 1.0f), FColor::White);
+		CRenderer::DrawCircleFilled(glm::vec2(0.0f, 0.0f), 1.0f, FColor::White);
+		CRenderer::DrawQuad(glm::vec2(100.0f, 0.0f), glm::vec2(1.0f), FColor::White); /* Culled. */
+	});
+
+	REQUIRE(Stats.QuadCount == 3);
+	REQUIRE(Stats.CircleCount == 1);
+	REQUIRE(Stats.CulledCount == 1);
+	REQUIRE(Stats.LineCount == 1);
+	REQUIRE(Stats.FlushCount == 3);
+	REQUIRE(Stats.DrawCallCount >= Stats.FlushCount);
+	REQUIRE(Stats.IndexCount == (3 * 6) + 2 + 6);
+}
+
+TEST_CASE("Sorted submission without a context", "[renderer]")
+{
+	CRenderer::SetSubmissionMode(ESubmissionMode::Sorted);
+	const std::vector<FQuadInstance> Instances = CreateInstances(QuadCount);
+	const FDrawStatistics Stats = RenderFrame([&Instances]()
+	{
+		CRenderer::DrawQuads(Instances);
+	});
+	CRenderer::SetSubmissionMode(ESubmissionMode::Immediate);
+
+	REQUIRE(Stats.QuadCount == QuadCount);
+	REQUIRE(Stats.RecordCount == QuadCount);
+	REQUIRE(Stats.VertexCount == (QuadCount * 4));
+}
+
+TEST_CASE("Cached render layer", "[renderer]")
+{
+	CRenderer::SetRenderLayerSpecification(ERenderLayer::Background, { .bOffscreen = true, .bCached = true, .CacheThreshold = 8.0f });
+
+	auto DrawBackground = [](const glm::vec2& CameraPos)
+	{
+		return RenderFrame([&CameraPos]()
+		{
+			const glm::mat4 View = glm::translate(glm::mat4(1.0f), glm::vec3(-CameraPos, 0.0f));
+			CRenderer::SetCameraViewProjection(glm::ortho(-32.0f, 32.0f, -32.0f, 32.0f, -1.0f, 1.0f) * View);
+			if (CRenderer::BeginLayer(ERenderLayer::Background))
+			{
+				for (int Idx = 0; Idx < 8; Idx++)
+				{
+					CRenderer::DrawQuad(glm::vec2(Idx, 0.0f), glm::vec2(1.0f), FColor::White);
+				}
+			}
+			CRenderer::EndLayer();
+		});
+	};
+
+	FDrawStatistics Stats = DrawBackground({ 0.0f, 0.0f });
+	REQUIRE(Stats.LayerRedraws == 1);
+	REQUIRE(Stats.LayerCacheHits == 0);
+	REQUIRE(Stats.QuadCount == 8);
+
+	/* Unchanged camera, only the composite is drawn. */
+	Stats = DrawBackground({ 0.0f, 0.0f });
+	REQUIRE(Stats.LayerRedraws == 0);
+	REQUIRE(Stats.LayerCacheHits == 1);
+	REQUIRE(Stats.QuadCount == 0);
+	REQUIRE(Stats.DrawCallCount == 1);
+
+	/* Within the threshold. */
+	Stats = DrawBackground({ 0.01f, 0.0f });
+	REQUIRE(Stats.LayerCacheHits == 1);
+
+	/* Past the threshold. */
+	Stats = DrawBackground({ 10.0f, 0.0f });
+	REQUIRE(Stats.LayerRedraws == 1);
+
+	CRenderer::InvalidateLayer(ERenderLayer::Background);
+	Stats = DrawBackground({ 10.0f, 0.0f });
+	REQUIRE(Stats.LayerRedraws == 1);
+	REQUIRE(Stats.LayerCacheHits == 0);
+
+	CRenderer::SetRenderLayerSpecification(ERenderLayer::Background, {});
+	REQUIRE(CRenderer::GetRenderLayer() == ERenderLayer::World);
+}
+
+TEST_CASE("Tilemap draws visible chunks", "[renderer]")
+{
+	CTilemap Tilemap(1000, 200, { .Texture = ETexture::Bricks, .Columns = 2, .Rows = 2 });
+	Tilemap.Fill(0, 0, Tilemap.GetWidth(), 10, 1);
+	Tilemap.Fill(0, 10, Tilemap.GetWidth(), 1, 4);
+	REQUIRE(Tilemap.GetTile(999, 10) == 4);
+	REQUIRE(Tilemap.GetTile(999, 11) == CTilemap::EMPTY);
+	REQUIRE(Tilemap.WorldToTile({ 500.50f, 5.50f }) == glm::ivec2(500, 5));
+
+	uint32_t Chunks = 0;
+	auto DrawTilemap = [&]()
+	{
+		return RenderFrame([&]()
+		{
+			const glm::mat4 View = glm::translate(glm::mat4(1.0f), glm::vec3(-500.0f, -5.0f, 0.0f));
+			CRenderer::SetCameraViewProjection(glm::ortho(-32.0f, 32.0f, -32.0f, 32.0f, -1.0f, 1.0f) * View);
+			Chunks = Tilemap.Draw();
+		});
+	};
+
+	/* The view is 64 tiles wide, the chunks of the 200k tile map outside of it are never visited. */
+	FDrawStatistics Stats = DrawTilemap();
+	REQUIRE(Chunks <= 3);
+	REQUIRE(Stats.DrawCallCount == Chunks);
+	REQUIRE(Stats.BytesUploaded > 0);
+
+	/* Unchanged chunks are not uploaded again. */
+	Stats = DrawTilemap();
+	REQUIRE(Stats.DrawCallCount == Chunks);
+	REQUIRE(Stats.BytesUploaded == 0);
+
+	Tilemap.SetTile(500, 11, 2);
+	Stats = DrawTilemap();
+	REQUIRE(Stats.BytesUploaded > 0);
+}
+
+TEST_CASE("Textures stream within the upload budget", "[renderer]")
+{
+	auto Texture = std::make_shared<CTexture>(FTextureSpecification{
+		.Path = TEXTURES_DIR "/bricks.png",
+		.Format = EImageFormat::RGBA8,
+		.bAsync = true,
+		.bArrayBacked = true,
+	});
+	REQUIRE(Texture->IsPending());
+	REQUIRE(Texture->GetID() == 0);
+	REQUIRE(Texture->GetWidth() == 512);
+	REQUIRE(Texture->GetHeight() == 512);
+
+	CTextureArray TextureArray({ .ImageFormat = EImageFormat::RGBA8, .Layers = 1, .Width = 1024, .Height = 512 });
+	const FTextureRegion Region = { .Layer = 0, .Offset = { 512, 0 }, .Size = { 512, 512 } };
+	const int Index = TextureArray.AddTexture(Texture, Region);
+	REQUIRE(Index == 0);
+
+	constexpr std::size_t Budget = 64 * 1024;
+	CTextureLoader Loader(Budget, EVertexUploadMode::PersistentMapped, 3);
+	Loader.Load(Texture, &TextureArray, Index);
+	REQUIRE(Loader.GetPendingCount() == 1);
+
+	uint64_t Uploaded = 0;
+	int Frames = 0;
+	while (Texture->IsPending() && (Frames < 10000))
+	{
+		const uint64_t FrameBytes = Loader.Update();
+		REQUIRE(FrameBytes <= Budget);
+		Uploaded += FrameBytes;
+		Loader.EndFrame();
+		Frames++;
+	}
+
+	REQUIRE(!Texture->IsPending());
+	REQUIRE(Loader.GetPendingCount() == 0);
+	REQUIRE(Uploaded == (512 * 512 * 4));
+	REQUIRE(Frames > 1);
+}
+
+TEST_CASE("Textures are packed into shared layers", "[renderer]")
+{
+	/* Sizes of the textures in assets/textures. */
+	const std::vector<glm::uvec2> Sizes = {
+		{ 200, 200 }, { 400, 400 }, { 736, 128 }, { 1024, 1024 },
+		{ 512, 512 }, { 1024, 1024 }, { 128, 32 }, { 747, 323 },
+	};
+	const glm::uvec2 LayerSize(1024, 1024);
+	const std::vector<FTextureRegion> Regions = CTextureArray::Pack(Sizes, LayerSize);
+	REQUIRE(Regions.size() == Sizes.size());
+
+	uint32_t Layers = 0;
+	for (std::size_t Idx = 0; Idx < Regions.size(); Idx++)
+	{
+		const FTextureRegion& Region = Regions[Idx];
+		REQUIRE(Region.Size == Sizes[Idx]);
+		REQUIRE(glm::all(glm::lessThanEqual(Region.Offset + Region.Size, LayerSize)));
+		Layers = std::max(Layers, Region.Layer + 1);
+
+		for (std::size_t Other = 0; Other < Idx; Other++)
+		{
+			const FTextureRegion& Rhs = Regions[Other];
+			const bool bOverlap = (Region.Layer == Rhs.Layer)
+				&& glm::all(glm::lessThan(Region.Offset, Rhs.Offset + Rhs.Size))
+				&& glm::all(glm::lessThan(Rhs.Offset, Region.Offset + Region.Size));
+			REQUIRE(!bOverlap);
+		}
+	}
+
+	/* One layer per texture would take 8. */
+	REQUIRE(Layers == 3);
+}
+
+TEST_CASE("Renderer textures finish loading", "[renderer]")
+{
+	CRenderer::FlushTextureUploads();
+	const FDrawStatistics Stats = RenderFrame([]() {});
+	REQUIRE(Stats.TexturesPending == 0);
+	for (const auto& [Texture, TextureRef] : CRenderer::GetTextures())
+	{
+		REQUIRE(!TextureRef->IsPending());
+	}
+}
+
+TEST_CASE("Cooked texture is mapped", "[renderer]")
+{
+	const std::filesystem::path Path = std::filesystem::temp_directory_path() / ("headless-test.png" + std::string(CookedTexture::EXTENSION));
+	constexpr uint32_t Size = 4;
+	const FCookedTextureHeader Header = {
+		.Magic = CookedTexture::MAGIC,
+		.Version = CookedTexture::VERSION,
+		.Format = ECookedTextureFormat::RGBA8,
+		.Width = Size,
+		.Height = Size,
+		.MipCount = 1,
+		.Flags = CookedTexture_Translucent | CookedTexture_FlipVertical,
+		.SourceHash = CookedTexture::Hash({}),
+	};
+	const FCookedTextureMip Mip = { .Offset = 64, .Size = Size * Size * 4, .Width = Size, .Height = Size };
+	const std::vector<char> Pixels(Mip.Size, static_cast<char>(0x80));
+	{
+		std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+		File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+		File.write(reinterpret_cast<const char*>(&Mip), sizeof(Mip));
+		File.write(std::string(Mip.Offset - sizeof(Header) - sizeof(Mip), '\0').data(), Mip.Offset - sizeof(Header) - sizeof(Mip));
+		File.write(Pixels.data(), Pixels.size());
+	}
+
+	{
+		CCookedTexture Cooked;
+		REQUIRE(Cooked.Open(Path));
+		REQUIRE(Cooked.GetHeader().Width == Size);
+		REQUIRE(Cooked.HasFlag(CookedTexture_Translucent));
+		REQUIRE(Cooked.GetMipData(0).size() == Mip.Size);
+		REQUIRE(std::to_integer<uint8_t>(Cooked.GetMipData(0)[0]) == 0x80);
+	}
+
+	const CTexture Texture({ .Path = Path.string(), .Format = EImageFormat::RGBA8 });
+	REQUIRE(Texture.GetWidth() == Size);
+	REQUIRE(Texture.GetHeight() == Size);
+	REQUIRE(Texture.IsTranslucent());
+	REQUIRE(!Texture.IsPending());
+
+	/* An array backed texture keeps the mapping until mip 0 is uploaded to its region. */
+	auto ArrayTexture = std::make_shared<CTexture>(FTextureSpecification{
+		.Path = Path.string(),
+		.Format = EImageFormat::RGBA8,
+		.bArrayBacked = true,
+	});
+	REQUIRE(ArrayTexture->GetID() == 0);
+	REQUIRE(ArrayTexture->GetMips() == 1);
+	CTextureArray TextureArray({ .ImageFormat = EImageFormat::RGBA8, .Layers = 1, .Width = Size, .Height = Size });
+	REQUIRE(TextureArray.AddTexture(ArrayTexture, { .Layer = 0, .Size = { Size, Size } }) == 0);
+
+	/* A truncated file is rejected instead of read out of bounds. */
+	std::filesystem::resize_file(Path, Mip.Offset + 8);
+	CCookedTexture Truncated;
+	REQUIRE(!Truncated.Open(Path));
+	std::filesystem::remove(Path);
+}
+
+TEST_CASE("Program binary cache", "[renderer]")
+{
+	REQUIRE(CShaderCache::IsEnabled());
+	const CShader Compiled(SHADERS_DIR "/quad.shader");
+	const FShaderCacheStatistics Before = CShaderCache::GetStatistics();
+	const CShader Cached(SHADERS_DIR "/quad.shader");
+	REQUIRE(Cached.IsBinaryCached());
+	REQUIRE(CShaderCache::GetStatistics().Hits == (Before.Hits + 1));
+
+	/* A truncated binary is rejected, compiled from source and stored again. */
+	FShaderProgramSource Source{};
+	Source.Vertex = "#version 450 core\nvoid main() {}\n";
+	Source.Fragment = "#version 450 core\nvoid main() {}\n";
+	const std::filesystem::path Path = CShaderCache::GetPath(CShaderCache::GetKey(Source));
+	{
+		std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+		File.write("LKSC", 4);
+	}
+
+	const std::filesystem::path ShaderPath = std::filesystem::temp_directory_path() / "headless-test.shader";
+	{
+		std::ofstream File(ShaderPath, std::ios::trunc);
+		File << "#lk_shader vertex\n" << Source.Vertex << "#lk_shader fragment\n" << Source.Fragment;
+	}
+
+	const CShader Recompiled(ShaderPath);
+	REQUIRE(!Recompiled.IsBinaryCached());
+	REQUIRE(CShaderCache::GetStatistics().Rejected == (Before.Rejected + 1));
+	REQUIRE(std::filesystem::file_size(Path) > 4);
+
+	const CShader Reloaded(ShaderPath);
+	REQUIRE(Reloaded.IsBinaryCached());
+
+	/* A header claiming more bytes than the file holds is rejected before the binary is read. */
+	{
+		const uint32_t Header[6] = {
+			0x43534B4C, 1, /* Magic, version. */
+			static_cast<uint32_t>(CShaderCache::GetKey(Source)), static_cast<uint32_t>(CShaderCache::GetKey(Source) >> 32),
+			0, 0xFFFFFFFF  /* Binary format, binary length. */
+		};
+		std::ofstream File(Path, std::ios::binary | std::ios::trunc);
+		File.write(reinterpret_cast<const char*>(Header), sizeof(Header));
+		File.write("binary", 6);
+	}
+	const CShader Oversized(ShaderPath);
+	REQUIRE(!Oversized.IsBinaryCached());
+	REQUIRE(CShaderCache::GetStatistics().Rejected == (Before.Rejected + 2));
+
+	std::filesystem::remove(ShaderPath);
+	std::filesystem::remove(Path);
+}
+
+TEST_CASE("Uniform handles are resolved once", "[renderer]")
+{
+	static constexpr FUniformName Color("u_color");
+	static_assert(Color.Id == Hash::FNV1a("u_color"));
+	static_assert(FUniformName("u_color").Id != FUniformName("u_colour").Id);
+
+	/* The null backend reflects nothing, names resolve through the driver query instead. */
+	CShader Shader(SHADERS_DIR "/debug_quad.shader");
+	const std::size_t Reflected = Shader.GetUniforms().size();
+	const FUniformHandle Handle = Shader.GetUniform(Color);
+	REQUIRE(Handle.IsValid());
+	REQUIRE(Shader.GetUniforms().size() == (Reflected + 1));
+	REQUIRE(Shader.GetUniform(std::string("u_color")).Location == Handle.Location);
+	REQUIRE(Shader.GetUniforms().size() == (Reflected + 1));
+	Shader.Set(Handle, glm::vec4(1.0f));
+}
+
+TEST_CASE("Headless frame throughput", "[renderer][!benchmark]")
+{
+	const std::vector<FQuadInstance> Instances = CreateInstances(QuadCount);
+
+	BENCHMARK("Immediate")
+	{
+		return RenderFrame([&Instances]() { CRenderer::DrawQuads(Instances); }).QuadCount;
+	};
+
+	BENCHMARK("Sorted")
+	{
+		CRenderer::SetSubmissionMode(ESubmissionMode::Sorted);
+		const uint64_t Quads = RenderFrame([&Instances]() { CRenderer::DrawQuads(Instances); }).QuadCount;
+		CRenderer::SetSubmissionMode(ESubmissionMode::Immediate);
+		return Quads;
+	};
+}
@@ -0,0 +1,29 @@
+#include "test.h"
+
+#include <spdlog/spdlog.h>
+
+#include "core/assert.h"
+#include "core/window.h"
+
+namespace platformer2d::test {
+
+	CTest::CTest(const int Argc, char* Argv[])
+		: CTestBase(Argc, Argv)
+	{
+	}
+
+	void CTest::Run()
+	{
+		/* Recording only writes to CPU memory, the renderer is not initialized. */
+		bRunning = true;
+		const int CatchResult = Catch::Session().run(Args.Argc, Args.Argv);
+		LK_DEBUG("Catch result: {}", CatchResult);
+		bRunning = false;
+	}
+
+	void CTest::Destroy()
+	{
+		LK_DEBUG_TAG("Test", "Destroy");
+	}
+
+}
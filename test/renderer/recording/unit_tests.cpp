@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "core/core.h"
+#include "renderer/drawrecorder.h"
+#include "renderer/renderer.h"
+
+#include "test.h"
+
+using namespace platformer2d;
+
+namespace
+{
+	constexpr uint32_t JobCount = 8;
+	constexpr uint32_t DrawsPerJob = 256;
+
+	/* Deterministic draws that depend only on the job index. */
+	void RecordJob(const uint32_t Job)
+	{
+		std::mt19937 Engine(Job);
+		std::uniform_real_distribution<float> Position(-10.0f, 10.0f);
+		std::uniform_real_distribution<float> Unit(0.0f, 1.0f);
+
+		for (uint32_t Idx = 0; Idx < DrawsPerJob; Idx++)
+		{
+			CRenderer::SetRenderLayer(static_cast<ERenderLayer>(Idx % static_cast<uint32_t>(ERenderLayer::COUNT)));
+			const glm::vec4 Color(Unit(Engine), Unit(Engine), Unit(Engine), (Idx % 2) ? 1.0f : 0.50f);
+			const glm::vec2 Pos(Position(Engine), Position(Engine));
+
+			switch (Idx % 3)
+			{
+				case 0: CRenderer::DrawQuad(Pos, { 1.0f, 2.0f }, Color, Unit(Engine) * 360.0f); break;
+				case 1: CRenderer::DrawLine(Pos, Pos + glm::vec2(1.0f, 0.0f), Color); break;
+				case 2: CRenderer::DrawCircleFilled(Pos, Unit(Engine), Color); break;
+			}
+		}
+	}
+
+	/* Flatten the sorted list to the byte stream that would be copied to the batches. */
+	std::vector<uint8_t> BuildStream(CDrawList& DrawList)
+	{
+		DrawList.Sort();
+
+		std::vector<uint8_t> Stream;
+		auto Append = [&Stream](const void* Data, const std::size_t Size)
+		{
+			const uint8_t* Bytes = static_cast<const uint8_t*>(Data);
+			Stream.insert(Stream.end(), Bytes, Bytes + Size);
+		};
+
+		for (const FDrawRecord& Record : DrawList.GetRecords())
+		{
+			switch (Record.Type)
+			{
+				case CShader::EType::Quad:   Append(DrawList.GetQuadInstance(Record), sizeof(FQuadInstance));       break;
+				case CShader::EType::Line:   Append(DrawList.GetLineVertices(Record), 2 * sizeof(FLineVertex));     break;
+				case CShader::EType::Circle: Append(DrawList.GetCircleVertices(Record), 4 * sizeof(FCircleVertex)); break;
+			}
+		}
+
+		return Stream;
+	}
+}
+
+TEST_CASE("Parallel recording matches serial recording", "[renderer]")
+{
+	CDrawRecorder Recorder;
+
+	CDrawList Serial;
+	for (uint32_t Job = 0; Job < JobCount; Job++)
+	{
+		Recorder.Begin(Job);
+		RecordJob(Job);
+		Recorder.End();
+	}
+	const FRecordCounts SerialCounts = Recorder.Merge(Serial);
+
+	/* Start the jobs in reverse to make the finishing order differ from the merge order. */
+	CDrawList Parallel;
+	std::vector<std::thread> Workers;
+	for (uint32_t Job = JobCount; Job-- > 0;)
+	{
+		Workers.emplace_back([&Recorder, Job]()
+		{
+			Recorder.Begin(Job);
+			RecordJob(Job);
+			Recorder.End();
+		});
+	}
+	std::ranges::for_each(Workers, [](std::thread& Worker) { Worker.join(); });
+	const FRecordCounts ParallelCounts = Recorder.Merge(Parallel);
+
+	REQUIRE(Serial.GetSize() == (JobCount * DrawsPerJob));
+	REQUIRE(Parallel.GetSize() == Serial.GetSize());
+	REQUIRE(ParallelCounts.Quads == SerialCounts.Quads);
+	REQUIRE(ParallelCounts.Lines == SerialCounts.Lines);
+
+	const std::vector<uint8_t> SerialStream = BuildStream(Serial);
+	const std::vector<uint8_t> ParallelStream = BuildStream(Parallel);
+	REQUIRE(SerialStream.size() == ParallelStream.size());
+	REQUIRE(std::memcmp(SerialStream.data(), ParallelStream.data(), SerialStream.size()) == 0);
+}
+
+TEST_CASE("Recording leaves the calling thread unbound", "[renderer]")
+{
+	CDrawRecorder Recorder;
+	REQUIRE(CDrawRecorder::GetThreadContext() == nullptr);
+
+	Recorder.Begin(0);
+	REQUIRE(CDrawRecorder::GetThreadContext() != nullptr);
+	CRenderer::SetRenderLayer(ERenderLayer::Overlay);
+	REQUIRE(CRenderer::GetRenderLayer() == ERenderLayer::Overlay);
+	Recorder.End();
+
+	REQUIRE(CDrawRecorder::GetThreadContext() == nullptr);
+	REQUIRE(CRenderer::GetRenderLayer() == ERenderLayer::World);
+
+	CDrawList DrawList;
+	Recorder.Merge(DrawList);
+	REQUIRE(DrawList.IsEmpty());
+}
@@ -0,0 +1,43 @@
+#include "test.h"
+
+#include <spdlog/spdlog.h>
+
+#include "core/assert.h"
+#include "core/window.h"
+#include "renderer/renderer.h"
+
+namespace platformer2d::test {
+
+	namespace
+	{
+		constexpr bool NO_TEST_INIT = false;
+	}
+
+	CTest::CTest(const int Argc, char* Argv[])
+		: CTestBase(Argc, Argv, NO_TEST_INIT)
+	{
+		/* Headless like the headless suite, with the command queue executed on a render thread. */
+		CLog::Initialize();
+		LK_INFO("{}", LK_TEST_NAME);
+		Window = std::make_unique<CWindow>(SCREEN_WIDTH, SCREEN_HEIGHT, LK_TEST_NAME);
+		Window->Initialize(true);
+
+		CRenderer::Initialize({ .Backend = ERenderBackend::Null, .QuadRenderPath = EQuadRenderPath::Batched, .bRenderThread = true });
+	}
+
+	void CTest::Run()
+	{
+		bRunning = true;
+		const int CatchResult = Catch::Session().run(Args.Argc, Args.Argv);
+		LK_DEBUG("Catch result: {}", CatchResult);
+		bRunning = false;
+	}
+
+	void CTest::Destroy()
+	{
+		LK_DEBUG_TAG("Test", "Destroy");
+		CRenderer::Destroy();
+		Window->Destroy();
+	}
+
+}
@@ -0,0 +1,251 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "core/core.h"
+#include "renderer/rendercommandqueue.h"
+#include "renderer/renderer.h"
+#include "renderer/staticbatch.h"
+
+#include "test.h"
+
+using namespace platformer2d;
+
+namespace
+{
+	constexpr std::size_t QuadCount = 8192;
+
+	std::vector<FQuadInstance> CreateInstances(const std::size_t Count)
+	{
+		std::mt19937 Engine(1337);
+		std::uniform_real_distribution<float> Position(-20.0f, 20.0f);
+		std::uniform_real_distribution<float> Size(0.10f, 4.0f);
+
+		std::vector<FQuadInstance> Instances;
+		Instances.reserve(Count);
+		for (std::size_t Idx = 0; Idx < Count; Idx++)
+		{
+			Instances.emplace_back(
+				glm::vec3(Position(Engine), Position(Engine), 0.50f),
+				glm::vec2(Size(Engine), Size(Engine)),
+				0.0f,
+				glm::vec4(1.0f),
+				static_cast<uint32_t>(Idx % 8)
+			);
+		}
+
+		return Instances;
+	}
+
+	/**
+	 * Statistics of one frame. The render thread executes a frame while the next one is
+	 * recorded, so they are complete once the frame after it has ended.
+	 */
+	template<typename TFunction>
+	FDrawStatistics RenderFrame(TFunction&& Function)
+	{
+		CRenderer::BeginFrame();
+		CRenderer::SetCameraViewProjection(glm::ortho(-32.0f, 32.0f, -32.0f, 32.0f, -1.0f, 1.0f));
+		Function();
+		CRenderer::EndFrame();
+
+		CRenderer::BeginFrame();
+		CRenderer::EndFrame();
+
+		CRenderer::BeginFrame();
+		const FDrawStatistics Stats = CRenderer::GetDrawStatistics();
+		CRenderer::EndFrame();
+		return Stats;
+	}
+}
+
+TEST_CASE("Render thread is running", "[renderer]")
+{
+	REQUIRE(CRenderer::HasRenderThread());
+}
+
+TEST_CASE("Batches are built on the render thread", "[renderer]")
+{
+	const FDrawStatistics Stats = RenderFrame([]()
+	{
+		for (int Idx = 0; Idx < 3; Idx++)
+		{
+			CRenderer::DrawQuad(glm::vec2(Idx, 0.0f), glm::vec2(1.0f), FColor::White);
+		}
+		CRenderer::DrawLine(glm::vec2(0.0f, 0.0f), glm::vec2(1.0f, 1.0f), FColor::White);
+		CRenderer::DrawCircleFilled(glm::vec2(0.0f, 0.0f), 1.0f, FColor::White);
+		CRenderer::DrawQuad(glm::vec2(100.0f, 0.0f), glm::vec2(1.0f), FColor::White); /* Culled. */
+	});
+
+	REQUIRE(Stats.QuadCount == 3);
+	REQUIRE(Stats.CircleCount == 1);
+	REQUIRE(Stats.CulledCount == 1);
+	REQUIRE(Stats.LineCount == 1);
+	REQUIRE(Stats.FlushCount == 3);
+	REQUIRE(Stats.IndexCount == (3 * 6) + 2 + 6);
+	REQUIRE(Stats.RenderThreadTimeMs > 0.0f);
+}
+
+TEST_CASE("Sorted submission on the render thread", "[renderer]")
+{
+	CRenderer::SetSubmissionMode(ESubmissionMode::Sorted);
+	const std::vector<FQuadInstance> Instances = CreateInstances(QuadCount);
+	const FDrawStatistics Stats = RenderFrame([&Instances]()
+	{
+		CRenderer::DrawQuads(Instances);
+	});
+	CRenderer::SetSubmissionMode(ESubmissionMode::Immediate);
+
+	REQUIRE(Stats.QuadCount == QuadCount);
+	REQUIRE(Stats.RecordCount == QuadCount);
+	REQUIRE(Stats.VertexCount == (QuadCount * 4));
+}
+
+TEST_CASE("Immediate submission is recorded in order", "[renderer]")
+{
+	const std::vector<FQuadInstance> Instances = CreateInstances(QuadCount);
+	const FDrawStatistics Stats = RenderFrame([&Instances]()
+	{
+		CRenderer::DrawQuads(Instances);
+	});
+
+	REQUIRE(Stats.QuadCount == QuadCount);
+	REQUIRE(Stats.RecordCount == QuadCount);
+	REQUIRE(Stats.GetBatchBreaks(EBatchBreak::TypeChange) == 0);
+}
+
+TEST_CASE("Static batch is uploaded by the render thread", "[renderer]")
+{
+	const std::vector<FQuadInstance> Instances = CreateInstances(64);
+	auto Batch = std::make_unique<CStaticBatch>();
+	for (const FQuadInstance& Instance : Instances)
+	{
+		Batch->AddQuad(Instance);
+	}
+
+	FDrawStatistics Stats = RenderFrame([&Batch]() { CRenderer::DrawStaticBatch(*Batch); });
+	REQUIRE(Stats.BytesUploaded > 0);
+	REQUIRE(Stats.DrawCallCount == 1);
+
+	Stats = RenderFrame([&Batch]() { CRenderer::DrawStaticBatch(*Batch); });
+	REQUIRE(Stats.BytesUploaded == 0);
+
+	/* Drawn in the frame it is released in, the buffers are deleted after the draw. */
+	Stats = RenderFrame([&Batch]()
+	{
+		CRenderer::DrawStaticBatch(*Batch);
+		Batch.reset();
+	});
+	REQUIRE(Stats.DrawCallCount == 1);
+}
+
+TEST_CASE("Cached render layer on the render thread", "[renderer]")
+{
+	CRenderer::SetRenderLayerSpecification(ERenderLayer::Background, { .bOffscreen = true, .bCached = true, .CacheThreshold = 8.0f });
+
+	auto DrawBackground = []()
+	{
+		return RenderFrame([]()
+		{
+			if (CRenderer::BeginLayer(ERenderLayer::Background))
+			{
+				for (int Idx = 0; Idx < 8; Idx++)
+				{
+					CRenderer::DrawQuad(glm::vec2(Idx, 0.0f), glm::vec2(1.0f), FColor::White);
+				}
+			}
+			CRenderer::EndLayer();
+		});
+	};
+
+	FDrawStatistics Stats = DrawBackground();
+	REQUIRE(Stats.LayerRedraws == 1);
+	REQUIRE(Stats.QuadCount == 8);
+
+	Stats = DrawBackground();
+	REQUIRE(Stats.LayerCacheHits == 1);
+	REQUIRE(Stats.DrawCallCount == 1);
+
+	CRenderer::SetRenderLayerSpecification(ERenderLayer::Background, {});
+}
+
+TEST_CASE("Texture uploads are flushed on the render thread", "[renderer]")
+{
+	CRenderer::FlushTextureUploads();
+	const FDrawStatistics Stats = RenderFrame([]() {});
+	REQUIRE(Stats.TexturesPending == 0);
+	for (const auto& [Texture, TextureRef] : CRenderer::GetTextures())
+	{
+		REQUIRE(!TextureRef->IsPending());
+	}
+}
+
+TEST_CASE("Command queue pages are recycled", "[renderer]")
+{
+	static std::vector<uint32_t> Executed;
+	constexpr std::size_t PageSize = 1024;
+	CRenderCommandQueue Queue(PageSize);
+	auto Record = [&Queue](const uint32_t Count)
+	{
+		for (uint32_t Idx = 0; Idx < Count; Idx++)
+		{
+			*static_cast<uint32_t*>(Queue.Allocate([](void* Payload) { Executed.push_back(*static_cast<uint32_t*>(Payload)); }, sizeof(uint32_t))) = Idx;
+		}
+	};
+
+	Record(1000);
+	const FRenderCommandQueueStatistics Grown = Queue.GetStatistics();
+	REQUIRE(Grown.CommandCount == 1000);
+	REQUIRE(Grown.PageCount > 1);
+	REQUIRE(Grown.BytesReserved >= Grown.BytesUsed);
+	Queue.Execute();
+	REQUIRE(Executed.size() == 1000);
+	for (uint32_t Idx = 0; Idx < Executed.size(); Idx++)
+	{
+		REQUIRE(Executed[Idx] == Idx);
+	}
+	REQUIRE(Queue.IsEmpty());
+
+	/* A payload larger than a page gets a page of its own, aligned as requested. */
+	void* Large = Queue.Allocate([](void*) {}, 4 * PageSize, 64);
+	REQUIRE((reinterpret_cast<std::uintptr_t>(Large) % 64) == 0);
+	Queue.Execute();
+	REQUIRE(Queue.GetStatistics().HighWater > (4 * PageSize));
+
+	/* Smaller frames reuse the pages, the unused ones are released after the shrink interval. */
+	for (uint32_t Frame = 0; Frame < (2 * CRenderCommandQueue::SHRINK_INTERVAL); Frame++)
+	{
+		Record(4);
+		Queue.Execute();
+	}
+	REQUIRE(Queue.GetStatistics().PageCount <= 2);
+	REQUIRE(Queue.GetStatistics().PagesReleased > 0);
+	REQUIRE(Queue.GetStatistics().BytesReserved <= (2 * PageSize));
+	Executed.clear();
+}
+
+TEST_CASE("Command queue closures are destroyed", "[renderer]")
+{
+	auto Shared = std::make_shared<int>(2);
+	int Sum = 0;
+	{
+		CRenderCommandQueue Queue;
+		for (int Idx = 0; Idx < 100; Idx++)
+		{
+			Queue.Submit([Shared, &Sum, Idx]() { Sum += *Shared + Idx; });
+		}
+		REQUIRE(Shared.use_count() == 101);
+
+		Queue.Execute();
+		REQUIRE(Sum == (2 * 100) + 4950);
+		REQUIRE(Shared.use_count() == 1);
+
+		/* Released with the queue without being executed. */
+		Queue.Submit([Shared]() { FAIL("Executed by the destructor"); });
+		REQUIRE(Shared.use_count() == 2);
+	}
+	REQUIRE(Shared.use_count() == 1);
+}
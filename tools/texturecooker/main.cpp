@@ -0,0 +1,92 @@
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include "core/core.h"
+#include "texturecooker.h"
+
+using namespace platformer2d;
+
+namespace
+{
+	void PrintUsage()
+	{
+		LK_PRINTLN("Usage: texturecooker [options] <image>...");
+		LK_PRINTLN("  --output <dir>          Output directory (default: {})", COOKED_TEXTURES_DIR);
+		LK_PRINTLN("  --format <rgba8|bc1|bc3> Pixel format (default: rgba8)");
+		LK_PRINTLN("  --no-mips               Only cook the base level");
+		LK_PRINTLN("  --no-flip               Keep the rows top to bottom");
+		LK_PRINTLN("  --force                 Cook even if the source is unchanged");
+	}
+}
+
+int main(int Argc, char* Argv[])
+{
+	CLog::Initialize("texturecooker");
+
+	FCookOptions Options;
+	std::filesystem::path OutputDir = COOKED_TEXTURES_DIR;
+	std::vector<std::filesystem::path> Sources;
+	for (int Idx = 1; Idx < Argc; Idx++)
+	{
+		const std::string_view Arg = Argv[Idx];
+		if ((Arg == "--output") && ((Idx + 1) < Argc))
+		{
+			OutputDir = Argv[++Idx];
+		}
+		else if ((Arg == "--format") && ((Idx + 1) < Argc))
+		{
+			const std::string_view Format = Argv[++Idx];
+			if (Format == "rgba8")    Options.Format = ECookedTextureFormat::RGBA8;
+			else if (Format == "bc1") Options.Format = ECookedTextureFormat::BC1;
+			else if (Format == "bc3") Options.Format = ECookedTextureFormat::BC3;
+			else
+			{
+				LK_ERROR("Unknown format: {}", Format);
+				return 1;
+			}
+		}
+		else if (Arg == "--no-mips")
+		{
+			Options.bMips = false;
+		}
+		else if (Arg == "--no-flip")
+		{
+			Options.bFlipVertical = false;
+		}
+		else if (Arg == "--force")
+		{
+			Options.bForce = true;
+		}
+		else if (Arg.starts_with("--"))
+		{
+			PrintUsage();
+			return 1;
+		}
+		else
+		{
+			Sources.emplace_back(Arg);
+		}
+	}
+
+	if (Sources.empty())
+	{
+		PrintUsage();
+		return 1;
+	}
+
+	int Cooked = 0;
+	int Failed = 0;
+	for (const std::filesystem::path& Source : Sources)
+	{
+		switch (CTextureCooker::Cook(Source, OutputDir, Options))
+		{
+			case ECookResult::Cooked:   Cooked++; break;
+			case ECookResult::UpToDate: break;
+			case ECookResult::Failed:   Failed++; break;
+		}
+	}
+
+	LK_INFO("Cooked {} of {} textures ({} failed)", Cooked, Sources.size(), Failed);
+	return (Failed > 0) ? 1 : 0;
+}
@@ -0,0 +1,379 @@
+#include "texturecooker.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+
+#include <stb/stb_image.h>
+#include <stb/stb_image_resize2.h>
+
+#include "core/mappedfile.h"
+
+namespace platformer2d {
+
+	namespace
+	{
+		constexpr uint32_t BytesPerPixel = 4;
+
+		struct FMipLevel
+		{
+			std::vector<uint8_t> Data;
+			uint32_t Width = 0;
+			uint32_t Height = 0;
+		};
+
+		/* 4x4 block of RGBA8 texels, repeating the edge of the image. */
+		void FetchBlock(const std::span<const uint8_t> Pixels, const uint32_t Width, const uint32_t Height,
+						const uint32_t BlockX, const uint32_t BlockY, uint8_t (&Block)[16 * BytesPerPixel])
+		{
+			for (uint32_t Y = 0; Y < 4; Y++)
+			{
+				const uint32_t SourceY = std::min(BlockY * 4 + Y, Height - 1);
+				for (uint32_t X = 0; X < 4; X++)
+				{
+					const uint32_t SourceX = std::min(BlockX * 4 + X, Width - 1);
+					const std::size_t Source = (static_cast<std::size_t>(SourceY) * Width + SourceX) * BytesPerPixel;
+					std::memcpy(&Block[(Y * 4 + X) * BytesPerPixel], &Pixels[Source], BytesPerPixel);
+				}
+			}
+		}
+
+		uint16_t ToRGB565(const uint8_t R, const uint8_t G, const uint8_t B)
+		{
+			return static_cast<uint16_t>((((R * 31 + 127) / 255) << 11) | (((G * 63 + 127) / 255) << 5) | ((B * 31 + 127) / 255));
+		}
+
+		void FromRGB565(const uint16_t Color, int (&Out)[3])
+		{
+			const int R = (Color >> 11) & 0x1F;
+			const int G = (Color >> 5) & 0x3F;
+			const int B = Color & 0x1F;
+			Out[0] = (R << 3) | (R >> 2);
+			Out[1] = (G << 2) | (G >> 4);
+			Out[2] = (B << 3) | (B >> 2);
+		}
+
+		void WriteLE(uint8_t* Out, const uint64_t Value, const int Bytes)
+		{
+			for (int Idx = 0; Idx < Bytes; Idx++)
+			{
+				Out[Idx] = static_cast<uint8_t>(Value >> (Idx * 8));
+			}
+		}
+
+		/**
+		 * Color endpoints from the inset bounding box of the block.
+		 * Always the four color mode (Color0 > Color1), which BC3 assumes regardless of the order.
+		 */
+		void EncodeColorBlock(const uint8_t (&Block)[16 * BytesPerPixel], uint8_t* Out)
+		{
+			int Min[3] = { 255, 255, 255 };
+			int Max[3] = { 0, 0, 0 };
+			for (int Texel = 0; Texel < 16; Texel++)
+			{
+				for (int Channel = 0; Channel < 3; Channel++)
+				{
+					Min[Channel] = std::min<int>(Min[Channel], Block[Texel * BytesPerPixel + Channel]);
+					Max[Channel] = std::max<int>(Max[Channel], Block[Texel * BytesPerPixel + Channel]);
+				}
+			}
+
+			/* Pull the endpoints in to reduce the error of the interpolated colors. */
+			for (int Channel = 0; Channel < 3; Channel++)
+			{
+				const int Inset = (Max[Channel] - Min[Channel]) / 16;
+				Min[Channel] = std::min(Min[Channel] + Inset, 255);
+				Max[Channel] = std::max(Max[Channel] - Inset, 0);
+			}
+
+			uint16_t Color0 = ToRGB565(Max[0], Max[1], Max[2]);
+			uint16_t Color1 = ToRGB565(Min[0], Min[1], Min[2]);
+			if (Color0 < Color1)
+			{
+				std::swap(Color0, Color1);
+			}
+
+			uint32_t Indices = 0;
+			if (Color0 != Color1)
+			{
+				int Palette[4][3];
+				FromRGB565(Color0, Palette[0]);
+				FromRGB565(Color1, Palette[1]);
+				for (int Channel = 0; Channel < 3; Channel++)
+				{
+					Palette[2][Channel] = (2 * Palette[0][Channel] + Palette[1][Channel]) / 3;
+					Palette[3][Channel] = (Palette[0][Channel] + 2 * Palette[1][Channel]) / 3;
+				}
+
+				for (int Texel = 0; Texel < 16; Texel++)
+				{
+					int BestIndex = 0;
+					int BestDistance = std::numeric_limits<int>::max();
+					for (int Index = 0; Index < 4; Index++)
+					{
+						int Distance = 0;
+						for (int Channel = 0; Channel < 3; Channel++)
+						{
+							const int Delta = Block[Texel * BytesPerPixel + Channel] - Palette[Index][Channel];
+							Distance += Delta * Delta;
+						}
+						if (Distance < BestDistance)
+						{
+							BestDistance = Distance;
+							BestIndex = Index;
+						}
+					}
+					Indices |= static_cast<uint32_t>(BestIndex) << (Texel * 2);
+				}
+			}
+
+			WriteLE(Out + 0, Color0, 2);
+			WriteLE(Out + 2, Color1, 2);
+			WriteLE(Out + 4, Indices, 4);
+		}
+
+		/* Eight interpolated alpha values between the block minimum and maximum. */
+		void EncodeAlphaBlock(const uint8_t (&Block)[16 * BytesPerPixel], uint8_t* Out)
+		{
+			int Min = 255;
+			int Max = 0;
+			for (int Texel = 0; Texel < 16; Texel++)
+			{
+				Min = std::min<int>(Min, Block[Texel * BytesPerPixel + 3]);
+				Max = std::max<int>(Max, Block[Texel * BytesPerPixel + 3]);
+			}
+
+			uint64_t Indices = 0;
+			if (Max != Min)
+			{
+				int Palette[8] = { Max, Min };
+				for (int Index = 1; Index < 7; Index++)
+				{
+					Palette[Index + 1] = ((7 - Index) * Max + Index * Min) / 7;
+				}
+
+				for (int Texel = 0; Texel < 16; Texel++)
+				{
+					const int Alpha = Block[Texel * BytesPerPixel + 3];
+					int BestIndex = 0;
+					for (int Index = 1; Index < 8; Index++)
+					{
+						if (std::abs(Alpha - Palette[Index]) < std::abs(Alpha - Palette[BestIndex]))
+						{
+							BestIndex = Index;
+						}
+					}
+					Indices |= static_cast<uint64_t>(BestIndex) << (Texel * 3);
+				}
+			}
+
+			Out[0] = static_cast<uint8_t>(Max);
+			Out[1] = static_cast<uint8_t>(Min);
+			WriteLE(Out + 2, Indices, 6);
+		}
+
+		std::vector<FMipLevel> GenerateMips(std::vector<uint8_t>&& Pixels, const uint32_t Width, const uint32_t Height, const bool bMips)
+		{
+			std::vector<FMipLevel> Levels;
+			Levels.push_back({ std::move(Pixels), Width, Height });
+			while (bMips && ((Levels.back().Width > 1) || (Levels.back().Height > 1)))
+			{
+				const FMipLevel& Previous = Levels.back();
+				FMipLevel Level;
+				Level.Width = std::max(1u, Previous.Width / 2);
+				Level.Height = std::max(1u, Previous.Height / 2);
+				Level.Data.resize(static_cast<std::size_t>(Level.Width) * Level.Height * BytesPerPixel);
+				stbir_resize_uint8_linear(Previous.Data.data(), Previous.Width, Previous.Height, 0,
+										  Level.Data.data(), Level.Width, Level.Height, 0, STBIR_RGBA);
+				Levels.push_back(std::move(Level));
+			}
+
+			return Levels;
+		}
+
+		bool IsUpToDate(const std::filesystem::path& Output, const uint64_t SourceHash, const FCookOptions& Options)
+		{
+			CCookedTexture Cooked;
+			if (!std::filesystem::exists(Output) || !Cooked.Open(Output))
+			{
+				return false;
+			}
+
+			/* Translucent sources requested as BC1 are cooked as BC3. */
+			const FCookedTextureHeader& Header = Cooked.GetHeader();
+			const bool bFormat = (Header.Format == Options.Format)
+				|| ((Options.Format == ECookedTextureFormat::BC1) && (Header.Format == ECookedTextureFormat::BC3)
+					&& Cooked.HasFlag(CookedTexture_Translucent));
+			return (Header.SourceHash == SourceHash)
+				&& bFormat
+				&& (Cooked.HasFlag(CookedTexture_FlipVertical) == Options.bFlipVertical)
+				&& ((Header.MipCount > 1) == Options.bMips);
+		}
+	}
+
+	ECookResult CTextureCooker::Cook(const std::filesystem::path& Source, const std::filesystem::path& OutputDir, const FCookOptions& Options)
+	{
+		CMappedFile SourceFile;
+		if (!SourceFile.Open(Source))
+		{
+			LK_ERROR_TAG("TextureCooker", "Failed to open {}", Source);
+			return ECookResult::Failed;
+		}
+
+		const std::filesystem::path Output = OutputDir / (Source.filename().string() + CookedTexture::EXTENSION);
+		const uint64_t SourceHash = CookedTexture::Hash(SourceFile.GetSpan());
+		if (!Options.bForce && IsUpToDate(Output, SourceHash, Options))
+		{
+			LK_DEBUG_TAG("TextureCooker", "Up to date: {}", Source.filename());
+
+			/* The source was touched without changing, keep the cooked file newer so the runtime does not skip it. */
+			std::error_code Error;
+			std::filesystem::last_write_time(Output, std::filesystem::file_time_type::clock::now(), Error);
+			return ECookResult::UpToDate;
+		}
+
+		stbi_set_flip_vertically_on_load(Options.bFlipVertical);
+		int Width, Height, Channels;
+		uint8_t* Decoded = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(SourceFile.GetData()),
+												 static_cast<int>(SourceFile.GetSize()), &Width, &Height, &Channels, BytesPerPixel);
+		if (!Decoded)
+		{
+			LK_ERROR_TAG("TextureCooker", "Failed to decode {}: {}", Source, stbi_failure_reason());
+			return ECookResult::Failed;
+		}
+
+		const std::size_t ImageSize = static_cast<std::size_t>(Width) * Height * BytesPerPixel;
+		std::vector<uint8_t> Pixels(Decoded, Decoded + ImageSize);
+		stbi_image_free(Decoded);
+
+		uint32_t Flags = Options.bFlipVertical ? CookedTexture_FlipVertical : CookedTexture_None;
+		for (std::size_t Idx = 3; Idx < Pixels.size(); Idx += BytesPerPixel)
+		{
+			if (Pixels[Idx] < 255)
+			{
+				Flags |= CookedTexture_Translucent;
+				break;
+			}
+		}
+
+		ECookedTextureFormat Format = Options.Format;
+		if ((Format == ECookedTextureFormat::BC1) && (Flags & CookedTexture_Translucent))
+		{
+			LK_WARN_TAG("TextureCooker", "{} is translucent, using BC3 instead of BC1", Source.filename());
+			Format = ECookedTextureFormat::BC3;
+		}
+
+		std::vector<FMipLevel> Levels = GenerateMips(std::move(Pixels), Width, Height, Options.bMips);
+		if (Format != ECookedTextureFormat::RGBA8)
+		{
+			for (FMipLevel& Level : Levels)
+			{
+				Level.Data = (Format == ECookedTextureFormat::BC1) ? EncodeBC1(Level.Data, Level.Width, Level.Height)
+																   : EncodeBC3(Level.Data, Level.Width, Level.Height);
+			}
+		}
+
+		FCookedTextureHeader Header = {
+			.Magic = CookedTexture::MAGIC,
+			.Version = CookedTexture::VERSION,
+			.Format = Format,
+			.Width = static_cast<uint32_t>(Width),
+			.Height = static_cast<uint32_t>(Height),
+			.MipCount = static_cast<uint32_t>(Levels.size()),
+			.Flags = Flags,
+			.SourceHash = SourceHash,
+		};
+
+		auto Align = [](const uint64_t Offset) { return (Offset + CookedTexture::ALIGNMENT - 1) & ~(CookedTexture::ALIGNMENT - 1); };
+		std::vector<FCookedTextureMip> Mips(Levels.size());
+		uint64_t Offset = Align(sizeof(FCookedTextureHeader) + (Mips.size() * sizeof(FCookedTextureMip)));
+		for (std::size_t Level = 0; Level < Levels.size(); Level++)
+		{
+			Mips[Level] = { .Offset = Offset, .Size = Levels[Level].Data.size(), .Width = Levels[Level].Width, .Height = Levels[Level].Height };
+			LK_VERIFY(Mips[Level].Size == CookedTexture::GetMipSize(Format, Mips[Level].Width, Mips[Level].Height));
+			Offset = Align(Offset + Mips[Level].Size);
+		}
+
+		/* Written next to the output and renamed, so a failed cook never leaves a partial file behind. */
+		std::error_code Error;
+		std::filesystem::create_directories(OutputDir, Error);
+		std::filesystem::path Temporary = Output;
+		Temporary += ".tmp";
+		{
+			std::ofstream File(Temporary, std::ios::binary | std::ios::trunc);
+			if (!File)
+			{
+				LK_ERROR_TAG("TextureCooker", "Failed to write {}", Temporary);
+				return ECookResult::Failed;
+			}
+
+			static constexpr char Padding[CookedTexture::ALIGNMENT] = {};
+			File.write(reinterpret_cast<const char*>(&Header), sizeof(Header));
+			File.write(reinterpret_cast<const char*>(Mips.data()), Mips.size() * sizeof(FCookedTextureMip));
+			for (std::size_t Level = 0; Level < Levels.size(); Level++)
+			{
+				File.write(Padding, Mips[Level].Offset - static_cast<uint64_t>(File.tellp()));
+				File.write(reinterpret_cast<const char*>(Levels[Level].Data.data()), Levels[Level].Data.size());
+			}
+			if (!File)
+			{
+				LK_ERROR_TAG("TextureCooker", "Failed to write {}", Temporary);
+				return ECookResult::Failed;
+			}
+		}
+
+		std::filesystem::rename(Temporary, Output, Error);
+		if (Error)
+		{
+			LK_ERROR_TAG("TextureCooker", "Failed to replace {}: {}", Output, Error.message());
+			return ECookResult::Failed;
+		}
+
+		LK_INFO_TAG("TextureCooker", "Cooked {} ({}x{} {}, {} mips, {} bytes)", Source.filename(), Width, Height,
+					Enum::ToString(Format), Levels.size(), Offset);
+		return ECookResult::Cooked;
+	}
+
+	std::vector<uint8_t> CTextureCooker::EncodeBC1(const std::span<const uint8_t> Pixels, const uint32_t Width, const uint32_t Height)
+	{
+		const uint32_t BlocksX = (Width + 3) / 4;
+		const uint32_t BlocksY = (Height + 3) / 4;
+		std::vector<uint8_t> Blocks(static_cast<std::size_t>(BlocksX) * BlocksY * 8);
+
+		uint8_t Block[16 * BytesPerPixel];
+		for (uint32_t BlockY = 0; BlockY < BlocksY; BlockY++)
+		{
+			for (uint32_t BlockX = 0; BlockX < BlocksX; BlockX++)
+			{
+				FetchBlock(Pixels, Width, Height, BlockX, BlockY, Block);
+				EncodeColorBlock(Block, &Blocks[(static_cast<std::size_t>(BlockY) * BlocksX + BlockX) * 8]);
+			}
+		}
+
+		return Blocks;
+	}
+
+	std::vector<uint8_t> CTextureCooker::EncodeBC3(const std::span<const uint8_t> Pixels, const uint32_t Width, const uint32_t Height)
+	{
+		const uint32_t BlocksX = (Width + 3) / 4;
+		const uint32_t BlocksY = (Height + 3) / 4;
+		std::vector<uint8_t> Blocks(static_cast<std::size_t>(BlocksX) * BlocksY * 16);
+
+		uint8_t Block[16 * BytesPerPixel];
+		for (uint32_t BlockY = 0; BlockY < BlocksY; BlockY++)
+		{
+			for (uint32_t BlockX = 0; BlockX < BlocksX; BlockX++)
+			{
+				FetchBlock(Pixels, Width, Height, BlockX, BlockY, Block);
+				uint8_t* Out = &Blocks[(static_cast<std::size_t>(BlockY) * BlocksX + BlockX) * 16];
+				EncodeAlphaBlock(Block, Out);
+				EncodeColorBlock(Block, Out + 8);
+			}
+		}
+
+		return Blocks;
+	}
+
+}
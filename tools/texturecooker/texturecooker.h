@@ -0,0 +1,46 @@
+#pragma once
+
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#include "core/core.h"
+#include "renderer/cookedtexture.h"
+
+namespace platformer2d {
+
+	struct FCookOptions
+	{
+		ECookedTextureFormat Format = ECookedTextureFormat::RGBA8;
+		bool bMips = true;         /* Full chain down to 1x1. */
+		bool bFlipVertical = true; /* Must match FTextureSpecification::bFlipVertical of the runtime texture. */
+		bool bForce = false;       /* Cook even if the source hash is unchanged. */
+	};
+
+	enum class ECookResult
+	{
+		Cooked,
+		UpToDate,
+		Failed,
+	};
+
+	/**
+	 * @brief Converts source images to cooked textures, see CCookedTexture.
+	 */
+	class CTextureCooker
+	{
+	public:
+		/**
+		 * @brief Cook a source image into the output directory.
+		 * The file is skipped if a cooked version with the same source hash and options exists.
+		 */
+		static ECookResult Cook(const std::filesystem::path& Source, const std::filesystem::path& OutputDir, const FCookOptions& Options);
+
+		/**
+		 * @brief Encode RGBA8 pixels to 4x4 blocks, edge texels are repeated to fill partial blocks.
+		 */
+		static std::vector<uint8_t> EncodeBC1(std::span<const uint8_t> Pixels, uint32_t Width, uint32_t Height);
+		static std::vector<uint8_t> EncodeBC3(std::span<const uint8_t> Pixels, uint32_t Width, uint32_t Height);
+	};
+
+}